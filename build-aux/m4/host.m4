@@ -12,6 +12,8 @@ AC_DEFUN([BOLTHUR_KERNEL_SET_HOST], [
   AH_TEMPLATE([PRINT_MM_PHYS], [Define to 1 to enable output of physical memory manager])
   AH_TEMPLATE([PRINT_MM_VIRT], [Define to 1 to enable output of virtual memory manager])
   AH_TEMPLATE([PRINT_MM_HEAP], [Define to 1 to enable output of kernel heap])
+  AH_TEMPLATE([PRINT_MM_SLAB], [Define to 1 to enable output of slab allocator])
+  AH_TEMPLATE([PRINT_MM_SHARED], [Define to 1 to enable output of shared memory])
   AH_TEMPLATE([PRINT_MAILBOX], [Define to 1 to enable output of mailbox])
   AH_TEMPLATE([PRINT_TIMER], [Define to 1 to enable output of timer])
   AH_TEMPLATE([PRINT_INITRD], [Define to 1 to enable output of initrd])
@@ -49,6 +51,16 @@ AC_DEFUN([BOLTHUR_KERNEL_SET_HOST], [
     AC_DEFINE([PRINT_MM_HEAP], [1])
   ])
 
+  # Test for slab allocator output
+  AS_IF([test "x$enable_output_mm_slab" == "xyes"], [
+    AC_DEFINE([PRINT_MM_SLAB], [1])
+  ])
+
+  # Test for shared memory output
+  AS_IF([test "x$enable_output_mm_shared" == "xyes"], [
+    AC_DEFINE([PRINT_MM_SHARED], [1])
+  ])
+
   # Test for mailbox output
   AS_IF([test "x$enable_output_mailbox" == "xyes"], [
     AC_DEFINE([PRINT_MAILBOX], [1])
@@ -0,0 +1,36 @@
+
+/**
+ * Copyright (C) 2018 - 2020 bolthur project.
+ *
+ * This file is part of bolthur/kernel.
+ *
+ * bolthur/kernel is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * bolthur/kernel is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if ! defined( __ARCH_ARM_CACHE__ )
+#define __ARCH_ARM_CACHE__
+
+#include <stdint.h>
+#include <stddef.h>
+
+void cache_enable( void );
+void cache_invalidate_instruction_cache( void );
+void cache_invalidate_branch_predictor( void );
+void cache_clean_invalidate_data_cache( void );
+void cache_clean_range( uintptr_t, size_t );
+void cache_invalidate_range( uintptr_t, size_t );
+void cache_clean_invalidate_range( uintptr_t, size_t );
+void cache_clean_table( uintptr_t, size_t );
+
+#endif
@@ -18,9 +18,19 @@
  * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#if ! defined( __ARCH_ARM_V7_CACHE__ )
-#define __ARCH_ARM_V7_CACHE__
+#if ! defined( __ARCH_ARM_MM_VIRT_ASID__ )
+#define __ARCH_ARM_MM_VIRT_ASID__
 
-void cache_invalidate_instruction_cache( void );
+#include <stdint.h>
+#include <stdbool.h>
+#include <core/mm/virt.h>
+
+#define VIRT_ASID_BITS 8
+#define VIRT_ASID_COUNT ( 1 << VIRT_ASID_BITS )
+#define VIRT_ASID_KERNEL 0
+
+bool virt_asid_assign( virt_context_ptr_t );
+bool virt_asid_valid( virt_context_ptr_t );
+uint32_t virt_asid_get( virt_context_ptr_t );
 
 #endif
@@ -45,6 +45,21 @@
   #define LD_PHYSICAL_SECTION_L2_ADDRESS( a ) ( ( uint64_t )a & 0x7FFFE00000 )
   #define LD_PHYSICAL_TABLE_ADDRESS( a ) ( ( uint64_t )a & 0xFFFFFFF000 )
   #define LD_PHYSICAL_PAGE_ADDRESS( a ) ( ( uint64_t )a & 0xFFFFFFF000 )
+  #define LD_IS_BLOCK( e ) ( LD_TYPE_SECTION == ( ( e ) & 0x3 ) )
+  #define LD_IS_READ_ONLY( e ) ( 0 != ( ( e ) & 0x80 ) )
+
+  // block and page descriptors share lower and upper attribute bits
+  #define LD_ATTRIBUTE_MASK 0xFFF0000000000FFCULL
+
+  // sizes covered by level 2 blocks and amount of entries per table
+  #define LD_SECTION_L2_SIZE 0x200000
+  #define LD_TABLE_ENTRIES 512
+
+  // memory attribute indices within mair0
+  #define LD_MAIR_INDEX_STRONGLY_ORDERED 0
+  #define LD_MAIR_INDEX_DEVICE 1
+  #define LD_MAIR_INDEX_NORMAL_NC 2
+  #define LD_MAIR_INDEX_NORMAL 3
 
   typedef union __packed {
     uint32_t raw;
@@ -153,7 +168,7 @@
       uint64_t lower_attr_access_permission : 2;
       uint64_t lower_attr_shared : 2;
       uint64_t lower_attr_access : 1;
-      uint64_t lower_attr_sbz0 : 1;
+      uint64_t lower_attr_not_global : 1;
 
       uint64_t output_address : 28;
       uint64_t sbz_0 : 12;
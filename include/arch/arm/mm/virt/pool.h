@@ -0,0 +1,59 @@
+
+/**
+ * Copyright (C) 2018 - 2020 bolthur project.
+ *
+ * This file is part of bolthur/kernel.
+ *
+ * bolthur/kernel is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * bolthur/kernel is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if ! defined( __ARCH_ARM_MM_VIRT_POOL__ )
+#define __ARCH_ARM_MM_VIRT_POOL__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <avl.h>
+#include <core/mm/phys.h>
+#include <core/mm/virt.h>
+
+#if defined( ELF32 )
+  #define VIRT_POOL_WINDOW_START 0xF0000000
+  #define VIRT_POOL_WINDOW_SIZE 0xFFFFFF
+  #define VIRT_POOL_CHUNK_SIZE 0x10000
+  #define VIRT_POOL_MAX_CHUNK 512
+  // chunks taken from 1 MiB early heap before virtual memory is up, half of it
+  #define VIRT_POOL_MAX_EARLY_CHUNK 8
+#elif defined( ELF64 )
+  #error "Page table pool not ready for x64"
+#endif
+
+#define VIRT_POOL_PAGE_PER_CHUNK ( VIRT_POOL_CHUNK_SIZE / PAGE_SIZE )
+
+typedef struct {
+  avl_node_t node;
+  uint64_t physical;
+  uintptr_t virtual;
+  uint32_t used;
+} virt_pool_chunk_t, *virt_pool_chunk_ptr_t;
+
+#define VIRT_POOL_GET_CHUNK( n ) \
+  ( virt_pool_chunk_ptr_t )( ( uint8_t* )n - offsetof( virt_pool_chunk_t, node ) )
+
+uint64_t virt_pool_allocate( size_t, size_t );
+void virt_pool_free( uint64_t, size_t );
+uintptr_t virt_pool_virtual( uint64_t );
+void virt_pool_prepare( virt_context_ptr_t );
+
+#endif
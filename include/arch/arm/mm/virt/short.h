@@ -79,6 +79,9 @@
   #define SD_TTBR1_START_TTBR0_64M 0x04000000
   #define SD_TTBR1_START_TTBR0_32M 0x02000000
 
+  // table walk inner ( irgn ) and outer ( rgn ) write back write allocate
+  #define SD_TTBR_WALK_WRITE_BACK 0x48
+
   // first level types
   #define SD_TTBR_TYPE_INVALID 0
   #define SD_TTBR_TYPE_PAGE_TABLE 1
@@ -88,6 +91,13 @@
   // page table sizes
   #define SD_TBL_SIZE 0x400
   #define SD_PAGE_SIZE 0x1000
+  #define SD_LARGE_PAGE_SIZE 0x10000
+  #define SD_SECTION_SIZE 0x100000
+  #define SD_SUPER_SECTION_SIZE 0x1000000
+
+  // amount of repeated entries for large pages and supersections
+  #define SD_LARGE_PAGE_ENTRIES 16
+  #define SD_SUPER_SECTION_ENTRIES 16
 
   // second level table
   #define SD_TBL_INVALID 0
@@ -97,6 +107,12 @@
   // helper macros
   #define SD_VIRTUAL_TABLE_INDEX( a ) ( a >> 20  )
   #define SD_VIRTUAL_PAGE_INDEX( a ) ( ( a >> 12 ) & 0xFF )
+  #define SD_TTBR_IS_SECTION( e ) ( 0 != ( ( e ) & 0x2 ) )
+  #define SD_TTBR_IS_SUPER_SECTION( e ) \
+    ( SD_TTBR_IS_SECTION( e ) && 0 != ( ( e ) & 0x40000 ) )
+  #define SD_TBL_IS_LARGE_PAGE( e ) ( 0x1 == ( ( e ) & 0x3 ) )
+  #define SD_TTBR_IS_READ_ONLY( e ) ( 0 != ( ( e ) & 0x8000 ) )
+  #define SD_TBL_IS_READ_ONLY( e ) ( 0 != ( ( e ) & 0x200 ) )
 
   typedef union __packed {
     uint32_t raw;
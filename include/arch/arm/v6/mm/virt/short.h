@@ -29,10 +29,15 @@ void v6_short_startup_enable( void );
 
 void v6_short_map(
   virt_context_ptr_t, uintptr_t, uint64_t, virt_memory_type_t, uint32_t );
-void v6_short_map_random(
+bool v6_short_map_random(
   virt_context_ptr_t, uintptr_t, virt_memory_type_t, uint32_t );
+void v6_short_map_range(
+  virt_context_ptr_t, uintptr_t, uint64_t, size_t, virt_memory_type_t, uint32_t );
+void v6_short_map_range_random(
+  virt_context_ptr_t, uintptr_t, size_t, virt_memory_type_t, uint32_t );
 uintptr_t v6_short_map_temporary( uint64_t, size_t );
 void v6_short_unmap( virt_context_ptr_t, uintptr_t, bool );
+void v6_short_unmap_range( virt_context_ptr_t, uintptr_t, size_t, bool );
 void v6_short_unmap_temporary( uintptr_t, size_t );
 uint64_t v6_short_create_table( virt_context_ptr_t, uintptr_t, uint64_t );
 void v6_short_set_context( virt_context_ptr_t );
@@ -41,6 +46,9 @@ virt_context_ptr_t v6_short_create_context( virt_context_type_t );
 void v6_short_prepare( void );
 void v6_short_flush_complete( void );
 void v6_short_flush_address( uintptr_t );
+void v6_short_flush_range( uintptr_t, size_t );
 bool v6_short_is_mapped_in_context( virt_context_ptr_t, uintptr_t );
+bool v6_short_is_writable_in_context( virt_context_ptr_t, uintptr_t );
+uint64_t v6_short_get_mapped_address_in_context( virt_context_ptr_t, uintptr_t );
 
 #endif
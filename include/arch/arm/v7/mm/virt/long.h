@@ -30,10 +30,15 @@ void v7_long_startup_flush( void );
 
 void v7_long_map(
   virt_context_ptr_t, uintptr_t, uint64_t, virt_memory_type_t, uint32_t );
-void v7_long_map_random(
+bool v7_long_map_random(
   virt_context_ptr_t, uintptr_t, virt_memory_type_t, uint32_t );
+void v7_long_map_range(
+  virt_context_ptr_t, uintptr_t, uint64_t, size_t, virt_memory_type_t, uint32_t );
+void v7_long_map_range_random(
+  virt_context_ptr_t, uintptr_t, size_t, virt_memory_type_t, uint32_t );
 uintptr_t v7_long_map_temporary( uint64_t, size_t );
 void v7_long_unmap( virt_context_ptr_t, uintptr_t, bool );
+void v7_long_unmap_range( virt_context_ptr_t, uintptr_t, size_t, bool );
 void v7_long_unmap_temporary( uintptr_t, size_t );
 uint64_t v7_long_create_table( virt_context_ptr_t, uintptr_t, uint64_t );
 void v7_long_set_context( virt_context_ptr_t );
@@ -43,6 +48,9 @@ void v7_long_destroy_context( virt_context_ptr_t );
 void v7_long_prepare( void );
 void v7_long_flush_complete( void );
 void v7_long_flush_address( uintptr_t );
+void v7_long_flush_range( uintptr_t, size_t, uint32_t );
 bool v7_long_is_mapped_in_context( virt_context_ptr_t, uintptr_t );
+bool v7_long_is_writable_in_context( virt_context_ptr_t, uintptr_t );
+uint64_t v7_long_get_mapped_address_in_context( virt_context_ptr_t, uintptr_t );
 
 #endif
@@ -0,0 +1,46 @@
+
+/**
+ * Copyright (C) 2018 - 2020 bolthur project.
+ *
+ * This file is part of bolthur/kernel.
+ *
+ * bolthur/kernel is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * bolthur/kernel is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if ! defined( __ARCH_ARM_V7_SYSCALL__ )
+#define __ARCH_ARM_V7_SYSCALL__
+
+#include <arch/arm/v7/cpu.h>
+
+// maximum amount of arguments passed within r0 - r5
+#define SYSCALL_ARGUMENT_MAX 6
+
+// syscall number is passed within r7
+#define SYSCALL_NUMBER( c ) \
+  ( ( cpu_register_context_ptr_t )c )->reg.r7
+// arguments are passed within r0 - r5
+#define SYSCALL_ARGUMENT( c, n ) \
+  ( ( cpu_register_context_ptr_t )c )->raw[ R0 + ( n ) ]
+// return value is passed back within r0
+#define SYSCALL_RETURN( c, v ) \
+  ( ( cpu_register_context_ptr_t )c )->reg.r0 = ( uint32_t )( v )
+// 64 bit return value is passed back within r0 ( low ) and r1 ( high )
+#define SYSCALL_RETURN_64( c, v ) \
+  ( ( cpu_register_context_ptr_t )c )->reg.r0 = ( uint32_t )( v ); \
+  ( ( cpu_register_context_ptr_t )c )->reg.r1 = ( uint32_t )( ( uint64_t )( v ) >> 32 )
+// restart syscall after wakeup by stepping back to svc instruction
+#define SYSCALL_RESTART( c ) \
+  ( ( cpu_register_context_ptr_t )c )->reg.pc -= 4
+
+#endif
@@ -39,6 +39,8 @@
 
   extern uintptr_t __kernel_start;
   extern uintptr_t __kernel_end;
+  extern uintptr_t __bootstrap_start;
+  extern uintptr_t __bootstrap_end;
 #endif
 
 #endif
@@ -22,19 +22,25 @@
 #define __CORE_EVENT__
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <list.h>
-#include <avl.h>
 #include <core/stack.h>
 
 #define EVENT_DETERMINE_ORIGIN( o ) \
   ( o == NULL || ! stack_is_kernel( ( uintptr_t )o ) ) \
     ? EVENT_ORIGIN_USER : EVENT_ORIGIN_KERNEL
 
+/**
+ * @brief Ring buffer capacity per origin, has to be a power of two
+ */
+#define EVENT_QUEUE_SIZE 32
+
 typedef enum {
   EVENT_TIMER = 1,
   EVENT_SERIAL,
   EVENT_DEBUG,
-  EVENT_INTERRUPT_CLEANUP
+  EVENT_INTERRUPT_CLEANUP,
+  EVENT_TYPE_COUNT
 } event_type_t;
 
 typedef enum {
@@ -43,27 +49,33 @@ typedef enum {
 } event_origin_t;
 
 typedef struct {
-  avl_tree_ptr_t tree;
-  list_manager_ptr_t queue_kernel;
-  list_manager_ptr_t queue_user;
-} event_manager_t, *event_manager_ptr_t;
+  event_type_t type;
+} event_entry_t, *event_entry_ptr_t;
+
+typedef struct {
+  event_entry_t entry[ EVENT_QUEUE_SIZE ];
+  volatile uint32_t head;
+  volatile uint32_t tail;
+  volatile uint32_t pending;
+} event_queue_t, *event_queue_ptr_t;
 
 typedef struct {
-  avl_node_t node;
-  event_type_t type;
   list_manager_ptr_t handler;
   list_manager_ptr_t post;
 } event_block_t, *event_block_ptr_t;
 
+typedef struct {
+  event_block_t block[ EVENT_TYPE_COUNT ];
+  event_queue_t queue_kernel;
+  event_queue_t queue_user;
+} event_manager_t, *event_manager_ptr_t;
+
 typedef void ( *event_callback_t )( event_origin_t, void* data );
 
 typedef struct {
   event_callback_t callback;
 } event_callback_wrapper_t, *event_callback_wrapper_ptr_t;
 
-#define EVENT_GET_BLOCK( n ) \
-  ( event_block_ptr_t )( ( uint8_t* )n - offsetof( event_block_t, node ) )
-
 bool event_init_get( void );
 void event_init( void );
 bool event_bind( event_type_t, event_callback_t, bool );
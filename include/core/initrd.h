@@ -24,6 +24,7 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <tar.h>
 
 uintptr_t initrd_get_start_address( void );
 void initrd_set_start_address( uintptr_t );
@@ -32,5 +33,9 @@ size_t initrd_get_size( void );
 void initrd_set_size( size_t );
 bool initrd_exist( void );
 void initrd_startup_init( void );
+void initrd_decompress( void );
+void initrd_index_init( void );
+tar_index_ptr_t initrd_index_get( void );
+void initrd_reclaim( void );
 
 #endif
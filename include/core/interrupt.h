@@ -22,14 +22,16 @@
 #define __CORE_INTERRUPT__
 
 #include <assert.h>
-#include <avl.h>
-#include <list.h>
 #include <stdint.h>
 #include <stddef.h>
 #include <stdbool.h>
 #include <core/task/thread.h>
 
 #define INTERRUPT_NESTED_MAX 3
+// upper limit of interrupts handled per exception entry
+#define INTERRUPT_DRAIN_MAX 16
+// hardware interrupt numbers including local ones
+#define INTERRUPT_HARDWARE_COUNT 72
 #define INTERRUPT_DETERMINE_CONTEXT( c ) \
   c = NULL != c ? c : TASK_THREAD_GET_CONTEXT; \
   assert( c != NULL );
@@ -38,8 +40,7 @@ typedef void ( *interrupt_callback_t )( void* );
 
 typedef enum {
   INTERRUPT_NORMAL = 1,
-  INTERRUPT_FAST,
-  INTERRUPT_SOFTWARE
+  INTERRUPT_FAST
 } interrupt_type_t;
 
 typedef enum {
@@ -48,25 +49,20 @@ typedef enum {
   INTERRUPT_TOGGLE_OFF
 } interrupt_toggle_state_t;
 
-typedef struct {
-  avl_tree_ptr_t normal_interrupt;
-  avl_tree_ptr_t fast_interrupt;
-  avl_tree_ptr_t software_interrupt;
-} interrupt_manager_t, *interrupt_manager_ptr_t;
+typedef struct interrupt_slot {
+  interrupt_callback_t callback;
+  struct interrupt_slot* next;
+} interrupt_slot_t, *interrupt_slot_ptr_t;
 
 typedef struct {
-  avl_node_t node;
-  size_t interrupt;
-  list_manager_ptr_t handler;
-  list_manager_ptr_t post;
+  interrupt_slot_t handler;
+  interrupt_slot_t post;
 } interrupt_block_t, *interrupt_block_ptr_t;
 
 typedef struct {
-  interrupt_callback_t callback;
-} interrupt_callback_wrapper_t, *interrupt_callback_wrapper_ptr_t;
-
-#define INTERRUPT_GET_BLOCK( n ) \
-  ( interrupt_block_ptr_t )( ( uint8_t* )n - offsetof( interrupt_block_t, node ) )
+  interrupt_block_t normal_interrupt[ INTERRUPT_HARDWARE_COUNT ];
+  interrupt_block_t fast_interrupt[ INTERRUPT_HARDWARE_COUNT ];
+} interrupt_manager_t, *interrupt_manager_ptr_t;
 
 int8_t interrupt_get_pending( bool );
 void interrupt_toggle( interrupt_toggle_state_t );
@@ -77,6 +73,7 @@ void interrupt_init( void );
 void interrupt_arch_init( void );
 void interrupt_post_init( void );
 void interrupt_handle( size_t, interrupt_type_t, void* );
+size_t interrupt_handle_pending( void* );
 void interrupt_register_handler( size_t, interrupt_callback_t, interrupt_type_t, bool );
 void interrupt_unregister_handler( size_t, interrupt_callback_t, interrupt_type_t, bool );
 
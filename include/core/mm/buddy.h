@@ -0,0 +1,56 @@
+
+/**
+ * Copyright (C) 2018 - 2020 bolthur project.
+ *
+ * This file is part of bolthur/kernel.
+ *
+ * bolthur/kernel is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * bolthur/kernel is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if ! defined( __CORE_MM_BUDDY__ )
+#define __CORE_MM_BUDDY__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#define PHYS_BUDDY_MAX_ORDER 10
+#define PHYS_BUDDY_ORDER_SIZE ( PHYS_BUDDY_MAX_ORDER + 1 )
+#define PHYS_BUDDY_INVALID_FRAME ( ( size_t )-1 )
+#define PHYS_BUDDY_BITS_PER_ENTRY ( sizeof( uint32_t ) * 8 )
+
+typedef struct {
+  uint32_t *map;
+  uint32_t *summary;
+  size_t block_count;
+  size_t map_length;
+  size_t summary_length;
+  size_t free_count;
+} phys_buddy_order_t, *phys_buddy_order_ptr_t;
+
+typedef struct {
+  size_t frame_count;
+  phys_buddy_order_t order[ PHYS_BUDDY_ORDER_SIZE ];
+} phys_buddy_manager_t, *phys_buddy_manager_ptr_t;
+
+void phys_buddy_init( size_t );
+bool phys_buddy_init_get( void );
+size_t phys_buddy_order( size_t );
+size_t phys_buddy_allocate( size_t );
+void phys_buddy_free( size_t, size_t );
+void phys_buddy_free_range( size_t, size_t );
+bool phys_buddy_claim( size_t );
+size_t phys_buddy_free_frames( void );
+
+#endif
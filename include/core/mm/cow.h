@@ -0,0 +1,44 @@
+
+/**
+ * Copyright (C) 2018 - 2020 bolthur project.
+ *
+ * This file is part of bolthur/kernel.
+ *
+ * bolthur/kernel is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * bolthur/kernel is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if ! defined( __CORE_MM_COW__ )
+#define __CORE_MM_COW__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <avl.h>
+#include <core/mm/virt.h>
+
+typedef struct {
+  avl_node_t node;
+  uint64_t page;
+  size_t reference;
+} cow_page_t, *cow_page_ptr_t;
+
+#define COW_GET_BLOCK( n ) \
+  ( cow_page_ptr_t )( ( uint8_t* )n - offsetof( cow_page_t, node ) )
+
+void cow_init( void );
+void cow_clone_range(
+  virt_context_ptr_t, virt_context_ptr_t, uintptr_t, size_t, uint32_t );
+bool cow_fault( virt_context_ptr_t, uintptr_t, uint32_t );
+
+#endif
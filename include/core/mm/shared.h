@@ -0,0 +1,65 @@
+
+/**
+ * Copyright (C) 2018 - 2020 bolthur project.
+ *
+ * This file is part of bolthur/kernel.
+ *
+ * bolthur/kernel is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * bolthur/kernel is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if ! defined( __CORE_MM_SHARED__ )
+#define __CORE_MM_SHARED__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <avl.h>
+#include <list.h>
+#include <core/mm/virt.h>
+
+typedef struct process task_process_t, *task_process_ptr_t;
+
+// well known id of display region registered by platform
+#define SHARED_ID_DISPLAY 1
+// ids up to this one are reserved for platform objects
+#define SHARED_ID_RESERVED 16
+
+typedef struct {
+  virt_context_ptr_t context;
+  uintptr_t address;
+} shared_mapping_t, *shared_mapping_ptr_t;
+
+typedef struct {
+  avl_node_t node_id;
+  size_t id;
+  uint64_t start;
+  size_t size;
+  size_t reference;
+  bool fixed;
+  virt_memory_type_t type;
+  list_manager_ptr_t mapping;
+} shared_entry_t, *shared_entry_ptr_t;
+
+#define SHARED_GET_BLOCK_ID( n ) \
+  ( shared_entry_ptr_t )( ( uint8_t* )n - offsetof( shared_entry_t, node_id ) )
+
+void shared_init( void );
+void shared_platform_init( void );
+bool shared_create_fixed( size_t, uint64_t, size_t, virt_memory_type_t );
+size_t shared_create( task_process_ptr_t, uintptr_t, size_t );
+bool shared_map( task_process_ptr_t, size_t, uintptr_t );
+bool shared_unmap( virt_context_ptr_t, size_t, uintptr_t );
+bool shared_is_mapped( virt_context_ptr_t, uintptr_t );
+
+#endif
@@ -0,0 +1,96 @@
+
+/**
+ * Copyright (C) 2018 - 2020 bolthur project.
+ *
+ * This file is part of bolthur/kernel.
+ *
+ * bolthur/kernel is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * bolthur/kernel is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if ! defined( __CORE_MM_SLAB__ )
+#define __CORE_MM_SLAB__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <core/mm/phys.h>
+
+#if defined( ELF32 )
+  #define SLAB_START 0xE0000000
+  #define SLAB_MAX_SIZE 0xFFFFFF
+#elif defined( ELF64 )
+  #error "Slab not ready for x64"
+#endif
+
+#define SLAB_MAGIC 0x51AB51AB
+
+typedef enum {
+  SLAB_CLASS_16 = 0,
+  SLAB_CLASS_32,
+  SLAB_CLASS_64,
+  SLAB_CLASS_128,
+  SLAB_CLASS_256,
+  SLAB_CLASS_SIZE,
+} slab_class_t;
+
+#define SLAB_MIN_OBJECT_SIZE 16
+#define SLAB_MAX_OBJECT_SIZE 256
+
+typedef struct slab_object {
+  struct slab_object *next;
+} slab_object_t, *slab_object_ptr_t;
+
+typedef struct slab_page {
+  uint32_t magic;
+  slab_class_t class;
+  size_t used;
+  slab_object_ptr_t free;
+  struct slab_page *previous;
+  struct slab_page *next;
+} slab_page_t, *slab_page_ptr_t;
+
+typedef struct {
+  size_t hit;
+  size_t miss;
+  size_t allocated;
+  size_t freed;
+  size_t pages;
+} slab_statistic_t, *slab_statistic_ptr_t;
+
+typedef struct {
+  size_t object_size;
+  slab_page_ptr_t partial;
+  slab_statistic_t statistic;
+} slab_cache_t, *slab_cache_ptr_t;
+
+typedef struct {
+  uintptr_t end;
+  slab_page_ptr_t free_page;
+  slab_cache_t cache[ SLAB_CLASS_SIZE ];
+} slab_manager_t, *slab_manager_ptr_t;
+
+#define SLAB_GET_PAGE( a ) \
+  ( slab_page_ptr_t )( ( uintptr_t )a & ~( ( uintptr_t )PAGE_SIZE - 1 ) )
+
+bool slab_init_get( void );
+void slab_init( void );
+bool slab_responsible( uintptr_t );
+bool slab_suitable( size_t, size_t );
+uintptr_t slab_allocate( size_t, size_t );
+void slab_free( uintptr_t );
+size_t slab_object_size( uintptr_t );
+slab_statistic_ptr_t slab_statistic_get( slab_class_t );
+void slab_statistic_print( void );
+
+#endif
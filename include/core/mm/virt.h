@@ -25,6 +25,18 @@
 #include <stdbool.h>
 #include <stddef.h>
 
+/**
+ * @brief Page count above which a range flush invalidates the whole tlb
+ */
+#define VIRT_FLUSH_RANGE_THRESHOLD 64
+
+#if defined( ELF32 )
+  // end of user space covered by ttbr0, ttbcr n = 1 and t0sz = 1 for lpae
+  #define VIRT_USER_SPACE_END 0x80000000
+#elif defined( ELF64 )
+  #error "User space end not ready for x64"
+#endif
+
 typedef enum {
   VIRT_MEMORY_TYPE_DEVICE,
   VIRT_MEMORY_TYPE_DEVICE_STRONG,
@@ -36,6 +48,7 @@ typedef enum {
   VIRT_PAGE_TYPE_AUTO,
   VIRT_PAGE_TYPE_EXECUTABLE,
   VIRT_PAGE_TYPE_NON_EXECUTABLE,
+  VIRT_PAGE_TYPE_READ_ONLY = 4,
 } virt_page_type_t;
 
 typedef enum {
@@ -46,6 +59,8 @@ typedef enum {
 typedef struct {
   uint64_t context;
   virt_context_type_t type;
+  uint32_t asid;
+  uint32_t asid_generation;
 } virt_context_t, *virt_context_ptr_t;
 
 extern bool virt_use_physical_table;
@@ -62,6 +77,7 @@ void virt_platform_init( void );
 void virt_arch_init( void );
 void virt_arch_prepare( void );
 bool virt_init_get( void );
+void virt_bootstrap_reclaim( void );
 void virt_platform_post_init( void );
 
 virt_context_ptr_t virt_create_context( virt_context_type_t );
@@ -69,17 +85,25 @@ void virt_destroy_context( virt_context_ptr_t );
 uint64_t virt_create_table( virt_context_ptr_t, uintptr_t, uint64_t );
 void virt_map_address(
   virt_context_ptr_t, uintptr_t, uint64_t, virt_memory_type_t, uint32_t );
-void virt_map_address_random(
+bool virt_map_address_random(
   virt_context_ptr_t, uintptr_t, virt_memory_type_t, uint32_t );
+void virt_map_range(
+  virt_context_ptr_t, uintptr_t, uint64_t, size_t, virt_memory_type_t, uint32_t );
+void virt_map_range_random(
+  virt_context_ptr_t, uintptr_t, size_t, virt_memory_type_t, uint32_t );
 uintptr_t virt_map_temporary( uint64_t, size_t );
 void virt_unmap_address( virt_context_ptr_t, uintptr_t, bool );
+void virt_unmap_range( virt_context_ptr_t, uintptr_t, size_t, bool );
 void virt_unmap_temporary( uintptr_t, size_t );
 uint32_t virt_get_supported_modes( void );
 void virt_set_context( virt_context_ptr_t );
 void virt_flush_complete( void );
 void virt_flush_address( virt_context_ptr_t, uintptr_t );
+void virt_flush_range( virt_context_ptr_t, uintptr_t, size_t );
 void virt_prepare_temporary( virt_context_ptr_t );
 bool virt_is_mapped_in_context( virt_context_ptr_t, uintptr_t );
+bool virt_is_writable_in_context( virt_context_ptr_t, uintptr_t );
+uint64_t virt_get_mapped_address_in_context( virt_context_ptr_t, uintptr_t );
 bool virt_is_mapped( uintptr_t );
 
 #endif
@@ -21,9 +21,55 @@
 #if ! defined( __CORE_SYSCALL__ )
 #define __CORE_SYSCALL__
 
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
 #define SYSCALL_PUTC 10
+#define SYSCALL_YIELD 11
+#define SYSCALL_SLEEP 12
+#define SYSCALL_WRITE 13
+#define SYSCALL_IPC_SEND 14
+#define SYSCALL_IPC_RECEIVE 15
+#define SYSCALL_IPC_CALL 16
+#define SYSCALL_IPC_REPLY 17
+#define SYSCALL_SHM_CREATE 18
+#define SYSCALL_SHM_MAP 19
+#define SYSCALL_SHM_UNMAP 20
+#define SYSCALL_CHANNEL_CREATE 21
+#define SYSCALL_CHANNEL_SEND 22
+#define SYSCALL_CHANNEL_RECEIVE 23
+#define SYSCALL_FORK 24
+#define SYSCALL_COUNT 25
+
+// return value of invalid syscall numbers
+#define SYSCALL_ERROR_INVALID -1
+
+// file descriptors of write syscall routed to console
+#define SYSCALL_FD_STDOUT 1
+#define SYSCALL_FD_STDERR 2
+
+// flag of channel syscalls to return instead of blocking
+#define SYSCALL_CHANNEL_NONBLOCK 1
+
+typedef void ( *syscall_callback_t )( void* );
 
 void syscall_putc( void* context );
-void syscall_init( void );
+void syscall_yield( void* context );
+void syscall_sleep( void* context );
+void syscall_write( void* context );
+void syscall_ipc_send( void* context );
+void syscall_ipc_receive( void* context );
+void syscall_ipc_call( void* context );
+void syscall_ipc_reply( void* context );
+void syscall_shm_create( void* context );
+void syscall_shm_map( void* context );
+void syscall_shm_unmap( void* context );
+void syscall_channel_create( void* context );
+void syscall_channel_send( void* context );
+void syscall_channel_receive( void* context );
+void syscall_fork( void* context );
+bool syscall_handle( size_t, void* );
+bool syscall_validate_buffer( uintptr_t, size_t, bool );
 
 #endif
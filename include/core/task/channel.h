@@ -0,0 +1,68 @@
+
+/**
+ * Copyright (C) 2018 - 2020 bolthur project.
+ *
+ * This file is part of bolthur/kernel.
+ *
+ * bolthur/kernel is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * bolthur/kernel is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if ! defined( __CORE_TASK_CHANNEL__ )
+#define __CORE_TASK_CHANNEL__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <avl.h>
+#include <core/task/wait.h>
+
+/**
+ * @brief Amount of messages a channel is able to buffer
+ */
+#define TASK_CHANNEL_SIZE 64
+
+/**
+ * @brief Amount of payload words per message
+ */
+#define TASK_CHANNEL_MESSAGE_WORDS 3
+
+typedef struct process task_process_t, *task_process_ptr_t;
+
+typedef struct {
+  size_t sender;
+  uintptr_t data[ TASK_CHANNEL_MESSAGE_WORDS ];
+} task_channel_message_t, *task_channel_message_ptr_t;
+
+typedef struct task_channel {
+  avl_node_t node_id;
+  size_t id;
+  size_t owner;
+  size_t head;
+  size_t count;
+  task_wait_queue_t receiver;
+  task_wait_queue_t sender;
+  task_channel_message_t queue[ TASK_CHANNEL_SIZE ];
+} task_channel_t, *task_channel_ptr_t;
+
+#define TASK_CHANNEL_GET_BLOCK( n ) \
+  ( task_channel_ptr_t )( ( uint8_t* )n - offsetof( task_channel_t, node_id ) )
+
+avl_tree_ptr_t task_channel_init( void );
+size_t task_channel_generate_id( void );
+task_channel_ptr_t task_channel_create( task_process_ptr_t );
+task_channel_ptr_t task_channel_get_by_id( size_t );
+size_t task_channel_push(
+  task_channel_ptr_t, size_t, const task_channel_message_t*, size_t );
+size_t task_channel_pop( task_channel_ptr_t, task_channel_message_t*, size_t );
+
+#endif
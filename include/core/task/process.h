@@ -35,6 +35,9 @@ typedef struct task_thread_manager
 typedef struct task_stack_manager
   task_stack_manager_t, *task_stack_manager_ptr_t;
 
+typedef struct task_run_queue
+  task_run_queue_t, *task_run_queue_ptr_t;
+
 typedef enum {
   TASK_PROCESS_STATE_READY = 0,
   TASK_PROCESS_STATE_ACTIVE,
@@ -44,6 +47,7 @@ typedef struct process {
   avl_node_t node_id;
   avl_tree_ptr_t thread_manager;
   task_stack_manager_ptr_t thread_stack_manager;
+  list_manager_ptr_t region_manager;
   size_t id;
   size_t priority;
   virt_context_ptr_t virtual_context;
@@ -52,7 +56,10 @@ typedef struct process {
 
 typedef struct {
   avl_tree_ptr_t tree_process_id;
-  avl_tree_ptr_t thread_priority_tree;
+  avl_tree_ptr_t tree_thread_id;
+  avl_tree_ptr_t tree_channel_id;
+  task_run_queue_ptr_t thread_run_queue;
+  uint64_t slice_start;
 } task_manager_t, *task_manager_ptr_t;
 
 #define TASK_PROCESS_GET_BLOCK_ID( n ) \
@@ -64,6 +71,9 @@ void task_process_init( void );
 void task_process_schedule( event_origin_t, void* );
 void task_process_start( void );
 size_t task_process_generate_id( void );
-void task_process_create( uintptr_t, size_t );
+task_process_ptr_t task_process_create( uintptr_t, size_t );
+task_process_ptr_t task_process_fork( task_thread_ptr_t );
+void task_process_timer_update( void );
+void task_process_switch( task_thread_ptr_t );
 
 #endif
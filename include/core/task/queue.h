@@ -22,26 +22,37 @@
 #define __CORE_TASK_QUEUE__
 
 #include <stddef.h>
-#include <avl.h>
-#include <list.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <core/task/thread.h>
-#include <core/task/process.h>
 
-typedef struct task_priority_queue {
-  avl_node_t node;
-  size_t priority;
-
-  task_thread_ptr_t last_handled;
-  task_thread_ptr_t current;
+/**
+ * @brief Amount of supported priorities, one bit per priority in bitmap
+ */
+#define TASK_QUEUE_PRIORITY_COUNT 32
 
-  list_manager_ptr_t thread_list;
+typedef struct task_priority_queue {
+  task_thread_ptr_t first;
+  task_thread_ptr_t last;
 } task_priority_queue_t, *task_priority_queue_ptr_t;
 
-#define TASK_QUEUE_GET_PRIORITY( n ) \
-  ( task_priority_queue_ptr_t )( ( uint8_t* )n - offsetof( task_priority_queue_t, node ) )
-
-avl_tree_ptr_t task_queue_init( void );
-task_priority_queue_ptr_t task_queue_get_queue( task_manager_ptr_t, size_t );
+typedef struct task_run_queue_set {
+  uint32_t bitmap;
+  task_priority_queue_t queue[ TASK_QUEUE_PRIORITY_COUNT ];
+} task_run_queue_set_t, *task_run_queue_set_ptr_t;
+
+typedef struct task_run_queue {
+  task_run_queue_set_ptr_t active;
+  task_run_queue_set_ptr_t expired;
+  task_run_queue_set_t set[ 2 ];
+} task_run_queue_t, *task_run_queue_ptr_t;
+
+task_run_queue_ptr_t task_queue_init( void );
+void task_queue_push( task_run_queue_ptr_t, task_thread_ptr_t );
+void task_queue_expire( task_run_queue_ptr_t, task_thread_ptr_t );
+task_thread_ptr_t task_queue_pop( task_run_queue_ptr_t );
+void task_queue_swap( task_run_queue_ptr_t );
+bool task_queue_empty( task_run_queue_ptr_t );
 void task_process_queue_reset( void );
 
 #endif
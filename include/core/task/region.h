@@ -0,0 +1,52 @@
+
+/**
+ * Copyright (C) 2018 - 2020 bolthur project.
+ *
+ * This file is part of bolthur/kernel.
+ *
+ * bolthur/kernel is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * bolthur/kernel is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if ! defined( __CORE_TASK_REGION__ )
+#define __CORE_TASK_REGION__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <list.h>
+#include <core/mm/virt.h>
+
+typedef struct process task_process_t, *task_process_ptr_t;
+
+typedef struct {
+  uintptr_t start;
+  uintptr_t end;
+  uintptr_t source;
+  size_t source_size;
+  bool direct;
+  uint32_t page;
+} task_region_t, *task_region_ptr_t;
+
+list_manager_ptr_t task_region_init( void );
+void task_region_destroy( list_manager_ptr_t );
+void task_region_add(
+  task_process_ptr_t, uintptr_t, size_t, uintptr_t, size_t, bool, uint32_t );
+bool task_region_fault( task_process_ptr_t, uintptr_t );
+bool task_region_write_fault( task_process_ptr_t, uintptr_t );
+bool task_region_read_only( task_process_ptr_t, uintptr_t );
+bool task_region_overlap( task_process_ptr_t, uintptr_t, size_t );
+void task_region_clone( task_process_ptr_t, task_process_ptr_t );
+bool task_region_source_used( uintptr_t, uintptr_t );
+
+#endif
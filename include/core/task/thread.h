@@ -25,41 +25,58 @@
 #include <stddef.h>
 #include <stdnoreturn.h>
 #include <avl.h>
+#include <core/task/wait.h>
 
 typedef struct process task_process_t, *task_process_ptr_t;
-typedef struct task_priority_queue task_priority_queue_t, *task_priority_queue_ptr_t;
 
 typedef enum {
   TASK_THREAD_STATE_READY = 0,
   TASK_THREAD_STATE_ACTIVE,
-  TASK_THREAD_STATE_HALT_SWITCH,
+  TASK_THREAD_STATE_BLOCKED,
 } task_thread_state_t;
 
+typedef enum {
+  TASK_THREAD_IPC_NONE = 0,
+  TASK_THREAD_IPC_SEND,
+  TASK_THREAD_IPC_CALL,
+  TASK_THREAD_IPC_RECEIVE,
+  TASK_THREAD_IPC_REPLY,
+} task_thread_ipc_state_t;
+
 typedef struct task_thread {
   void* current_context;
   void* initial_context;
   avl_node_t node_id;
+  avl_node_t node_global;
   size_t id;
   size_t priority;
   uintptr_t stack_virtual;
-  uint64_t stack_physical;
   task_thread_state_t state;
   task_process_ptr_t process;
+  struct task_thread* queue_next;
+  uint64_t wakeup;
+  task_thread_ipc_state_t ipc_state;
+  size_t ipc_partner;
+  task_wait_queue_t ipc_sender;
 } task_thread_t, *task_thread_ptr_t;
 
 extern task_thread_ptr_t task_thread_current_thread;
 
 #define TASK_THREAD_GET_BLOCK( n ) \
   ( task_thread_ptr_t )( ( uint8_t* )n - offsetof( task_thread_t, node_id ) )
+#define TASK_THREAD_GET_GLOBAL_BLOCK( n ) \
+  ( task_thread_ptr_t )( ( uint8_t* )n - offsetof( task_thread_t, node_global ) )
 #define TASK_THREAD_GET_CONTEXT  \
   ( NULL != task_thread_current_thread ? task_thread_current_thread->current_context : NULL )
 
-void task_thread_set_current( task_thread_ptr_t, task_priority_queue_ptr_t );
+void task_thread_set_current( task_thread_ptr_t );
 size_t task_thread_generate_id( void );
 avl_tree_ptr_t task_thread_init( void );
 void task_thread_destroy( avl_tree_ptr_t );
 task_thread_ptr_t task_thread_create( uintptr_t, task_process_ptr_t, size_t );
+task_thread_ptr_t task_thread_fork( task_thread_ptr_t, task_process_ptr_t );
 task_thread_ptr_t task_thread_next( void );
+task_thread_ptr_t task_thread_get_by_id( size_t );
 noreturn void task_thread_switch_to( uintptr_t );
 
 #endif
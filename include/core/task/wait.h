@@ -0,0 +1,44 @@
+
+/**
+ * Copyright (C) 2018 - 2020 bolthur project.
+ *
+ * This file is part of bolthur/kernel.
+ *
+ * bolthur/kernel is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * bolthur/kernel is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if ! defined( __CORE_TASK_WAIT__ )
+#define __CORE_TASK_WAIT__
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct task_thread task_thread_t, *task_thread_ptr_t;
+
+typedef struct task_wait_queue {
+  task_thread_ptr_t first;
+  task_thread_ptr_t last;
+} task_wait_queue_t, *task_wait_queue_ptr_t;
+
+void task_wait_queue_init( task_wait_queue_ptr_t );
+void task_wait_suspend( task_thread_ptr_t );
+void task_wait_resume( task_thread_ptr_t );
+void task_wait_block( task_wait_queue_ptr_t, task_thread_ptr_t );
+task_thread_ptr_t task_wait_wake_one( task_wait_queue_ptr_t );
+size_t task_wait_wake_all( task_wait_queue_ptr_t );
+void task_wait_sleep( task_thread_ptr_t, uint64_t );
+void task_wait_wake_sleeping( uint64_t );
+uint64_t task_wait_next_wakeup( void );
+
+#endif
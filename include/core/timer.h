@@ -21,6 +21,16 @@
 #if ! defined( __CORE_TIMER__ )
 #define __CORE_TIMER__
 
+#include <stdint.h>
+
+#define TIMER_EXPIRY_NONE UINT64_MAX
+
 void timer_init( void );
+uint64_t timer_get_tick( void );
+uint32_t timer_get_interval( void );
+uint64_t timer_get_microsecond( void );
+void timer_set_expiry( uint64_t );
+uint64_t timer_get_expiry( void );
+void timer_stop( void );
 
 #endif
@@ -21,9 +21,11 @@
 #if ! defined( __CORE_TTY__ )
 #define __CORE_TTY__
 
+#include <stddef.h>
 #include <stdint.h>
 
 void tty_init( void );
 void tty_putc( uint8_t );
+void tty_write( const uint8_t*, size_t );
 
 #endif
@@ -0,0 +1,49 @@
+
+/**
+ * Copyright (C) 2018 - 2020 bolthur project.
+ *
+ * This file is part of bolthur/kernel.
+ *
+ * bolthur/kernel is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * bolthur/kernel is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if ! defined( __LIB_LZ4__ )
+#define __LIB_LZ4__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define LZ4_FRAME_MAGIC 0x184D2204
+#define LZ4_LEGACY_MAGIC 0x184C2102
+#define LZ4_SKIPPABLE_MAGIC 0x184D2A50
+#define LZ4_SKIPPABLE_MASK 0xFFFFFFF0
+
+#define LZ4_FRAME_VERSION_MASK 0xC0
+#define LZ4_FRAME_VERSION 0x40
+#define LZ4_FRAME_BLOCK_CHECKSUM ( 1 << 4 )
+#define LZ4_FRAME_CONTENT_SIZE ( 1 << 3 )
+#define LZ4_FRAME_CONTENT_CHECKSUM ( 1 << 2 )
+#define LZ4_FRAME_DICTIONARY_ID ( 1 << 0 )
+
+#define LZ4_BLOCK_UNCOMPRESSED 0x80000000
+#define LZ4_BLOCK_MIN_MATCH 4
+
+bool lz4_check( uintptr_t, size_t );
+size_t lz4_size( uintptr_t, size_t );
+size_t lz4_decompress( uintptr_t, size_t, uintptr_t, size_t );
+bool lz4_block_decompress(
+  const uint8_t*, size_t, uint8_t*, size_t*, size_t );
+
+#endif
@@ -23,8 +23,10 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #define TAR_HEADER_SIZE 512
+#define TAR_FILE_NAME_SIZE 100
 
 typedef enum {
   TAR_FILE_TYPE_NORMAL_FILE = '0',
@@ -50,6 +52,23 @@ typedef struct {
   char __padding[ 255 ];
 } tar_header_t, *tar_header_ptr_t;
 
+typedef struct tar_index_entry {
+  const char* name;
+  size_t name_length;
+  uint32_t hash;
+  tar_header_ptr_t header;
+  uint8_t* data;
+  uint64_t size;
+  struct tar_index_entry* next;
+} tar_index_entry_t, *tar_index_entry_ptr_t;
+
+typedef struct {
+  size_t count;
+  size_t bucket_count;
+  tar_index_entry_ptr_t* bucket;
+  tar_index_entry_ptr_t entry;
+} tar_index_t, *tar_index_ptr_t;
+
 uint64_t tar_total_size( uintptr_t );
 uint64_t tar_size( tar_header_ptr_t );
 tar_header_ptr_t tar_next( tar_header_ptr_t );
@@ -58,4 +77,10 @@ uint8_t* tar_file( tar_header_ptr_t );
 bool tar_end_reached( tar_header_ptr_t );
 uint64_t octal_size_to_int( const char*, size_t );
 
+tar_index_ptr_t tar_index_create( uintptr_t );
+void tar_index_destroy( tar_index_ptr_t );
+tar_index_entry_ptr_t tar_index_lookup( tar_index_ptr_t, const char* );
+tar_index_entry_ptr_t tar_index_next(
+  tar_index_ptr_t, const char*, tar_index_entry_ptr_t );
+
 #endif
@@ -21,6 +21,7 @@
 #if ! defined( __KERNEL_VENDOR_RPI_FRAMEBUFFER__ )
 #define __KERNEL_VENDOR_RPI_FRAMEBUFFER__
 
+#include <stddef.h>
 #include <stdint.h>
 
 #define FRAMEBUFFER_SCREEN_WIDTH 800 // 960
@@ -29,9 +30,12 @@
 
 void framebuffer_init( void );
 void framebuffer_putc( uint8_t );
+void framebuffer_write( const uint8_t*, size_t );
 
 uintptr_t framebuffer_end_get( void );
 uintptr_t framebuffer_base_get( void );
 void framebuffer_base_set( uintptr_t );
+uint64_t framebuffer_physical_get( void );
+size_t framebuffer_size_get( void );
 
 #endif
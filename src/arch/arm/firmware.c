@@ -76,24 +76,14 @@ void firmware_init( void ) {
     // transform to virtual
     firmware_info.atag_fdt = PHYS_2_VIRT( atag_fdt );
   } else if ( 0 == fdt_check_header( ( void* )atag_fdt ) ) {
-    // map device tree binary
-    uintptr_t start = atag_fdt;
-    uintptr_t end = start + fdt32_to_cpu(
-      ( ( struct fdt_header* )atag_fdt )->totalsize
-    );
-    uintptr_t virtual = PHYS_2_VIRT( start );
-    // map until end of dtb
-    while ( start < end ) {
-      virt_map_address(
-        kernel_context,
-        virtual,
-        start,
-        VIRT_MEMORY_TYPE_NORMAL,
-        VIRT_PAGE_TYPE_EXECUTABLE );
-      // next page
-      start += PAGE_SIZE;
-      virtual += PAGE_SIZE;
-    }
+    // map device tree binary until end of dtb
+    virt_map_range(
+      kernel_context,
+      PHYS_2_VIRT( atag_fdt ),
+      atag_fdt,
+      fdt32_to_cpu( ( ( struct fdt_header* )atag_fdt )->totalsize ),
+      VIRT_MEMORY_TYPE_NORMAL,
+      VIRT_PAGE_TYPE_EXECUTABLE );
     // overwrite
     firmware_info.atag_fdt = PHYS_2_VIRT( atag_fdt );
   }
@@ -0,0 +1,107 @@
+
+/**
+ * Copyright (C) 2018 - 2020 bolthur project.
+ *
+ * This file is part of bolthur/kernel.
+ *
+ * bolthur/kernel is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * bolthur/kernel is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <core/debug/debug.h>
+#include <core/mm/virt.h>
+#include <arch/arm/mm/virt/asid.h>
+
+/**
+ * @brief Current asid generation, zero marks contexts without asid
+ */
+static uint32_t asid_generation = 1;
+
+/**
+ * @brief Next asid to hand out within current generation
+ */
+static uint32_t asid_next = VIRT_ASID_KERNEL + 1;
+
+/**
+ * @brief Assign asid to context if necessary
+ *
+ * @param ctx context to assign an asid to
+ * @return true asid space rolled over and the complete tlb has to be flushed
+ * @return false asid of context can be used without complete flush
+ */
+bool virt_asid_assign( virt_context_ptr_t ctx ) {
+  // kernel context uses global mappings only
+  if ( VIRT_CONTEXT_TYPE_KERNEL == ctx->type ) {
+    ctx->asid = VIRT_ASID_KERNEL;
+    return false;
+  }
+
+  // asid of current generation is still valid
+  if ( asid_generation == ctx->asid_generation ) {
+    return false;
+  }
+
+  bool rollover = false;
+  // handle exhausted asid space
+  if ( VIRT_ASID_COUNT <= asid_next ) {
+    // start new generation, all older asids are invalid now
+    ++asid_generation;
+    // skip zero as it marks contexts without asid
+    if ( 0 == asid_generation ) {
+      ++asid_generation;
+    }
+    // reset next asid
+    asid_next = VIRT_ASID_KERNEL + 1;
+    // set rollover flag
+    rollover = true;
+  }
+
+  // assign asid and generation
+  ctx->asid = asid_next++;
+  ctx->asid_generation = asid_generation;
+
+  // debug output
+  #if defined( PRINT_MM_VIRT )
+    DEBUG_OUTPUT( "ctx = %p, asid = %u, generation = %u, rollover = %d\r\n",
+      ( void* )ctx, ctx->asid, ctx->asid_generation, rollover );
+  #endif
+
+  // return rollover flag
+  return rollover;
+}
+
+/**
+ * @brief Check whether tlb may contain entries of context
+ *
+ * @param ctx context to check
+ * @return true context is kernel context or has an asid of current generation
+ * @return false context has no valid asid
+ */
+bool virt_asid_valid( virt_context_ptr_t ctx ) {
+  return VIRT_CONTEXT_TYPE_KERNEL == ctx->type
+    || asid_generation == ctx->asid_generation;
+}
+
+/**
+ * @brief Get asid used for tlb maintenance of context
+ *
+ * @param ctx context to get asid for
+ * @return uint32_t asid or kernel asid for global mappings
+ */
+uint32_t virt_asid_get( virt_context_ptr_t ctx ) {
+  return VIRT_CONTEXT_TYPE_KERNEL == ctx->type
+    ? VIRT_ASID_KERNEL
+    : ctx->asid;
+}
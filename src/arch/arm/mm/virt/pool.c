@@ -0,0 +1,305 @@
+
+/**
+ * Copyright (C) 2018 - 2020 bolthur project.
+ *
+ * This file is part of bolthur/kernel.
+ *
+ * bolthur/kernel is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * bolthur/kernel is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <avl.h>
+#include <core/panic.h>
+#include <core/entry.h>
+#include <core/debug/debug.h>
+#include <core/mm/phys.h>
+#include <core/mm/virt.h>
+#include <arch/arm/cache.h>
+#include <arch/arm/mm/virt/pool.h>
+
+/**
+ * @brief Chunks backing page table memory
+ */
+static virt_pool_chunk_t pool_chunk[ VIRT_POOL_MAX_CHUNK ];
+
+/**
+ * @brief Amount of used chunks
+ */
+static size_t pool_chunk_count = 0;
+
+/**
+ * @brief Next free address within page table window
+ */
+static uintptr_t pool_window_end = VIRT_POOL_WINDOW_START;
+
+/**
+ * @brief Flag indicating that tables for the window have been created
+ */
+static bool pool_window_prepared = false;
+
+/**
+ * @brief Compare callback for chunk tree
+ *
+ * @param a node a
+ * @param b node b
+ * @return int32_t
+ */
+static int32_t compare_chunk_callback(
+  const avl_node_ptr_t a,
+  const avl_node_ptr_t b
+) {
+  // -1 if address of a is greater than address of b
+  if ( a->data > b->data ) {
+    return -1;
+  // 1 if address of b is greater than address of a
+  } else if ( b->data > a->data ) {
+    return 1;
+  }
+
+  // equal => return 0
+  return 0;
+}
+
+/**
+ * @brief Tree of chunks by physical address
+ */
+static avl_tree_t pool_tree = { NULL, compare_chunk_callback };
+
+/**
+ * @brief Helper to create a new chunk
+ *
+ * @return virt_pool_chunk_ptr_t created chunk
+ */
+static virt_pool_chunk_ptr_t create_chunk( void ) {
+  virt_pool_chunk_ptr_t chunk;
+
+  // assert free chunk slot
+  assert( VIRT_POOL_MAX_CHUNK > pool_chunk_count );
+  // get chunk
+  chunk = &pool_chunk[ pool_chunk_count ];
+
+  // before virtual memory is up, the early heap within the kernel image is
+  // used, which stays reachable through the kernel mapping afterwards
+  if ( ! virt_init_get() ) {
+    // limit early chunks to leave early heap for other allocations
+    if ( VIRT_POOL_MAX_EARLY_CHUNK <= pool_chunk_count ) {
+      PANIC( "Early page table chunks exhausted!" );
+    }
+    chunk->virtual = ( uintptr_t )aligned_alloc(
+      VIRT_POOL_CHUNK_SIZE, VIRT_POOL_CHUNK_SIZE );
+    // handle early heap exhausted
+    if ( 0 == chunk->virtual ) {
+      PANIC( "Early heap exhausted by page table chunk!" );
+    }
+    chunk->physical = ( uint64_t )VIRT_2_PHYS( chunk->virtual );
+  // afterwards chunks are taken from physical memory and mapped permanently
+  } else {
+    // assert prepared window with enough space
+    assert( pool_window_prepared );
+    assert(
+      VIRT_POOL_WINDOW_START + VIRT_POOL_WINDOW_SIZE
+        >= pool_window_end + VIRT_POOL_CHUNK_SIZE - 1
+    );
+    // get physical memory
+    chunk->physical = phys_find_free_page_range(
+      VIRT_POOL_CHUNK_SIZE, VIRT_POOL_CHUNK_SIZE );
+    chunk->virtual = pool_window_end;
+    // map into window, tables of the window are already existing
+    virt_map_range(
+      kernel_context,
+      chunk->virtual,
+      chunk->physical,
+      VIRT_POOL_CHUNK_SIZE,
+      VIRT_MEMORY_TYPE_NORMAL,
+      VIRT_PAGE_TYPE_NON_EXECUTABLE
+    );
+    // increase window end
+    pool_window_end += VIRT_POOL_CHUNK_SIZE;
+  }
+
+  // clear chunk and push it to table walk
+  memset( ( void* )chunk->virtual, 0, VIRT_POOL_CHUNK_SIZE );
+  cache_clean_table( chunk->virtual, VIRT_POOL_CHUNK_SIZE );
+  chunk->used = 0;
+
+  // insert into tree
+  avl_prepare_node( &chunk->node, ( void* )( uintptr_t )chunk->physical );
+  avl_insert_by_node( &pool_tree, &chunk->node );
+  // increase count
+  pool_chunk_count++;
+
+  // debug output
+  #if defined( PRINT_MM_VIRT )
+    DEBUG_OUTPUT( "Created table chunk %#016llx at %p\r\n",
+      chunk->physical, ( void* )chunk->virtual );
+  #endif
+
+  // return chunk
+  return chunk;
+}
+
+/**
+ * @brief Allocate zeroed page table memory with permanent mapping
+ *
+ * @param alignment wanted alignment
+ * @param size size to allocate
+ * @return uint64_t physical address
+ */
+uint64_t virt_pool_allocate( size_t alignment, size_t size ) {
+  uint32_t page_amount, alignment_amount, mask;
+  virt_pool_chunk_ptr_t chunk;
+
+  // round up to full page
+  if ( 0 < size % PAGE_SIZE ) {
+    size += PAGE_SIZE - size % PAGE_SIZE;
+  }
+  // determine page and alignment amount
+  page_amount = ( uint32_t )( size / PAGE_SIZE );
+  alignment_amount = PAGE_SIZE < alignment
+    ? ( uint32_t )( alignment / PAGE_SIZE )
+    : 1;
+
+  // assert request fitting into one chunk
+  assert( 0 < page_amount && VIRT_POOL_PAGE_PER_CHUNK >= page_amount );
+  assert( VIRT_POOL_PAGE_PER_CHUNK >= alignment_amount );
+
+  // build used mask for amount of pages
+  mask = ( uint32_t )( ( 1ULL << page_amount ) - 1 );
+
+  // try existing chunks, create a new one if necessary
+  for ( size_t idx = 0; idx <= pool_chunk_count; idx++ ) {
+    chunk = idx < pool_chunk_count ? &pool_chunk[ idx ] : create_chunk();
+
+    // check aligned positions within chunk
+    for (
+      uint32_t page = 0;
+      page + page_amount <= VIRT_POOL_PAGE_PER_CHUNK;
+      page += alignment_amount
+    ) {
+      // skip used
+      if ( chunk->used & ( mask << page ) ) {
+        continue;
+      }
+
+      // mark as used
+      chunk->used |= mask << page;
+
+      // debug output
+      #if defined( PRINT_MM_VIRT )
+        DEBUG_OUTPUT( "Allocated table memory %#016llx, size = %zu\r\n",
+          chunk->physical + page * PAGE_SIZE, size );
+      #endif
+
+      // return physical address
+      return chunk->physical + page * PAGE_SIZE;
+    }
+  }
+
+  // not reachable, new chunk is always suitable
+  PANIC( "Unable to allocate page table memory!" );
+}
+
+/**
+ * @brief Free page table memory again
+ *
+ * @param physical physical address
+ * @param size size to free
+ */
+void virt_pool_free( uint64_t physical, size_t size ) {
+  avl_node_ptr_t node;
+  virt_pool_chunk_ptr_t chunk;
+  uint32_t page, page_amount;
+
+  // find chunk
+  node = avl_find_by_data(
+    &pool_tree,
+    ( void* )( uintptr_t )( physical & ~( ( uint64_t )VIRT_POOL_CHUNK_SIZE - 1 ) )
+  );
+  assert( NULL != node );
+  chunk = VIRT_POOL_GET_CHUNK( node );
+
+  // round up to full page
+  if ( 0 < size % PAGE_SIZE ) {
+    size += PAGE_SIZE - size % PAGE_SIZE;
+  }
+  // determine first page and amount
+  page = ( uint32_t )( ( physical - chunk->physical ) / PAGE_SIZE );
+  page_amount = ( uint32_t )( size / PAGE_SIZE );
+
+  // clear memory, push it to table walk and mark as free
+  memset(
+    ( void* )( chunk->virtual + page * PAGE_SIZE ), 0, page_amount * PAGE_SIZE );
+  cache_clean_table(
+    chunk->virtual + page * PAGE_SIZE, page_amount * PAGE_SIZE );
+  chunk->used &= ~( ( uint32_t )( ( 1ULL << page_amount ) - 1 ) << page );
+}
+
+/**
+ * @brief Get permanently mapped address of page table memory
+ *
+ * @param physical physical address of page table memory
+ * @return uintptr_t virtual address
+ */
+uintptr_t virt_pool_virtual( uint64_t physical ) {
+  avl_node_ptr_t node;
+  virt_pool_chunk_ptr_t chunk;
+
+  // find chunk
+  node = avl_find_by_data(
+    &pool_tree,
+    ( void* )( uintptr_t )( physical & ~( ( uint64_t )VIRT_POOL_CHUNK_SIZE - 1 ) )
+  );
+  // handle not existing
+  if ( NULL == node ) {
+    PANIC( "Page table memory not within pool!" );
+  }
+
+  // get chunk and return address
+  chunk = VIRT_POOL_GET_CHUNK( node );
+  return chunk->virtual + ( uintptr_t )( physical - chunk->physical );
+}
+
+/**
+ * @brief Create all tables necessary for page table window
+ *
+ * @param ctx kernel context
+ */
+void virt_pool_prepare( virt_context_ptr_t ctx ) {
+  // ensure kernel context
+  assert( VIRT_CONTEXT_TYPE_KERNEL == ctx->type );
+
+  // create tables for whole window, one megabyte is the smallest table span
+  for (
+    uintptr_t v = VIRT_POOL_WINDOW_START;
+    v < VIRT_POOL_WINDOW_START + VIRT_POOL_WINDOW_SIZE;
+    v += 0x100000
+  ) {
+    virt_create_table( ctx, v, 0 );
+  }
+
+  // debug output
+  #if defined( PRINT_MM_VIRT )
+    DEBUG_OUTPUT( "Prepared page table window %p - %p\r\n",
+      ( void* )VIRT_POOL_WINDOW_START,
+      ( void* )( VIRT_POOL_WINDOW_START + VIRT_POOL_WINDOW_SIZE ) );
+  #endif
+
+  // set flag
+  pool_window_prepared = true;
+}
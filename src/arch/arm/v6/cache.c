@@ -0,0 +1,135 @@
+
+/**
+ * Copyright (C) 2018 - 2020 bolthur project.
+ *
+ * This file is part of bolthur/kernel.
+ *
+ * bolthur/kernel is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * bolthur/kernel is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <arch/arm/barrier.h>
+#include <arch/arm/cache.h>
+
+/**
+ * @brief Data cache line size of arm11
+ */
+#define CACHE_LINE_SIZE 32
+
+/**
+ * @brief Clean and invalidate caches and enable data cache, instruction
+ * cache and branch prediction
+ */
+void cache_enable( void ) {
+  uint32_t reg;
+
+  // bring caches into a defined state
+  cache_clean_invalidate_data_cache();
+  cache_invalidate_instruction_cache();
+  cache_invalidate_branch_predictor();
+  barrier_data_sync();
+
+  // load control register content
+  __asm__ __volatile__( "mrc p15, 0, %0, c1, c0, 0" : "=r" ( reg ) : : "cc" );
+  // enable data cache, branch prediction and instruction cache
+  reg |= ( 1 << 2 ) | ( 1 << 11 ) | ( 1 << 12 );
+  // write back changes
+  __asm__ __volatile__( "mcr p15, 0, %0, c1, c0, 0" : : "r" ( reg ) : "cc" );
+  // flush prefetch buffer
+  barrier_instruction_sync();
+}
+
+/**
+ * @brief Invalidate instruction cache
+ */
+void cache_invalidate_instruction_cache( void ) {
+  __asm__ __volatile__( "mcr p15, 0, %0, c7, c5, 0" : : "r" ( 0 ) : "memory" );
+}
+
+/**
+ * @brief Invalidate branch predictor
+ */
+void cache_invalidate_branch_predictor( void ) {
+  __asm__ __volatile__( "mcr p15, 0, %0, c7, c5, 6" : : "r" ( 0 ) : "memory" );
+}
+
+/**
+ * @brief Clean and invalidate complete data cache
+ */
+void cache_clean_invalidate_data_cache( void ) {
+  __asm__ __volatile__( "mcr p15, 0, %0, c7, c14, 0" : : "r" ( 0 ) : "memory" );
+  barrier_data_sync();
+}
+
+/**
+ * @brief Clean data cache by virtual address range
+ *
+ * @param addr start address
+ * @param size size of range
+ */
+void cache_clean_range( uintptr_t addr, size_t size ) {
+  for (
+    uintptr_t current = addr - addr % CACHE_LINE_SIZE;
+    current < addr + size;
+    current += CACHE_LINE_SIZE
+  ) {
+    __asm__ __volatile__( "mcr p15, 0, %0, c7, c10, 1" : : "r" ( current ) );
+  }
+  barrier_data_sync();
+}
+
+/**
+ * @brief Invalidate data cache by virtual address range
+ *
+ * @param addr start address
+ * @param size size of range
+ */
+void cache_invalidate_range( uintptr_t addr, size_t size ) {
+  for (
+    uintptr_t current = addr - addr % CACHE_LINE_SIZE;
+    current < addr + size;
+    current += CACHE_LINE_SIZE
+  ) {
+    __asm__ __volatile__( "mcr p15, 0, %0, c7, c6, 1" : : "r" ( current ) );
+  }
+  barrier_data_sync();
+}
+
+/**
+ * @brief Clean and invalidate data cache by virtual address range
+ *
+ * @param addr start address
+ * @param size size of range
+ */
+void cache_clean_invalidate_range( uintptr_t addr, size_t size ) {
+  for (
+    uintptr_t current = addr - addr % CACHE_LINE_SIZE;
+    current < addr + size;
+    current += CACHE_LINE_SIZE
+  ) {
+    __asm__ __volatile__( "mcr p15, 0, %0, c7, c14, 1" : : "r" ( current ) );
+  }
+  barrier_data_sync();
+}
+
+/**
+ * @brief Make translation table updates visible to the table walk
+ *
+ * @param addr start address of changed table entries
+ * @param size size of changed range
+ */
+void cache_clean_table( uintptr_t addr, size_t size ) {
+  cache_clean_range( addr, size );
+}
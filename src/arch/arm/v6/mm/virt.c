@@ -116,8 +116,9 @@ void virt_map_address(
  * @param vaddr virtual address to map
  * @param type memory type
  * @param page page attributes
+ * @return bool false when no physical page is available
  */
-void virt_map_address_random(
+bool virt_map_address_random(
   virt_context_ptr_t ctx,
   uintptr_t vaddr,
   virt_memory_type_t type,
@@ -125,7 +126,59 @@ void virt_map_address_random(
 ) {
   // check for v6 long descriptor format
   if ( ID_MMFR0_VSMA_V6_PAGING & supported_modes ) {
-    v6_short_map_random( ctx, vaddr, type, page );
+    return v6_short_map_random( ctx, vaddr, type, page );
+  // Panic when mode is unsupported
+  } else {
+    PANIC( "Unsupported mode!" );
+  }
+}
+
+/**
+ * @brief Map physical range to virtual range
+ *
+ * @param ctx pointer to page context
+ * @param vaddr start of virtual range
+ * @param paddr start of physical range
+ * @param size size of range
+ * @param type memory type
+ * @param page page attributes
+ */
+void virt_map_range(
+  virt_context_ptr_t ctx,
+  uintptr_t vaddr,
+  uint64_t paddr,
+  size_t size,
+  virt_memory_type_t type,
+  uint32_t page
+) {
+  // check for v6 short descriptor format
+  if ( ID_MMFR0_VSMA_V6_PAGING & supported_modes ) {
+    v6_short_map_range( ctx, vaddr, paddr, size, type, page );
+  // Panic when mode is unsupported
+  } else {
+    PANIC( "Unsupported mode!" );
+  }
+}
+
+/**
+ * @brief Map virtual range with random physical pages
+ *
+ * @param ctx pointer to context
+ * @param vaddr start of virtual range
+ * @param size size of range
+ * @param type memory type
+ * @param page page attributes
+ */
+void virt_map_range_random(
+  virt_context_ptr_t ctx,
+  uintptr_t vaddr,
+  size_t size,
+  virt_memory_type_t type,
+  uint32_t page
+) {
+  // check for v6 short descriptor format
+  if ( ID_MMFR0_VSMA_V6_PAGING & supported_modes ) {
+    v6_short_map_range_random( ctx, vaddr, size, type, page );
   // Panic when mode is unsupported
   } else {
     PANIC( "Unsupported mode!" );
@@ -166,6 +219,29 @@ void virt_unmap_address( virt_context_ptr_t ctx, uintptr_t addr, bool free_phys
   }
 }
 
+/**
+ * @brief Unmap virtual range
+ *
+ * @param ctx pointer to page context
+ * @param addr start of virtual range
+ * @param size size of range
+ * @param free_phys flag to free also physical memory
+ */
+void virt_unmap_range(
+  virt_context_ptr_t ctx,
+  uintptr_t addr,
+  size_t size,
+  bool free_phys
+) {
+  // check for v6 short descriptor format
+  if ( ID_MMFR0_VSMA_V6_PAGING & supported_modes ) {
+    v6_short_unmap_range( ctx, addr, size, free_phys );
+  // Panic when mode is unsupported
+  } else {
+    PANIC( "Unsupported mode!" );
+  }
+}
+
 /**
  * @brief Unmap temporary mapped page again
  *
@@ -288,6 +364,34 @@ void virt_flush_address( virt_context_ptr_t ctx, uintptr_t addr ) {
   }
 }
 
+/**
+ * @brief Flush virtual range
+ *
+ * @param ctx used context
+ * @param addr start of virtual range
+ * @param size size of range
+ */
+void virt_flush_range( virt_context_ptr_t ctx, uintptr_t addr, size_t size ) {
+  // no flush if not initialized or context currently not active
+  if (
+    ! virt_init_get()
+    || (
+      ctx != kernel_context
+      && ctx != user_context
+    )
+  ) {
+    return;
+  }
+
+  // check for v6 short descriptor format
+  if ( ID_MMFR0_VSMA_V6_PAGING & supported_modes ) {
+    v6_short_flush_range( addr, size );
+  // Panic when mode is unsupported
+  } else {
+    PANIC( "Unsupported mode!" );
+  }
+}
+
 /**
  * @brief Method to prepare temporary area
  *
@@ -331,3 +435,39 @@ bool virt_is_mapped_in_context( virt_context_ptr_t ctx, uintptr_t addr ) {
     PANIC( "Unsupported mode!" );
   }
 }
+
+/**
+ * @brief Method checks whether address is mapped writable
+ *
+ * @param ctx
+ * @param addr
+ * @return true
+ * @return false
+ */
+bool virt_is_writable_in_context( virt_context_ptr_t ctx, uintptr_t addr ) {
+  // Panic when mode is unsupported
+  if ( ID_MMFR0_VSMA_V6_PAGING & supported_modes ) {
+    return v6_short_is_writable_in_context( ctx, addr );
+  } else {
+    PANIC( "Unsupported mode!" );
+  }
+}
+
+/**
+ * @brief Method gets physical address of mapped virtual address
+ *
+ * @param ctx
+ * @param addr
+ * @return uint64_t
+ */
+uint64_t virt_get_mapped_address_in_context(
+  virt_context_ptr_t ctx,
+  uintptr_t addr
+) {
+  // Panic when mode is unsupported
+  if ( ID_MMFR0_VSMA_V6_PAGING & supported_modes ) {
+    return v6_short_get_mapped_address_in_context( ctx, addr );
+  } else {
+    PANIC( "Unsupported mode!" );
+  }
+}
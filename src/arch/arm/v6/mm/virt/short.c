@@ -145,6 +145,46 @@ void v6_short_map(
   PANIC( "v6 mmu mapping not yet supported!" );
 }
 
+/**
+ * @brief Internal v6 range mapping function
+ *
+ * @param ctx pointer to page context
+ * @param vaddr start of virtual range
+ * @param paddr start of physical range
+ * @param size size of range
+ * @param type memory type
+ * @param page page attributes
+ */
+void v6_short_map_range(
+  __unused virt_context_ptr_t ctx,
+  __unused uintptr_t vaddr,
+  __unused uint64_t paddr,
+  __unused size_t size,
+  __unused virt_memory_type_t type,
+  __unused uint32_t page
+) {
+  PANIC( "v6 mmu range mapping not yet supported!" );
+}
+
+/**
+ * @brief Internal v6 random range mapping function
+ *
+ * @param ctx pointer to page context
+ * @param vaddr start of virtual range
+ * @param size size of range
+ * @param type memory type
+ * @param page page attributes
+ */
+void v6_short_map_range_random(
+  __unused virt_context_ptr_t ctx,
+  __unused uintptr_t vaddr,
+  __unused size_t size,
+  __unused virt_memory_type_t type,
+  __unused uint32_t page
+) {
+  PANIC( "v6 mmu range mapping not yet supported!" );
+}
+
 /**
  * @brief Map a physical address within temporary space
  *
@@ -174,6 +214,23 @@ void v6_short_unmap(
   PANIC( "v6 mmu mapping not yet supported!" );
 }
 
+/**
+ * @brief Internal v6 range unmapping function
+ *
+ * @param ctx pointer to page context
+ * @param vaddr start of virtual range
+ * @param size size of range
+ * @param free_phys flag to free also physical memory
+ */
+void v6_short_unmap_range(
+  __unused virt_context_ptr_t ctx,
+  __unused uintptr_t vaddr,
+  __unused size_t size,
+  __unused bool free_phys
+) {
+  PANIC( "v6 mmu range unmapping not yet supported!" );
+}
+
 /**
  * @brief Unmap temporary mapped page again
  *
@@ -229,6 +286,16 @@ void v6_short_flush_address( __unused uintptr_t  addr ) {
   PANIC( "Flush v6 context not yet supported!" );
 }
 
+/**
+ * @brief Internal v6 short descriptor function to flush virtual range
+ *
+ * @param addr start of virtual range
+ * @param size size of range
+ */
+void v6_short_flush_range( __unused uintptr_t addr, __unused size_t size ) {
+  PANIC( "Flush v6 context not yet supported!" );
+}
+
 /**
  * @brief Helper to reserve temporary area for mappings
  *
@@ -275,3 +342,32 @@ bool v6_short_is_mapped_in_context(
 ) {
   PANIC( "NOT SUPPORTED!" );
 }
+
+/**
+ * @brief Checks whether address is mapped writable
+ *
+ * @param ctx
+ * @param addr
+ * @return true
+ * @return false
+ */
+bool v6_short_is_writable_in_context(
+  __unused virt_context_ptr_t ctx,
+  __unused uintptr_t addr
+) {
+  PANIC( "NOT SUPPORTED!" );
+}
+
+/**
+ * @brief Get physical address of a mapped virtual address
+ *
+ * @param ctx
+ * @param addr
+ * @return uint64_t
+ */
+uint64_t v6_short_get_mapped_address_in_context(
+  __unused virt_context_ptr_t ctx,
+  __unused uintptr_t addr
+) {
+  PANIC( "NOT SUPPORTED!" );
+}
@@ -18,7 +18,126 @@
  * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <arch/arm/v7/cache.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <arch/arm/barrier.h>
+#include <arch/arm/cache.h>
+
+/**
+ * @brief Set / way operation to perform
+ */
+typedef enum {
+  CACHE_SET_WAY_INVALIDATE,
+  CACHE_SET_WAY_CLEAN,
+  CACHE_SET_WAY_CLEAN_INVALIDATE,
+} cache_set_way_t;
+
+/**
+ * @brief Flag whether table walks are coherent with the data cache
+ */
+static bool cache_coherent_walk = false;
+
+/**
+ * @brief Get smallest data cache line size from cache type register
+ *
+ * @return uint32_t line size in bytes
+ */
+static uint32_t data_line_size( void ) {
+  uint32_t ctr;
+  // read cache type register
+  __asm__ __volatile__( "mrc p15, 0, %0, c0, c0, 1" : "=r" ( ctr ) );
+  // dminline is log2 of words within smallest data cache line
+  return 4u << ( ( ctr >> 16 ) & 0xF );
+}
+
+/**
+ * @brief Helper to apply set / way operation on all data cache levels
+ *
+ * @param operation operation to perform
+ */
+static void data_set_way( cache_set_way_t operation ) {
+  uint32_t clidr;
+  // read cache level id register
+  __asm__ __volatile__( "mrc p15, 1, %0, c0, c0, 1" : "=r" ( clidr ) );
+  // get level of coherency
+  uint32_t loc = ( clidr >> 24 ) & 0x7;
+
+  // loop through levels up to level of coherency
+  for ( uint32_t level = 0; level < loc; level++ ) {
+    // skip levels without data or unified cache
+    if ( 2 > ( ( clidr >> ( level * 3 ) ) & 0x7 ) ) {
+      continue;
+    }
+
+    uint32_t ccsidr;
+    // select data cache of level and read its geometry
+    __asm__ __volatile__(
+      "mcr p15, 2, %0, c0, c0, 0" : : "r" ( level << 1 ) : "memory"
+    );
+    barrier_instruction_sync();
+    __asm__ __volatile__( "mrc p15, 1, %0, c0, c0, 0" : "=r" ( ccsidr ) );
+
+    // extract line size, ways and sets
+    uint32_t line_shift = ( ccsidr & 0x7 ) + 4;
+    uint32_t ways = ( ( ccsidr >> 3 ) & 0x3FF ) + 1;
+    uint32_t sets = ( ( ccsidr >> 13 ) & 0x7FFF ) + 1;
+    uint32_t way_shift = 1 < ways
+      ? ( uint32_t )__builtin_clz( ways - 1 )
+      : 0;
+
+    // loop through ways and sets
+    for ( uint32_t way = 0; way < ways; way++ ) {
+      for ( uint32_t set = 0; set < sets; set++ ) {
+        // build set / way value
+        uint32_t value = ( way << way_shift )
+          | ( set << line_shift )
+          | ( level << 1 );
+        // perform operation
+        if ( CACHE_SET_WAY_INVALIDATE == operation ) {
+          __asm__ __volatile__( "mcr p15, 0, %0, c7, c6, 2" : : "r" ( value ) );
+        } else if ( CACHE_SET_WAY_CLEAN == operation ) {
+          __asm__ __volatile__( "mcr p15, 0, %0, c7, c10, 2" : : "r" ( value ) );
+        } else {
+          __asm__ __volatile__( "mcr p15, 0, %0, c7, c14, 2" : : "r" ( value ) );
+        }
+      }
+    }
+  }
+
+  // select level 1 data cache again
+  __asm__ __volatile__( "mcr p15, 2, %0, c0, c0, 0" : : "r" ( 0 ) : "memory" );
+  // ensure completion
+  barrier_data_sync();
+  barrier_instruction_sync();
+}
+
+/**
+ * @brief Clean and invalidate caches and enable data cache, instruction
+ * cache and branch prediction
+ */
+void cache_enable( void ) {
+  uint32_t reg;
+
+  // read memory model feature register 3 for coherent walk support
+  __asm__ __volatile__( "mrc p15, 0, %0, c0, c1, 7" : "=r" ( reg ) );
+  cache_coherent_walk = 0 != ( ( reg >> 20 ) & 0xF );
+
+  // bring caches into a defined state
+  cache_clean_invalidate_data_cache();
+  cache_invalidate_instruction_cache();
+  cache_invalidate_branch_predictor();
+  barrier_data_sync();
+
+  // load sctlr register content
+  __asm__ __volatile__( "mrc p15, 0, %0, c1, c0, 0" : "=r" ( reg ) : : "cc" );
+  // enable data cache, branch prediction and instruction cache
+  reg |= ( 1 << 2 ) | ( 1 << 11 ) | ( 1 << 12 );
+  // write back changes
+  __asm__ __volatile__( "mcr p15, 0, %0, c1, c0, 0" : : "r" ( reg ) : "cc" );
+  // instruction synchronization barrier
+  barrier_instruction_sync();
+}
 
 /**
  * @brief Invalidate instruction cache
@@ -26,3 +145,102 @@
 void cache_invalidate_instruction_cache( void ) {
   __asm__ __volatile__( "mcr p15, 0, %0, c7, c5, 0" : : "r" ( 0 ) : "memory" );
 }
+
+/**
+ * @brief Invalidate branch predictor
+ */
+void cache_invalidate_branch_predictor( void ) {
+  __asm__ __volatile__( "mcr p15, 0, %0, c7, c5, 6" : : "r" ( 0 ) : "memory" );
+}
+
+/**
+ * @brief Clean and invalidate complete data cache by set / way
+ */
+void cache_clean_invalidate_data_cache( void ) {
+  data_set_way( CACHE_SET_WAY_CLEAN_INVALIDATE );
+}
+
+/**
+ * @brief Clean data cache by virtual address range to point of coherency
+ *
+ * @param addr start address
+ * @param size size of range
+ */
+void cache_clean_range( uintptr_t addr, size_t size ) {
+  uint32_t line = data_line_size();
+  // loop through range line by line
+  for (
+    uintptr_t current = addr - addr % line;
+    current < addr + size;
+    current += line
+  ) {
+    __asm__ __volatile__( "mcr p15, 0, %0, c7, c10, 1" : : "r" ( current ) );
+  }
+  // ensure completion
+  barrier_data_sync();
+}
+
+/**
+ * @brief Invalidate data cache by virtual address range to point of coherency
+ *
+ * @param addr start address
+ * @param size size of range
+ */
+void cache_invalidate_range( uintptr_t addr, size_t size ) {
+  uint32_t line = data_line_size();
+  // loop through range line by line
+  for (
+    uintptr_t current = addr - addr % line;
+    current < addr + size;
+    current += line
+  ) {
+    __asm__ __volatile__( "mcr p15, 0, %0, c7, c6, 1" : : "r" ( current ) );
+  }
+  // ensure completion
+  barrier_data_sync();
+}
+
+/**
+ * @brief Clean and invalidate data cache by virtual address range to point
+ * of coherency
+ *
+ * @param addr start address
+ * @param size size of range
+ */
+void cache_clean_invalidate_range( uintptr_t addr, size_t size ) {
+  uint32_t line = data_line_size();
+  // loop through range line by line
+  for (
+    uintptr_t current = addr - addr % line;
+    current < addr + size;
+    current += line
+  ) {
+    __asm__ __volatile__( "mcr p15, 0, %0, c7, c14, 1" : : "r" ( current ) );
+  }
+  // ensure completion
+  barrier_data_sync();
+}
+
+/**
+ * @brief Make translation table updates visible to the table walk
+ *
+ * @param addr start address of changed table entries
+ * @param size size of changed range
+ */
+void cache_clean_table( uintptr_t addr, size_t size ) {
+  // nothing to do when table walks snoop the data cache
+  if ( cache_coherent_walk ) {
+    return;
+  }
+  uint32_t line = data_line_size();
+  // clean to point of unification line by line
+  for (
+    uintptr_t current = addr - addr % line;
+    current < addr + size;
+    current += line
+  ) {
+    __asm__ __volatile__( "mcr p15, 0, %0, c7, c11, 1" : : "r" ( current ) );
+  }
+  // ensure completion
+  barrier_data_sync();
+}
@@ -18,12 +18,17 @@
  * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <stdbool.h>
 #include <assert.h>
 #include <arch/arm/v7/debug/debug.h>
 #include <arch/arm/v7/interrupt/vector.h>
 #include <core/event.h>
 #include <core/interrupt.h>
 #include <core/panic.h>
+#include <core/mm/virt.h>
+#include <core/task/process.h>
+#include <core/task/thread.h>
+#include <core/task/region.h>
 
 /**
  * @brief Nested counter for data abort exception handler
@@ -35,7 +40,7 @@ static uint32_t nested_data_abort = 0;
  *
  * @return uintptr_t
  */
-__maybe_unused static uintptr_t fault_address( void ) {
+static uintptr_t fault_address( void ) {
   // variable for faulting address
   uintptr_t address;
   // get faulting address
@@ -46,14 +51,96 @@ __maybe_unused static uintptr_t fault_address( void ) {
   return address;
 }
 
+/**
+ * @brief Helper returns data fault status register
+ *
+ * @return uint32_t
+ */
+static uint32_t fault_status( void ) {
+  uint32_t dfsr;
+  // read data fault status register
+  __asm__ __volatile__(
+    "mrc p15, 0, %0, c5, c0, 0" : "=r" ( dfsr ) : : "cc"
+  );
+  // return status
+  return dfsr;
+}
+
+/**
+ * @brief Helper to check data fault status for translation fault
+ *
+ * @param dfsr data fault status
+ * @return true if fault has been caused by a missing mapping
+ * @return false for any other fault
+ */
+static bool translation_fault( uint32_t dfsr ) {
+  // long descriptor format with status 0b0001LL
+  if ( dfsr & ( 1 << 9 ) ) {
+    return 0x4 == ( dfsr & 0x3c );
+  }
+  // short descriptor format with section or page translation fault
+  uint32_t status = ( dfsr & 0xf ) | ( ( dfsr >> 6 ) & 0x10 );
+  return 0x5 == status || 0x7 == status;
+}
+
+/**
+ * @brief Helper to check data fault status for write permission fault
+ *
+ * @param dfsr data fault status
+ * @return true if fault has been caused by a write to a read only page
+ * @return false for any other fault
+ */
+static bool write_permission_fault( uint32_t dfsr ) {
+  // only writes are of interest
+  if ( ! ( dfsr & ( 1 << 11 ) ) ) {
+    return false;
+  }
+  // long descriptor format with status 0b0011LL
+  if ( dfsr & ( 1 << 9 ) ) {
+    return 0xc == ( dfsr & 0x3c );
+  }
+  // short descriptor format with section or page permission fault
+  uint32_t status = ( dfsr & 0xf ) | ( ( dfsr >> 6 ) & 0x10 );
+  return 0xd == status || 0xf == status;
+}
+
+/**
+ * @brief Helper to resolve faults on user pages of running process
+ *
+ * @param origin event origin
+ * @return true if fault has been resolved and instruction can be retried
+ * @return false if fault is fatal
+ */
+static bool resolve_fault( event_origin_t origin ) {
+  uint32_t dfsr = fault_status();
+  uintptr_t address = fault_address();
+
+  // only user space of a running process can be resolved
+  if (
+    NULL == task_thread_current_thread
+    || VIRT_USER_SPACE_END <= address
+  ) {
+    return false;
+  }
+  // populate page of user region on first access
+  if ( EVENT_ORIGIN_USER == origin && translation_fault( dfsr ) ) {
+    return task_region_fault( task_thread_current_thread->process, address );
+  }
+  // duplicate shared page on first write, kernel writes to user buffers too
+  if ( write_permission_fault( dfsr ) ) {
+    return task_region_write_fault(
+      task_thread_current_thread->process, address );
+  }
+  // fatal fault
+  return false;
+}
+
 /**
  * @brief Data abort exception handler
  *
  * @param cpu cpu context
- *
- * @todo remove noreturn when handler is completed
  */
-noreturn void vector_data_abort_handler( cpu_register_context_ptr_t cpu ) {
+void vector_data_abort_handler( cpu_register_context_ptr_t cpu ) {
   // assert nesting
   nested_data_abort++;
   assert( nested_data_abort < INTERRUPT_NESTED_MAX );
@@ -68,6 +155,15 @@ noreturn void vector_data_abort_handler( cpu_register_context_ptr_t cpu ) {
     DUMP_REGISTER( cpu );
   #endif
 
+  // resolve demand paging and copy on write faults and retry instruction
+  if ( resolve_fault( origin ) ) {
+    // enqueue cleanup
+    event_enqueue( EVENT_INTERRUPT_CLEANUP, origin );
+    // decrement nested counter
+    nested_data_abort--;
+    return;
+  }
+
   // special debug exception handling
   #if defined( REMOTE_DEBUG )
     if ( debug_is_debug_exception() ) {
@@ -77,7 +173,7 @@ noreturn void vector_data_abort_handler( cpu_register_context_ptr_t cpu ) {
       PANIC( "data abort" );
     }
   #else
-    PANIC( "prefetch abort!" );
+    PANIC( "data abort!" );
   #endif
 
   // enqueue cleanup
@@ -49,12 +49,10 @@ void vector_interrupt_handler( cpu_register_context_ptr_t cpu ) {
     DUMP_REGISTER( cpu );
   #endif
 
-  // get pending interrupt
-  int8_t interrupt = interrupt_get_pending( false );
-  // assert return
-  assert( -1 != interrupt );
-  // handle bound interrupt handlers
-  interrupt_handle( ( uint8_t )interrupt, INTERRUPT_NORMAL, cpu );
+  // handle all pending interrupts within one entry
+  size_t count = interrupt_handle_pending( cpu );
+  // assert at least one handled interrupt
+  assert( 0 < count );
   // enqueue cleanup
   event_enqueue( EVENT_INTERRUPT_CLEANUP, origin );
 
@@ -25,20 +25,58 @@
 #include <core/event.h>
 #include <core/interrupt.h>
 #include <core/panic.h>
+#include <core/task/process.h>
+#include <core/task/thread.h>
+#include <core/task/region.h>
 
 /**
  * @brief Nested counter for prefetch abort exception handler
  */
 static uint32_t nested_prefetch_abort = 0;
 
+/**
+ * @brief Helper returns faulting instruction address
+ *
+ * @return uintptr_t
+ */
+static uintptr_t fault_address( void ) {
+  // variable for faulting address
+  uintptr_t address;
+  // get faulting address
+  __asm__ __volatile__(
+    "mrc p15, 0, %0, c6, c0, 2" : "=r" ( address ) : : "cc"
+  );
+  // return faulting address
+  return address;
+}
+
+/**
+ * @brief Helper to check instruction fault status for translation fault
+ *
+ * @return true if fault has been caused by a missing mapping
+ * @return false for any other fault
+ */
+static bool translation_fault( void ) {
+  uint32_t ifsr;
+  // read instruction fault status register
+  __asm__ __volatile__(
+    "mrc p15, 0, %0, c5, c0, 1" : "=r" ( ifsr ) : : "cc"
+  );
+  // long descriptor format with status 0b0001LL
+  if ( ifsr & ( 1 << 9 ) ) {
+    return 0x4 == ( ifsr & 0x3c );
+  }
+  // short descriptor format with section or page translation fault
+  uint32_t status = ( ifsr & 0xf ) | ( ( ifsr >> 6 ) & 0x10 );
+  return 0x5 == status || 0x7 == status;
+}
+
 /**
  * @brief Prefetch abort exception handler
  *
  * @param cpu cpu context
- *
- * @todo remove noreturn when handler is completed
  */
-noreturn void vector_prefetch_abort_handler( cpu_register_context_ptr_t cpu ) {
+void vector_prefetch_abort_handler( cpu_register_context_ptr_t cpu ) {
   // assert nesting
   nested_prefetch_abort++;
   assert( nested_prefetch_abort < INTERRUPT_NESTED_MAX );
@@ -52,6 +90,20 @@ noreturn void vector_prefetch_abort_handler( cpu_register_context_ptr_t cpu ) {
     DUMP_REGISTER( cpu );
   #endif
 
+  // populate page of user region on first execution and retry instruction
+  if (
+    EVENT_ORIGIN_USER == origin
+    && translation_fault()
+    && task_region_fault(
+      task_thread_current_thread->process, fault_address() )
+  ) {
+    // enqueue cleanup
+    event_enqueue( EVENT_INTERRUPT_CLEANUP, origin );
+    // decrement nested counter
+    nested_prefetch_abort--;
+    return;
+  }
+
   // special debug exception handling
   #if defined( REMOTE_DEBUG )
     if ( debug_is_debug_exception() ) {
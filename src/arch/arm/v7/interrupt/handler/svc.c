@@ -21,9 +21,11 @@
 #include <assert.h>
 #include <arch/arm/v7/debug/debug.h>
 #include <arch/arm/v7/interrupt/vector.h>
+#include <arch/arm/v7/syscall.h>
 #include <core/event.h>
 #include <core/panic.h>
 #include <core/interrupt.h>
+#include <core/syscall.h>
 
 /**
  * @brief Nested counter for software interrupt exception handler
@@ -34,8 +36,6 @@ static uint32_t nested_svc = 0;
  * @brief Software interrupt exception handler
  *
  * @param cpu cpu context
- *
- * @todo remove event timer enqueue from svc handler
  */
 void vector_svc_handler( cpu_register_context_ptr_t cpu ) {
   // assert nesting
@@ -53,21 +53,21 @@ void vector_svc_handler( cpu_register_context_ptr_t cpu ) {
     DUMP_REGISTER( cpu );
   #endif
 
-  // get svc number from instruction
-  uint32_t svc_num = *( ( uint32_t* )( ( uintptr_t )cpu->reg.pc ) ) & 0xffff;
+  // get syscall number from register
+  uint32_t num = SYSCALL_NUMBER( cpu );
   // apply offset
   cpu->reg.pc += 4;
 
   // debug output
   #if defined( PRINT_EXCEPTION )
     DEBUG_OUTPUT( "address of cpu = %p\r\n", ( void* )cpu );
-    DEBUG_OUTPUT( "svc_num = %u\r\n", svc_num );
+    DEBUG_OUTPUT( "syscall number = %u\r\n", num );
   #endif
 
-  // handle bound interrupt handlers
-  interrupt_handle( ( uint8_t )svc_num, INTERRUPT_SOFTWARE, cpu );
-  // enqueue timer event for testing
-  event_enqueue( EVENT_TIMER, origin );
+  // dispatch syscall, rescheduling is requested by syscall if necessary
+  if ( ! syscall_handle( num, cpu ) ) {
+    SYSCALL_RETURN( cpu, SYSCALL_ERROR_INVALID );
+  }
   // enqueue cleanup
   event_enqueue( EVENT_INTERRUPT_CLEANUP, origin );
 
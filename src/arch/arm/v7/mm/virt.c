@@ -28,7 +28,9 @@
 #include <core/initrd.h>
 #include <core/mm/phys.h>
 #include <core/mm/virt.h>
+#include <arch/arm/cache.h>
 #include <arch/arm/mm/virt.h>
+#include <arch/arm/mm/virt/asid.h>
 #include <arch/arm/v7/mm/virt/short.h>
 #include <arch/arm/v7/mm/virt/long.h>
 
@@ -183,8 +185,9 @@ void virt_map_address(
  * @param vaddr virtual address to map
  * @param type memory type
  * @param page page attributes
+ * @return bool false when no physical page is available
  */
-void virt_map_address_random(
+bool virt_map_address_random(
   virt_context_ptr_t ctx,
   uintptr_t vaddr,
   virt_memory_type_t type,
@@ -192,13 +195,77 @@ void virt_map_address_random(
 ) {
   // check for v7 long descriptor format
   if ( ID_MMFR0_VSMA_V7_PAGING_LPAE & supported_modes ) {
-    v7_long_map_random( ctx, vaddr, type, page );
+    return v7_long_map_random( ctx, vaddr, type, page );
   // check v7 short descriptor format
   } else if (
     ID_MMFR0_VSMA_V7_PAGING_REMAP_ACCESS & supported_modes
     || ID_MMFR0_VSMA_V7_PAGING_PXN & supported_modes
   ) {
-    v7_short_map_random( ctx, vaddr, type, page );
+    return v7_short_map_random( ctx, vaddr, type, page );
+  // Panic when mode is unsupported
+  } else {
+    PANIC( "Unsupported mode!" );
+  }
+}
+
+/**
+ * @brief Map physical range to virtual range
+ *
+ * @param ctx pointer to page context
+ * @param vaddr start of virtual range
+ * @param paddr start of physical range
+ * @param size size of range
+ * @param type memory type
+ * @param page page attributes
+ */
+void virt_map_range(
+  virt_context_ptr_t ctx,
+  uintptr_t vaddr,
+  uint64_t paddr,
+  size_t size,
+  virt_memory_type_t type,
+  uint32_t page
+) {
+  // check for v7 long descriptor format
+  if ( ID_MMFR0_VSMA_V7_PAGING_LPAE & supported_modes ) {
+    v7_long_map_range( ctx, vaddr, paddr, size, type, page );
+  // check v7 short descriptor format
+  } else if (
+    ID_MMFR0_VSMA_V7_PAGING_REMAP_ACCESS & supported_modes
+    || ID_MMFR0_VSMA_V7_PAGING_PXN & supported_modes
+  ) {
+    v7_short_map_range( ctx, vaddr, paddr, size, type, page );
+  // Panic when mode is unsupported
+  } else {
+    PANIC( "Unsupported mode!" );
+  }
+}
+
+/**
+ * @brief Map virtual range with random physical pages
+ *
+ * @param ctx pointer to context
+ * @param vaddr start of virtual range
+ * @param size size of range
+ * @param type memory type
+ * @param page page attributes
+ */
+void virt_map_range_random(
+  virt_context_ptr_t ctx,
+  uintptr_t vaddr,
+  size_t size,
+  virt_memory_type_t type,
+  uint32_t page
+) {
+  // check for v7 long descriptor format
+  if ( ID_MMFR0_VSMA_V7_PAGING_LPAE & supported_modes ) {
+    v7_long_map_range_random( ctx, vaddr, size, type, page );
+  // check v7 short descriptor format
+  } else if (
+    ID_MMFR0_VSMA_V7_PAGING_REMAP_ACCESS & supported_modes
+    || ID_MMFR0_VSMA_V7_PAGING_PXN & supported_modes
+  ) {
+    v7_short_map_range_random( ctx, vaddr, size, type, page );
   // Panic when mode is unsupported
   } else {
     PANIC( "Unsupported mode!" );
@@ -251,6 +318,35 @@ void virt_unmap_address( virt_context_ptr_t ctx, uintptr_t addr, bool free_phys
   }
 }
 
+/**
+ * @brief Unmap virtual range
+ *
+ * @param ctx pointer to page context
+ * @param addr start of virtual range
+ * @param size size of range
+ * @param free_phys flag to free also physical memory
+ */
+void virt_unmap_range(
+  virt_context_ptr_t ctx,
+  uintptr_t addr,
+  size_t size,
+  bool free_phys
+) {
+  // check for v7 long descriptor format
+  if ( ID_MMFR0_VSMA_V7_PAGING_LPAE & supported_modes ) {
+    v7_long_unmap_range( ctx, addr, size, free_phys );
+  // check v7 short descriptor format
+  } else if (
+    ID_MMFR0_VSMA_V7_PAGING_REMAP_ACCESS & supported_modes
+    || ID_MMFR0_VSMA_V7_PAGING_PXN & supported_modes
+  ) {
+    v7_short_unmap_range( ctx, addr, size, free_phys );
+  // Panic when mode is unsupported
+  } else {
+    PANIC( "Unsupported mode!" );
+  }
+}
+
 /**
  * @brief Unmap temporary mapped page again
  *
@@ -391,26 +487,48 @@ void virt_flush_complete( void ) {
  * @param addr virtual address to flush
  */
 void virt_flush_address( virt_context_ptr_t ctx, uintptr_t addr ) {
-  // no flush if not initialized or context currently not active
-  if (
-    ! virt_init_get()
-    || (
-      ctx != kernel_context
-      && ctx != user_context
-    )
+  // no flush if not initialized or tlb cannot contain entries of context
+  if ( ! virt_init_get() || ! virt_asid_valid( ctx ) ) {
+    return;
+  }
+
+  // check for v7 long descriptor format
+  if ( ID_MMFR0_VSMA_V7_PAGING_LPAE & supported_modes ) {
+    v7_long_flush_address( addr - addr % PAGE_SIZE + virt_asid_get( ctx ) );
+  // check v7 short descriptor format
+  } else if (
+    ID_MMFR0_VSMA_V7_PAGING_REMAP_ACCESS & supported_modes
+    || ID_MMFR0_VSMA_V7_PAGING_PXN & supported_modes
   ) {
+    v7_short_flush_address( addr - addr % PAGE_SIZE + virt_asid_get( ctx ) );
+  // Panic when mode is unsupported
+  } else {
+    PANIC( "Unsupported mode!" );
+  }
+}
+
+/**
+ * @brief Flush virtual range with one batched tlb maintenance
+ *
+ * @param ctx pointer to page context
+ * @param addr start of virtual range
+ * @param size size of range
+ */
+void virt_flush_range( virt_context_ptr_t ctx, uintptr_t addr, size_t size ) {
+  // no flush if not initialized or tlb cannot contain entries of context
+  if ( ! virt_init_get() || ! virt_asid_valid( ctx ) ) {
     return;
   }
 
   // check for v7 long descriptor format
   if ( ID_MMFR0_VSMA_V7_PAGING_LPAE & supported_modes ) {
-    v7_long_flush_address( addr );
+    v7_long_flush_range( addr, size, virt_asid_get( ctx ) );
   // check v7 short descriptor format
   } else if (
     ID_MMFR0_VSMA_V7_PAGING_REMAP_ACCESS & supported_modes
     || ID_MMFR0_VSMA_V7_PAGING_PXN & supported_modes
   ) {
-    v7_short_flush_address( addr );
+    v7_short_flush_range( addr, size, virt_asid_get( ctx ) );
   // Panic when mode is unsupported
   } else {
     PANIC( "Unsupported mode!" );
@@ -455,6 +573,9 @@ void virt_arch_prepare( void ) {
   } else {
     PANIC( "Unsupported mode!" );
   }
+
+  // enable caches and branch prediction
+  cache_enable();
 }
 
 /**
@@ -480,3 +601,53 @@ bool virt_is_mapped_in_context( virt_context_ptr_t ctx, uintptr_t addr ) {
     PANIC( "Unsupported mode!" );
   }
 }
+
+/**
+ * @brief Method checks whether address is mapped writable
+ *
+ * @param ctx
+ * @param addr
+ * @return true
+ * @return false
+ */
+bool virt_is_writable_in_context( virt_context_ptr_t ctx, uintptr_t addr ) {
+  // check for v7 long descriptor format
+  if ( ID_MMFR0_VSMA_V7_PAGING_LPAE & supported_modes ) {
+    return v7_long_is_writable_in_context( ctx, addr );
+  // check v7 short descriptor format
+  } else if (
+    ID_MMFR0_VSMA_V7_PAGING_REMAP_ACCESS & supported_modes
+    || ID_MMFR0_VSMA_V7_PAGING_PXN & supported_modes
+  ) {
+    return v7_short_is_writable_in_context( ctx, addr );
+  // Panic when mode is unsupported
+  } else {
+    PANIC( "Unsupported mode!" );
+  }
+}
+
+/**
+ * @brief Method gets physical address of mapped virtual address
+ *
+ * @param ctx
+ * @param addr
+ * @return uint64_t
+ */
+uint64_t virt_get_mapped_address_in_context(
+  virt_context_ptr_t ctx,
+  uintptr_t addr
+) {
+  // check for v7 long descriptor format
+  if ( ID_MMFR0_VSMA_V7_PAGING_LPAE & supported_modes ) {
+    return v7_long_get_mapped_address_in_context( ctx, addr );
+  // check v7 short descriptor format
+  } else if (
+    ID_MMFR0_VSMA_V7_PAGING_REMAP_ACCESS & supported_modes
+    || ID_MMFR0_VSMA_V7_PAGING_PXN & supported_modes
+  ) {
+    return v7_short_get_mapped_address_in_context( ctx, addr );
+  // Panic when mode is unsupported
+  } else {
+    PANIC( "Unsupported mode!" );
+  }
+}
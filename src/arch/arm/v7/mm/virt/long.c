@@ -26,10 +26,12 @@
 #include <core/entry.h>
 #include <core/debug/debug.h>
 #include <arch/arm/barrier.h>
-#include <arch/arm/v7/cache.h>
+#include <arch/arm/cache.h>
 #include <core/mm/phys.h>
 #include <core/mm/heap.h>
 #include <arch/arm/mm/virt/long.h>
+#include <arch/arm/mm/virt/pool.h>
+#include <arch/arm/mm/virt/asid.h>
 #include <arch/arm/v7/mm/virt/long.h>
 #include <core/mm/virt.h>
 
@@ -119,6 +121,8 @@ void __bootstrap v7_long_startup_setup( void ) {
   ttbcr.raw = 0;
   // set large physical address extension bit
   ttbcr.data.large_physical_address_extension = 1;
+  // asid is taken from ttbr0
+  ttbcr.data.ttbr0_ttbr1_asid = 0;
   // push value to ttbcr
   __asm__ __volatile__(
     "mcr p15, 0, %0, c2, c0, 2"
@@ -301,19 +305,24 @@ static uintptr_t map_temporary( uint64_t start, size_t size ) {
       DEBUG_OUTPUT( "tbl = %p\r\n", ( void* )tbl );
     #endif
 
-    // handle it non cachable
     // set page
     tbl->page[ page_idx ].raw = LD_PHYSICAL_PAGE_ADDRESS( start );
 
-    // set attributes
+    // set attributes, write back cacheable like all other normal memory
     tbl->page[ page_idx ].data.type = LD_TYPE_PAGE;
     tbl->page[ page_idx ].data.lower_attr_access = 1;
+    tbl->page[ page_idx ].data.lower_attr_shared = 0x3;
+    tbl->page[ page_idx ].data.lower_attr_memory_attribute =
+      LD_MAIR_INDEX_NORMAL;
+    // push entry to table walk
+    cache_clean_table(
+      ( uintptr_t )&tbl->page[ page_idx ], sizeof( ld_context_page_t ) );
 
     // flush address
     virt_flush_address( kernel_context, addr );
 
     // increase physical address
-    start += i * PAGE_SIZE;
+    start += PAGE_SIZE;
   }
 
   // debug putput
@@ -361,6 +370,10 @@ static void unmap_temporary( uintptr_t addr, size_t size ) {
   // calculate end
   uintptr_t end = addr + page_amount * PAGE_SIZE;
 
+  // write back data, e.g. loaded code, and drop stale instructions
+  cache_clean_range( addr, page_amount * PAGE_SIZE );
+  cache_invalidate_instruction_cache();
+
   // debug putput
   #if defined( PRINT_MM_VIRT )
     DEBUG_OUTPUT( "end = %p\r\n", ( void* )end );
@@ -383,6 +396,9 @@ static void unmap_temporary( uintptr_t addr, size_t size ) {
 
     // unmap
     tbl->page[ page_idx ].raw = 0;
+    // push entry to table walk
+    cache_clean_table(
+      ( uintptr_t )&tbl->page[ page_idx ], sizeof( ld_context_page_t ) );
 
     // flush address
     virt_flush_address( kernel_context, addr );
@@ -398,51 +414,68 @@ static void unmap_temporary( uintptr_t addr, size_t size ) {
  * @return uintptr_t address to new table
  */
 static uint64_t get_new_table( void ) {
-  // get new page
-  uint64_t addr = phys_find_free_page( PAGE_SIZE );
+  // get new cleared page from page table pool
+  uint64_t addr = virt_pool_allocate( PAGE_SIZE, PAGE_SIZE );
   // debug output
   #if defined( PRINT_MM_VIRT )
     DEBUG_OUTPUT( "addr = %#016llx\r\n", addr );
   #endif
 
-  // map temporarily
-  uintptr_t tmp = map_temporary( addr, PAGE_SIZE );
-  // overwrite page with zero
-  memset( ( void* )tmp, 0, PAGE_SIZE );
-  // unmap page again
-  unmap_temporary( tmp, PAGE_SIZE );
-
   // return address
   return addr;
 }
 
 /**
- * @brief Internal v7 long descriptor create table function
+ * @brief Helper to replace a level 2 block by a table with pages
  *
- * @param ctx context to create table for
- * @param addr address the table is necessary for
- * @param table page table address
- * @return uintptr_t address of created and prepared table
+ * @param entry level 2 block entry to split
  */
-uint64_t v7_long_create_table(
-  virt_context_ptr_t ctx,
-  uintptr_t addr,
-  __unused uint64_t table
-) {
-  // get table idx
-  uint32_t pmd_idx = LD_VIRTUAL_PMD_INDEX( addr );
-  uint32_t tbl_idx = LD_VIRTUAL_TABLE_INDEX( addr );
+static void split_block( ld_context_table_level2_t* entry ) {
+  // physical base and attributes of block
+  uint64_t base = LD_PHYSICAL_SECTION_L2_ADDRESS( entry->raw );
+  uint64_t attributes = entry->raw & LD_ATTRIBUTE_MASK;
+  // get new table
+  uint64_t tbl = get_new_table();
+  ld_page_table_t* table = ( ld_page_table_t* )virt_pool_virtual( tbl );
 
   // debug output
   #if defined( PRINT_MM_VIRT )
-    DEBUG_OUTPUT( "create long descriptor table for address %p\r\n",
-      ( void* )addr );
-    DEBUG_OUTPUT( "pmd_idx = %u, tbl_idx = %u\r\n", pmd_idx, tbl_idx );
+    DEBUG_OUTPUT( "split block %#016llx into table %#016llx\r\n",
+      entry->raw, tbl );
   #endif
 
+  // fill table with pages covering the block
+  for ( uint32_t idx = 0; idx < LD_TABLE_ENTRIES; idx++ ) {
+    table->page[ idx ].raw = ( base + idx * PAGE_SIZE ) | attributes;
+    table->page[ idx ].data.type = LD_TYPE_PAGE;
+  }
+  // push table to table walk
+  cache_clean_table( ( uintptr_t )table, PAGE_SIZE );
+
+  // replace block by table, tlb entry of the block is dropped by the caller
+  entry->raw = LD_PHYSICAL_TABLE_ADDRESS( tbl );
+  entry->data.type = LD_TYPE_TABLE;
+  // push entry to table walk
+  cache_clean_table( ( uintptr_t )entry, sizeof( ld_context_table_level2_t ) );
+}
+
+/**
+ * @brief Helper to get middle directory of an address
+ *
+ * @param ctx context to get middle directory for
+ * @param addr address the middle directory is necessary for
+ * @return ld_middle_page_directory* permanently mapped middle directory
+ */
+static ld_middle_page_directory* get_middle_directory(
+  virt_context_ptr_t ctx,
+  uintptr_t addr
+) {
+  // get pmd idx
+  uint32_t pmd_idx = LD_VIRTUAL_PMD_INDEX( addr );
+
   // get context
   ld_global_page_directory_t* context = ( ld_global_page_directory_t* )
-    map_temporary( ctx->context, PAGE_SIZE );
+    virt_pool_virtual( ctx->context );
 
   // debug output
   #if defined( PRINT_MM_VIRT )
@@ -460,6 +493,8 @@ uint64_t v7_long_create_table(
       ctx->type == VIRT_CONTEXT_TYPE_USER ? 1 : 0
     );
     pmd_tbl->data.type = LD_TYPE_TABLE;
+    // push entry to table walk
+    cache_clean_table( ( uintptr_t )pmd_tbl, sizeof( ld_context_table_level1_t ) );
     // debug output
     #if defined( PRINT_MM_VIRT )
       DEBUG_OUTPUT( "pmd_tbl->raw = %#016llx\r\n", pmd_tbl->raw );
@@ -468,7 +503,7 @@ uint64_t v7_long_create_table(
 
   // page middle directory
   ld_middle_page_directory* pmd = ( ld_middle_page_directory* )
-    map_temporary( LD_PHYSICAL_TABLE_ADDRESS( pmd_tbl->raw ), PAGE_SIZE );
+    virt_pool_virtual( LD_PHYSICAL_TABLE_ADDRESS( pmd_tbl->raw ) );
 
   // debug output
   #if defined( PRINT_MM_VIRT )
@@ -476,14 +511,51 @@ uint64_t v7_long_create_table(
       ( void* )pmd_tbl, ( void* )pmd );
   #endif
 
+  // return middle directory
+  return pmd;
+}
+
+/**
+ * @brief Internal v7 long descriptor create table function
+ *
+ * @param ctx context to create table for
+ * @param addr address the table is necessary for
+ * @param table page table address
+ * @return uintptr_t address of created and prepared table
+ */
+uint64_t v7_long_create_table(
+  virt_context_ptr_t ctx,
+  uintptr_t addr,
+  __unused uint64_t table
+) {
+  // get table idx
+  uint32_t tbl_idx = LD_VIRTUAL_TABLE_INDEX( addr );
+
+  // debug output
+  #if defined( PRINT_MM_VIRT )
+    DEBUG_OUTPUT( "create long descriptor table for address %p\r\n",
+      ( void* )addr );
+    DEBUG_OUTPUT( "pmd_idx = %u, tbl_idx = %u\r\n",
+      LD_VIRTUAL_PMD_INDEX( addr ), tbl_idx );
+  #endif
+
+  // get middle directory
+  ld_middle_page_directory* pmd = get_middle_directory( ctx, addr );
+
   // get page table
   ld_context_table_level2_t* tbl_tbl = &pmd->table[ tbl_idx ];
+  // replace block mapping by table
+  if ( LD_IS_BLOCK( tbl_tbl->raw ) ) {
+    split_block( tbl_tbl );
+  }
   // create if not yet created
   if ( 0 == tbl_tbl->raw ) {
     // populate level 2 table
     tbl_tbl->raw = LD_PHYSICAL_TABLE_ADDRESS( get_new_table() );
     // set attributes
     tbl_tbl->data.type = LD_TYPE_TABLE;
+    // push entry to table walk
+    cache_clean_table( ( uintptr_t )tbl_tbl, sizeof( ld_context_table_level2_t ) );
     // debug output
     #if defined( PRINT_MM_VIRT )
       DEBUG_OUTPUT( "%#016llx\r\n", tbl_tbl->raw );
@@ -500,76 +572,50 @@ uint64_t v7_long_create_table(
     DEBUG_OUTPUT( "tbl_tbl = %p, tbl = %p\r\n", ( void* )tbl_tbl, ( void* )tbl );
   #endif
 
-  // unmap temporary
-  unmap_temporary( ( uintptr_t )context, PAGE_SIZE );
-  unmap_temporary( ( uintptr_t )pmd, PAGE_SIZE );
-
   // return table
   return ( uintptr_t )tbl;
 }
 
 /**
- * @brief Internal v7 long descriptor mapping function
+ * @brief Helper to build a page descriptor
  *
  * @param ctx pointer to page context
- * @param vaddr pointer to virtual address
- * @param paddr pointer to physical address
+ * @param paddr physical address
  * @param memory memory type
  * @param page page attributes
+ * @return ld_context_page_t built descriptor
  */
-void v7_long_map(
+static ld_context_page_t build_page(
   virt_context_ptr_t ctx,
-  uintptr_t vaddr,
   uint64_t paddr,
   virt_memory_type_t memory,
   uint32_t page
 ) {
-  // determine page index
-  uint32_t page_idx = LD_VIRTUAL_PAGE_INDEX( vaddr );
-  uint64_t table_phys = v7_long_create_table(
-    ctx, vaddr, 0
-  );
-
-  // map temporary
-  ld_page_table_t* table = ( ld_page_table_t* )map_temporary(
-    table_phys, PAGE_SIZE
-  );
-
-  #if defined( PRINT_MM_VIRT )
-    DEBUG_OUTPUT( "table: %p\r\n", ( void* )table );
-  #endif
-
-  // assert existence
-  assert( NULL != table );
-
-  // debug output
-  #if defined( PRINT_MM_VIRT )
-    DEBUG_OUTPUT( "table: %p\r\n", ( void* )table );
-    DEBUG_OUTPUT( "table->page[ %u ] = %#016llx\r\n",
-      page_idx, table->page[ page_idx ].raw );
-  #endif
-
-  // ensure not already mapped
-  assert( 0 == table->page[ page_idx ].raw );
-
-  // debug output
-  #if defined( PRINT_MM_VIRT )
-    DEBUG_OUTPUT( "page physical address = %#016llx\r\n", paddr );
-  #endif
+  ld_context_page_t entry;
 
   // set page
-  table->page[ page_idx ].raw = LD_PHYSICAL_PAGE_ADDRESS( paddr );
+  entry.raw = LD_PHYSICAL_PAGE_ADDRESS( paddr );
 
   // set attributes
-  table->page[ page_idx ].data.type = LD_TYPE_PAGE;
-  table->page[ page_idx ].data.lower_attr_access = 1;
-  table->page[ page_idx ].data.lower_attr_access_permission =
+  entry.data.type = LD_TYPE_PAGE;
+  // user mappings are tagged with the asid of the context
+  entry.data.lower_attr_not_global =
+    VIRT_CONTEXT_TYPE_USER == ctx->type ? 1 : 0;
+  entry.data.lower_attr_access = 1;
+  entry.data.lower_attr_access_permission =
     ( ctx->type == VIRT_CONTEXT_TYPE_KERNEL ) ? 0 : 1;
+  // read only user mapping
+  if (
+    VIRT_CONTEXT_TYPE_USER == ctx->type
+    && page & VIRT_PAGE_TYPE_READ_ONLY
+  ) {
+    entry.data.lower_attr_access_permission = 3;
+  }
   // execute never attribute
   if ( page & VIRT_PAGE_TYPE_EXECUTABLE ) {
-    table->page[ page_idx ].data.upper_attr_execute_never = 0;
+    entry.data.upper_attr_execute_never = 0;
   } else if ( page & VIRT_PAGE_TYPE_NON_EXECUTABLE ) {
-    table->page[ page_idx ].data.upper_attr_execute_never = 1;
+    entry.data.upper_attr_execute_never = 1;
   }
   // handle memory types
   if (
@@ -577,28 +623,238 @@ void v7_long_map(
     || memory == VIRT_MEMORY_TYPE_DEVICE
   ) {
     // mark as outer sharable
-    table->page[ page_idx ].data.lower_attr_shared = 0x1;
+    entry.data.lower_attr_shared = 0x1;
     // set attributes
-    table->page[ page_idx ].data.lower_attr_memory_attribute =
-      memory == VIRT_MEMORY_TYPE_DEVICE_STRONG ? 0 : 1;
+    entry.data.lower_attr_memory_attribute =
+      memory == VIRT_MEMORY_TYPE_DEVICE_STRONG
+        ? LD_MAIR_INDEX_STRONGLY_ORDERED
+        : LD_MAIR_INDEX_DEVICE;
     // set execute never
-    table->page[ page_idx ].data.upper_attr_execute_never = 1;
+    entry.data.upper_attr_execute_never = 1;
   } else {
     // mark as outer sharable
-    table->page[ page_idx ].data.lower_attr_shared = 0x3;
-    table->page[ page_idx ].data.lower_attr_memory_attribute =
-      1 << 2 | ( memory == VIRT_MEMORY_TYPE_NORMAL ? 3 : 1 );
+    entry.data.lower_attr_shared = 0x3;
+    entry.data.lower_attr_memory_attribute =
+      memory == VIRT_MEMORY_TYPE_NORMAL
+        ? LD_MAIR_INDEX_NORMAL
+        : LD_MAIR_INDEX_NORMAL_NC;
   }
 
+  // return built entry
+  return entry;
+}
+
+/**
+ * @brief Helper to fill a page descriptor
+ *
+ * @param entry descriptor to fill
+ * @param ctx pointer to page context
+ * @param paddr physical address
+ * @param memory memory type
+ * @param page page attributes
+ */
+static void fill_page(
+  ld_context_page_t* entry,
+  virt_context_ptr_t ctx,
+  uint64_t paddr,
+  virt_memory_type_t memory,
+  uint32_t page
+) {
+  // ensure not already mapped
+  assert( 0 == entry->raw );
+
   // debug output
   #if defined( PRINT_MM_VIRT )
-    DEBUG_OUTPUT(
-      "table->page[ %u ].data.raw = %#016llx\r\n",
+    DEBUG_OUTPUT( "page physical address = %#016llx\r\n", paddr );
+  #endif
+
+  // set page with attributes
+  *entry = build_page( ctx, paddr, memory, page );
+
+  // push entry to table walk
+  cache_clean_table( ( uintptr_t )entry, sizeof( ld_context_page_t ) );
+
+  // debug output
+  #if defined( PRINT_MM_VIRT )
+    DEBUG_OUTPUT( "entry->raw = %#016llx\r\n", entry->raw );
+  #endif
+}
+
+/**
+ * @brief Helper to map a level 2 block if possible
+ *
+ * @param ctx pointer to page context
+ * @param vaddr virtual address
+ * @param paddr physical address
+ * @param size remaining size to map
+ * @param memory memory type
+ * @param page page attributes
+ * @return size_t mapped size or 0 if not possible
+ */
+static size_t map_block(
+  virt_context_ptr_t ctx,
+  uintptr_t vaddr,
+  uint64_t paddr,
+  size_t size,
+  virt_memory_type_t memory,
+  uint32_t page
+) {
+  // skip if not aligned or too small
+  if (
+    0 != vaddr % LD_SECTION_L2_SIZE
+    || 0 != paddr % LD_SECTION_L2_SIZE
+    || LD_SECTION_L2_SIZE > size
+  ) {
+    return 0;
+  }
+
+  // get block entry
+  ld_middle_page_directory* pmd = get_middle_directory( ctx, vaddr );
+  ld_context_block_level2_t* entry =
+    &pmd->section[ LD_VIRTUAL_TABLE_INDEX( vaddr ) ];
+  // skip if table or mapping is existing
+  if ( 0 != entry->raw ) {
+    return 0;
+  }
+
+  // debug output
+  #if defined( PRINT_MM_VIRT )
+    DEBUG_OUTPUT( "block physical address = %#016llx\r\n", paddr );
+  #endif
+
+  // set block with attributes of page
+  entry->raw = LD_PHYSICAL_SECTION_L2_ADDRESS( paddr )
+    | ( build_page( ctx, paddr, memory, page ).raw & LD_ATTRIBUTE_MASK );
+  entry->data.type = LD_TYPE_SECTION;
+  // push entry to table walk
+  cache_clean_table( ( uintptr_t )entry, sizeof( ld_context_block_level2_t ) );
+
+  // return mapped size
+  return LD_SECTION_L2_SIZE;
+}
+
+/**
+ * @brief Helper to map a range with the largest possible page sizes
+ *
+ * @param ctx pointer to page context
+ * @param vaddr start of virtual range
+ * @param paddr start of physical range, ignored when random is set
+ * @param size size of range, every touched page is mapped
+ * @param memory memory type
+ * @param page page attributes
+ * @param random flag to use a free physical page per entry
+ */
+static void map_range(
+  virt_context_ptr_t ctx,
+  uintptr_t vaddr,
+  uint64_t paddr,
+  size_t size,
+  virt_memory_type_t memory,
+  uint32_t page,
+  bool random
+) {
+  // page aligned start and amount of touched pages
+  uintptr_t addr = vaddr - vaddr % PAGE_SIZE;
+  size_t count = ( size + ( vaddr - addr ) + PAGE_SIZE - 1 ) / PAGE_SIZE;
+  // keep range for flush
+  uintptr_t start = addr;
+  size_t total = count * PAGE_SIZE;
+
+  // page aligned physical start
+  paddr -= paddr % PAGE_SIZE;
+
+  // debug output
+  #if defined( PRINT_MM_VIRT )
+    DEBUG_OUTPUT( "vaddr = %p, size = %#x, count = %u\r\n",
+      ( void* )vaddr, size, count );
+  #endif
+
+  // loop until everything is mapped
+  while ( 0 < count ) {
+    // physically contiguous ranges try blocks first
+    if ( ! random ) {
+      size_t mapped = map_block(
+        ctx, addr, paddr, count * PAGE_SIZE, memory, page );
+      // continue with next address if mapped
+      if ( 0 < mapped ) {
+        addr += mapped;
+        paddr += mapped;
+        count -= mapped / PAGE_SIZE;
+        continue;
+      }
+    }
+
+    // get permanently mapped table for current address
+    ld_page_table_t* table = ( ld_page_table_t* )virt_pool_virtual(
+      v7_long_create_table( ctx, addr, 0 ) );
+    // assert existence
+    assert( NULL != table );
+
+    // fill consecutive entries within this table
+    for (
+      uint32_t page_idx = LD_VIRTUAL_PAGE_INDEX( addr );
+      0 < count && LD_TABLE_ENTRIES > page_idx;
+      ++page_idx, --count, addr += PAGE_SIZE
+    ) {
+      // determine physical address
+      uint64_t phys = paddr;
+      if ( random ) {
+        phys = phys_find_free_page( PAGE_SIZE );
+        // assert
+        assert( 0 != phys );
+      } else {
+        paddr += PAGE_SIZE;
+      }
+      // fill descriptor
+      fill_page( &table->page[ page_idx ], ctx, phys, memory, page );
+    }
+  }
+
+  // flush whole range at once if running
+  virt_flush_range( ctx, start, total );
+}
+
+/**
+ * @brief Internal v7 long descriptor mapping function
+ *
+ * @param ctx pointer to page context
+ * @param vaddr pointer to virtual address
+ * @param paddr pointer to physical address
+ * @param memory memory type
+ * @param page page attributes
+ */
+void v7_long_map(
+  virt_context_ptr_t ctx,
+  uintptr_t vaddr,
+  uint64_t paddr,
+  virt_memory_type_t memory,
+  uint32_t page
+) {
+  // determine page index
+  uint32_t page_idx = LD_VIRTUAL_PAGE_INDEX( vaddr );
+  uint64_t table_phys = v7_long_create_table(
+    ctx, vaddr, 0
+  );
+
+  // get permanently mapped table
+  ld_page_table_t* table = ( ld_page_table_t* )virt_pool_virtual( table_phys );
+
+  #if defined( PRINT_MM_VIRT )
+    DEBUG_OUTPUT( "table: %p\r\n", ( void* )table );
+  #endif
+
+  // assert existence
+  assert( NULL != table );
+
+  // debug output
+  #if defined( PRINT_MM_VIRT )
+    DEBUG_OUTPUT( "table: %p\r\n", ( void* )table );
+    DEBUG_OUTPUT( "table->page[ %u ] = %#016llx\r\n",
       page_idx, table->page[ page_idx ].raw );
   #endif
 
-  // unmap temporary
-  unmap_temporary( ( uintptr_t )table, PAGE_SIZE );
+  // fill descriptor
+  fill_page( &table->page[ page_idx ], ctx, paddr, memory, page );
 
   // debug output
   #if defined( PRINT_MM_VIRT )
@@ -609,6 +865,46 @@ void v7_long_map(
   virt_flush_address( ctx, vaddr );
 }
 
+/**
+ * @brief Internal v7 long descriptor range mapping function
+ *
+ * @param ctx pointer to page context
+ * @param vaddr start of virtual range
+ * @param paddr start of physical range
+ * @param size size of range
+ * @param memory memory type
+ * @param page page attributes
+ */
+void v7_long_map_range(
+  virt_context_ptr_t ctx,
+  uintptr_t vaddr,
+  uint64_t paddr,
+  size_t size,
+  virt_memory_type_t memory,
+  uint32_t page
+) {
+  map_range( ctx, vaddr, paddr, size, memory, page, false );
+}
+
+/**
+ * @brief Internal v7 long descriptor random range mapping function
+ *
+ * @param ctx pointer to page context
+ * @param vaddr start of virtual range
+ * @param size size of range
+ * @param memory memory type
+ * @param page page attributes
+ */
+void v7_long_map_range_random(
+  virt_context_ptr_t ctx,
+  uintptr_t vaddr,
+  size_t size,
+  virt_memory_type_t memory,
+  uint32_t page
+) {
+  map_range( ctx, vaddr, 0, size, memory, page, true );
+}
+
 /**
  * @brief Internal v7 long descriptor mapping function
  *
@@ -616,8 +912,9 @@ void v7_long_map(
  * @param vaddr pointer to virtual address
  * @param memory memory type
  * @param page page attributes
+ * @return bool false when no physical page is available
  */
-void v7_long_map_random(
+bool v7_long_map_random(
   virt_context_ptr_t ctx,
   uintptr_t vaddr,
   virt_memory_type_t memory,
@@ -625,10 +922,13 @@ void v7_long_map_random(
 ) {
   // get physical address
   uint64_t phys = phys_find_free_page( PAGE_SIZE );
-  // assert
-  assert( 0 != phys );
+  // handle out of memory
+  if ( 0 == phys ) {
+    return false;
+  }
   // map it
   v7_long_map( ctx, vaddr, phys, memory, page );
+  return true;
 }
 
 /**
@@ -657,17 +957,13 @@ void v7_long_unmap( virt_context_ptr_t ctx, uintptr_t vaddr, bool free_phys ) {
     ctx, vaddr, 0
   );
 
-  // map table for unmapping temporary
-  ld_page_table_t* table = ( ld_page_table_t* )map_temporary(
-    table_phys, PAGE_SIZE
-  );
+  // get permanently mapped table
+  ld_page_table_t* table = ( ld_page_table_t* )virt_pool_virtual( table_phys );
   // assert existence
   assert( NULL != table );
 
   // ensure mapped
   if ( 0 == table->page[ page_idx ].raw ) {
-    // unmap temporary
-    unmap_temporary( ( uintptr_t )table, PAGE_SIZE );
     // skip unmap
     return;
   }
@@ -681,19 +977,129 @@ void v7_long_unmap( virt_context_ptr_t ctx, uintptr_t vaddr, bool free_phys ) {
 
   // set page table entry as invalid
   table->page[ page_idx ].raw = 0;
+  // push entry to table walk
+  cache_clean_table(
+    ( uintptr_t )&table->page[ page_idx ], sizeof( ld_context_page_t ) );
 
   // free physical page
   if ( true == free_phys ) {
     phys_free_page( page );
   }
 
-  // unmap temporary
-  unmap_temporary( ( uintptr_t )table, PAGE_SIZE );
-
   // flush context if running
   virt_flush_address( ctx, vaddr );
 }
 
+/**
+ * @brief Helper to unmap a completely covered level 2 block
+ *
+ * @param ctx pointer to page context
+ * @param vaddr virtual address
+ * @param size remaining size to unmap
+ * @param free_phys flag to free also physical memory
+ * @return size_t unmapped size or 0 if no block is completely covered
+ */
+static size_t unmap_block(
+  virt_context_ptr_t ctx,
+  uintptr_t vaddr,
+  size_t size,
+  bool free_phys
+) {
+  // get block entry
+  ld_middle_page_directory* pmd = get_middle_directory( ctx, vaddr );
+  ld_context_block_level2_t* entry =
+    &pmd->section[ LD_VIRTUAL_TABLE_INDEX( vaddr ) ];
+
+  // skip if no block, partially covered blocks are split by create table
+  if (
+    ! LD_IS_BLOCK( entry->raw )
+    || 0 != vaddr % LD_SECTION_L2_SIZE
+    || LD_SECTION_L2_SIZE > size
+  ) {
+    return 0;
+  }
+
+  // get physical base
+  uint64_t base = LD_PHYSICAL_SECTION_L2_ADDRESS( entry->raw );
+  // set entry as invalid
+  entry->raw = 0;
+  // push entry to table walk
+  cache_clean_table( ( uintptr_t )entry, sizeof( ld_context_block_level2_t ) );
+
+  // free physical memory
+  if ( true == free_phys ) {
+    phys_free_page_range( base, LD_SECTION_L2_SIZE );
+  }
+
+  // return unmapped size
+  return LD_SECTION_L2_SIZE;
+}
+
+/**
+ * @brief Internal v7 long descriptor range unmapping function
+ *
+ * @param ctx pointer to page context
+ * @param vaddr start of virtual range
+ * @param size size of range, every touched page is unmapped
+ * @param free_phys flag to free also physical memory
+ */
+void v7_long_unmap_range(
+  virt_context_ptr_t ctx,
+  uintptr_t vaddr,
+  size_t size,
+  bool free_phys
+) {
+  // page aligned start and amount of touched pages
+  uintptr_t addr = vaddr - vaddr % PAGE_SIZE;
+  size_t count = ( size + ( vaddr - addr ) + PAGE_SIZE - 1 ) / PAGE_SIZE;
+  // keep range for flush
+  uintptr_t start = addr;
+  size_t total = count * PAGE_SIZE;
+
+  // loop until everything is unmapped
+  while ( 0 < count ) {
+    // remove completely covered blocks without table
+    size_t unmapped = unmap_block( ctx, addr, count * PAGE_SIZE, free_phys );
+    if ( 0 < unmapped ) {
+      addr += unmapped;
+      count -= unmapped / PAGE_SIZE;
+      continue;
+    }
+
+    // get permanently mapped table for current address
+    ld_page_table_t* table = ( ld_page_table_t* )virt_pool_virtual(
+      v7_long_create_table( ctx, addr, 0 ) );
+    // assert existence
+    assert( NULL != table );
+
+    // clear consecutive entries within this table
+    for (
+      uint32_t page_idx = LD_VIRTUAL_PAGE_INDEX( addr );
+      0 < count && LD_TABLE_ENTRIES > page_idx;
+      ++page_idx, --count, addr += PAGE_SIZE
+    ) {
+      // skip not mapped entries
+      if ( 0 == table->page[ page_idx ].raw ) {
+        continue;
+      }
+      // get physical page address
+      uint64_t page = LD_PHYSICAL_PAGE_ADDRESS( table->page[ page_idx ].raw );
+      // set page table entry as invalid
+      table->page[ page_idx ].raw = 0;
+      // push entry to table walk
+      cache_clean_table(
+        ( uintptr_t )&table->page[ page_idx ], sizeof( ld_context_page_t ) );
+      // free physical page
+      if ( true == free_phys ) {
+        phys_free_page( page );
+      }
+    }
+  }
+
+  // flush whole range at once if running
+  virt_flush_range( ctx, start, total );
+}
+
 /**
  * @brief Unmap temporary mapped page again
  *
@@ -730,14 +1136,27 @@ void v7_long_set_context( virt_context_ptr_t ctx ) {
 
   // user context handling
   if ( VIRT_CONTEXT_TYPE_USER == ctx->type ) {
+    // assign asid, complete tlb flush necessary on rollover
+    bool rollover = virt_asid_assign( ctx );
+    // asid is part of ttbr0 in long descriptor format
+    high |= ctx->asid << 16;
     // debug output
     #if defined( PRINT_MM_VIRT )
-      DEBUG_OUTPUT( "TTBR0: %#016llx\r\n", context );
+      DEBUG_OUTPUT( "TTBR0: %#016llx, ASID: %u\r\n", context, ctx->asid );
     #endif
-    // Copy page table address to cp15 ( ttbr0 )
+    // Copy page table address and asid to cp15 ( ttbr0 )
     __asm__ __volatile__(
       "mcrr p15, 0, %0, %1, c2" : : "r" ( low ), "r" ( high ) : "memory"
     );
+    // invalidate entire tlb and branch predictor on rollover
+    if ( rollover ) {
+      __asm__ __volatile__( "mcr p15, 0, %0, c8, c7, 0" : : "r" ( 0 ) );
+      __asm__ __volatile__( "mcr p15, 0, %0, c7, c5, 6" : : "r" ( 0 ) );
+      barrier_data_sync();
+    }
+    barrier_instruction_sync();
+    // overwrite global pointer
+    user_context = ctx;
   // kernel context handling
   } else {
     // debug output
@@ -748,6 +1167,8 @@ void v7_long_set_context( virt_context_ptr_t ctx ) {
     __asm__ __volatile__(
       "mcrr p15, 1, %0, %1, c2" : : "r" ( low ), "r" ( high ) : "memory"
     );
+    // overwrite global pointer
+    kernel_context = ctx;
   }
 }
 
@@ -793,7 +1214,7 @@ void v7_long_flush_complete( void ) {
 /**
  * @brief Flush address in long mode
  *
- * @param addr virtual address to flush
+ * @param addr virtual address to flush, asid within lower bits
  */
 void v7_long_flush_address( uintptr_t addr ) {
   // flush specific address
@@ -804,6 +1225,36 @@ void v7_long_flush_address( uintptr_t addr ) {
   barrier_data_sync();
 }
 
+/**
+ * @brief Flush virtual range in long mode
+ *
+ * @param addr start of virtual range
+ * @param size size of range
+ * @param asid asid of the range or kernel asid for global mappings
+ */
+void v7_long_flush_range( uintptr_t addr, size_t size, uint32_t asid ) {
+  // ensure table updates are visible to the table walk
+  barrier_data_sync();
+  // invalidate by asid or entire tlb for larger ranges
+  if ( VIRT_FLUSH_RANGE_THRESHOLD < size / PAGE_SIZE ) {
+    if ( VIRT_ASID_KERNEL == asid ) {
+      __asm__ __volatile__( "mcr p15, 0, %0, c8, c7, 0" : : "r" ( 0 ) );
+    } else {
+      __asm__ __volatile__( "mcr p15, 0, %0, c8, c7, 2" : : "r" ( asid ) );
+    }
+  } else {
+    // flush each address without intermediate barriers
+    for ( size_t offset = 0; offset < size; offset += PAGE_SIZE ) {
+      __asm__ __volatile__(
+        "mcr p15, 0, %0, c8, c7, 1" :: "r"( ( addr + offset ) | asid ) );
+    }
+  }
+  // data synchronization barrier
+  barrier_data_sync();
+  // instruction synchronization barrier
+  barrier_instruction_sync();
+}
+
 /**
  * @brief Helper to reserve temporary area for mappings
  *
@@ -813,6 +1264,9 @@ void v7_long_prepare_temporary( virt_context_ptr_t ctx ) {
   // ensure kernel for temporary
   assert( VIRT_CONTEXT_TYPE_KERNEL == ctx->type );
 
+  // create tables for permanent page table window
+  virt_pool_prepare( ctx );
+
   // last physical table address
   uint64_t table_physical = 0;
   mapped_temporary_tables = 0;
@@ -833,7 +1287,7 @@ void v7_long_prepare_temporary( virt_context_ptr_t ctx ) {
         ctx,
         table_virtual,
         table,
-        VIRT_MEMORY_TYPE_NORMAL_NC,
+        VIRT_MEMORY_TYPE_NORMAL,
         VIRT_PAGE_TYPE_NON_EXECUTABLE
       );
       // debug output
@@ -861,27 +1315,14 @@ void v7_long_prepare_temporary( virt_context_ptr_t ctx ) {
  * @param type context type to create
  */
 virt_context_ptr_t v7_long_create_context( virt_context_type_t type ) {
-  // create new context
-  uint64_t ctx;
-  if ( ! virt_init_get() ) {
-    ctx = ( uint64_t )(
-      ( uintptr_t )VIRT_2_PHYS( aligned_alloc( PAGE_SIZE, PAGE_SIZE ) ) );
-  } else {
-    ctx = phys_find_free_page_range( PAGE_SIZE, PAGE_SIZE );
-  }
+  // create new cleared context within page table pool
+  uint64_t ctx = virt_pool_allocate( PAGE_SIZE, PAGE_SIZE );
 
   // debug output
   #if defined( PRINT_MM_VIRT )
     DEBUG_OUTPUT( "type: %d, ctx: %#016llx\r\n", type, ctx );
   #endif
 
-  // map temporary
-  uintptr_t tmp = map_temporary( ctx, PAGE_SIZE );
-  // initialize with zero
-  memset( ( void* )tmp, 0, PAGE_SIZE );
-  // unmap temporary
-  unmap_temporary( tmp, PAGE_SIZE );
-
   // create new context structure for return
   virt_context_ptr_t context = ( virt_context_ptr_t )malloc(
     sizeof( virt_context_t )
@@ -922,13 +1363,13 @@ void v7_long_prepare( void ) {
   // populate mair0
   uint32_t mair0 =
     // device nGnRnE / strongly ordered
-    0x00u << 0
+    0x00u << ( LD_MAIR_INDEX_STRONGLY_ORDERED * 8 )
     // device nGnRE
-    | 0x04u << 8
+    | 0x04u << ( LD_MAIR_INDEX_DEVICE * 8 )
     // normal non cachable
-    | 0x44u << 16
-    // normal
-    | 0xffu << 24;
+    | 0x44u << ( LD_MAIR_INDEX_NORMAL_NC * 8 )
+    // normal inner / outer write back write allocate
+    | 0xffu << ( LD_MAIR_INDEX_NORMAL * 8 );
   // populate memory
   __asm__ __volatile__(
     "mcr p15, 0, %0, c10, c2, 0"
@@ -954,12 +1395,17 @@ bool v7_long_is_mapped_in_context( virt_context_ptr_t ctx, uintptr_t addr ) {
   uint32_t page_idx = LD_VIRTUAL_PAGE_INDEX( addr );
   bool mapped = false;
 
+  // blocks are mapped without page table
+  ld_middle_page_directory* pmd = get_middle_directory( ctx, addr );
+  if ( LD_IS_BLOCK( pmd->raw[ LD_VIRTUAL_TABLE_INDEX( addr ) ] ) ) {
+    return true;
+  }
+
   // determine page index
   uint64_t table_phys = v7_long_create_table( ctx, addr, 0 );
 
-  // map temporary
-  ld_page_table_t* table = ( ld_page_table_t* )map_temporary(
-    table_phys, PAGE_SIZE );
+  // get permanently mapped table
+  ld_page_table_t* table = ( ld_page_table_t* )virt_pool_virtual( table_phys );
 
   // debug output
   #if defined( PRINT_MM_VIRT )
@@ -981,9 +1427,74 @@ bool v7_long_is_mapped_in_context( virt_context_ptr_t ctx, uintptr_t addr ) {
     mapped = true;
   }
 
-  // unmap temporary
-  unmap_temporary( ( uintptr_t )table, PAGE_SIZE );
-
   // return flag
   return mapped;
 }
+
+/**
+ * @brief Checks whether address is mapped writable
+ *
+ * @param ctx
+ * @param addr
+ * @return true if mapped and writable
+ * @return false if not mapped or read only
+ */
+bool v7_long_is_writable_in_context( virt_context_ptr_t ctx, uintptr_t addr ) {
+  // blocks are mapped without page table
+  ld_middle_page_directory* pmd = get_middle_directory( ctx, addr );
+  uint64_t entry = pmd->raw[ LD_VIRTUAL_TABLE_INDEX( addr ) ];
+  if ( LD_IS_BLOCK( entry ) ) {
+    return ! LD_IS_READ_ONLY( entry );
+  }
+
+  // get permanently mapped table
+  ld_page_table_t* table = ( ld_page_table_t* )virt_pool_virtual(
+    v7_long_create_table( ctx, addr, 0 ) );
+  // assert existence
+  assert( NULL != table );
+
+  // get entry and check access permission
+  entry = table->page[ LD_VIRTUAL_PAGE_INDEX( addr ) ].raw;
+  return 0 != entry && ! LD_IS_READ_ONLY( entry );
+}
+
+/**
+ * @brief Get physical address of a mapped virtual address
+ *
+ * @param ctx
+ * @param addr
+ * @return uint64_t
+ */
+uint64_t v7_long_get_mapped_address_in_context(
+  virt_context_ptr_t ctx,
+  uintptr_t addr
+) {
+  // get page index
+  uint32_t page_idx = LD_VIRTUAL_PAGE_INDEX( addr );
+
+  // blocks are mapped without page table
+  ld_middle_page_directory* pmd = get_middle_directory( ctx, addr );
+  uint64_t entry = pmd->raw[ LD_VIRTUAL_TABLE_INDEX( addr ) ];
+  if ( LD_IS_BLOCK( entry ) ) {
+    return ( entry & ~LD_ATTRIBUTE_MASK & ~( uint64_t )( LD_SECTION_L2_SIZE - 1 ) )
+      | ( addr & ( LD_SECTION_L2_SIZE - 1 ) );
+  }
+
+  // get permanently mapped table
+  ld_page_table_t* table = ( ld_page_table_t* )virt_pool_virtual(
+    v7_long_create_table( ctx, addr, 0 ) );
+  // assert existence
+  assert( NULL != table );
+
+  // get entry and assert mapping
+  entry = table->page[ page_idx ].raw;
+  assert( 0 != entry );
+
+  // debug output
+  #if defined( PRINT_MM_VIRT )
+    DEBUG_OUTPUT( "table->page[ %u ].raw = %#016llx\r\n", page_idx, entry );
+  #endif
+
+  // page base address
+  return ( entry & ~LD_ATTRIBUTE_MASK ) | ( addr & 0xFFF );
+}
@@ -26,10 +26,12 @@
 #include <core/entry.h>
 #include <core/debug/debug.h>
 #include <arch/arm/barrier.h>
-#include <arch/arm/v7/cache.h>
+#include <arch/arm/cache.h>
 #include <core/mm/phys.h>
 #include <core/mm/heap.h>
 #include <arch/arm/mm/virt/short.h>
+#include <arch/arm/mm/virt/pool.h>
+#include <arch/arm/mm/virt/asid.h>
 #include <arch/arm/v7/mm/virt/short.h>
 #include <core/mm/virt.h>
 
@@ -43,6 +45,12 @@
  */
 #define TEMPORARY_SPACE_SIZE 0xFFFFFF
 
+/**
+ * @brief Size of page tables covering temporary space
+ */
+#define TEMPORARY_SPACE_TABLE_SIZE \
+  ( ( ( TEMPORARY_SPACE_SIZE + 1 ) >> 20 ) * SD_TBL_SIZE )
+
 /**
  * @brief Initial context
  */
@@ -202,7 +210,7 @@ static uintptr_t map_temporary( uintptr_t start, size_t size ) {
   // Find free area
   for (
     uintptr_t table = TEMPORARY_SPACE_START;
-    table < TEMPORARY_SPACE_START + PAGE_SIZE && !stop;
+    table < TEMPORARY_SPACE_START + TEMPORARY_SPACE_TABLE_SIZE && !stop;
     table += SD_TBL_SIZE, ++current_table
   ) {
     // get table
@@ -264,20 +272,24 @@ static uintptr_t map_temporary( uintptr_t start, size_t size ) {
       DEBUG_OUTPUT( "tbl = %p\r\n", ( void* )tbl );
     #endif
 
-    // map it non cacheable
+    // map it write back cacheable like all other normal memory
     tbl->page[ page_idx ].raw = start & 0xFFFFF000;
 
     // set attributes
     tbl->page[ page_idx ].data.type = SD_TBL_SMALL_PAGE;
-    tbl->page[ page_idx ].data.bufferable = 0;
-    tbl->page[ page_idx ].data.cacheable = 0;
+    tbl->page[ page_idx ].data.tex = 1;
+    tbl->page[ page_idx ].data.bufferable = 1;
+    tbl->page[ page_idx ].data.cacheable = 1;
     tbl->page[ page_idx ].data.access_permision_0 = SD_MAC_APX0_PRIVILEGED_RW;
+    // push entry to table walk
+    cache_clean_table(
+      ( uintptr_t )&tbl->page[ page_idx ], sizeof( sd_page_small_t ) );
 
     // flush address
     virt_flush_address( kernel_context, addr );
 
     // increase physical address
-    start += i * PAGE_SIZE;
+    start += PAGE_SIZE;
   }
 
   // debug putput
@@ -325,6 +337,10 @@ static void unmap_temporary( uintptr_t addr, size_t size ) {
   // calculate end
   uintptr_t end = addr + page_amount * PAGE_SIZE;
 
+  // write back data, e.g. loaded code, and drop stale instructions
+  cache_clean_range( addr, page_amount * PAGE_SIZE );
+  cache_invalidate_instruction_cache();
+
   // debug putput
   #if defined( PRINT_MM_VIRT )
     DEBUG_OUTPUT( "end = %p\r\n", ( void* )end );
@@ -342,6 +358,9 @@ static void unmap_temporary( uintptr_t addr, size_t size ) {
 
     // unmap
     tbl->page[ page_idx ].raw = 0;
+    // push entry to table walk
+    cache_clean_table(
+      ( uintptr_t )&tbl->page[ page_idx ], sizeof( sd_page_small_t ) );
 
     // flush address
     virt_flush_address( kernel_context, addr );
@@ -363,14 +382,8 @@ static uintptr_t get_new_table( void ) {
 
   // fill addr and remaining
   if ( 0 == addr ) {
-    // allocate page
-    addr = ( uintptr_t )phys_find_free_page( SD_TBL_SIZE );
-    // map temporarily
-    uintptr_t tmp = map_temporary( addr, PAGE_SIZE );
-    // overwrite page with zero
-    memset( ( void* )tmp, 0, PAGE_SIZE );
-    // unmap page again
-    unmap_temporary( tmp, PAGE_SIZE );
+    // allocate already cleared page from page table pool
+    addr = ( uintptr_t )virt_pool_allocate( PAGE_SIZE, PAGE_SIZE );
 
     // set remaining size
     remaining = PAGE_SIZE;
@@ -402,6 +415,111 @@ static uintptr_t get_new_table( void ) {
   return r;
 }
 
+/**
+ * @brief Helper to replace a large page by 16 small pages
+ *
+ * @param entry first entry of the large page
+ */
+static void split_large_page( sd_page_small_t* entry ) {
+  sd_page_large_t large = { .raw = entry->raw };
+  sd_page_small_t small;
+
+  // translate attributes of large page
+  small.raw = large.raw & 0xFFFF0000;
+  small.data.type = SD_TBL_SMALL_PAGE;
+  small.data.bufferable = large.data.bufferable;
+  small.data.cacheable = large.data.cacheable;
+  small.data.access_permision_0 = large.data.access_permision_0;
+  small.data.access_permision_1 = large.data.access_permision_1;
+  small.data.shareable = large.data.shareable;
+  small.data.not_global = large.data.not_global;
+  small.data.tex = large.data.tex;
+  small.data.execute_never = large.data.execute_never;
+
+  // set small pages, tlb entry of the large page is dropped by the caller
+  for ( uint32_t idx = 0; idx < SD_LARGE_PAGE_ENTRIES; idx++ ) {
+    entry[ idx ].raw = small.raw + idx * SD_PAGE_SIZE;
+  }
+
+  // push entries to table walk
+  cache_clean_table(
+    ( uintptr_t )entry, SD_LARGE_PAGE_ENTRIES * sizeof( sd_page_small_t ) );
+}
+
+/**
+ * @brief Helper to replace a section by a page table with small pages
+ *
+ * @param ctx pointer to page context
+ * @param table_idx first level index of the section
+ */
+static void split_section( virt_context_ptr_t ctx, uint32_t table_idx ) {
+  // get context, user contexts cover only the lower half
+  sd_context_total_t* context = ( sd_context_total_t* )virt_pool_virtual(
+    ctx->context );
+
+  // split supersection into sections first
+  if ( SD_TTBR_IS_SUPER_SECTION( context->raw[ table_idx ] ) ) {
+    // first entry and physical base of supersection
+    uint32_t first = table_idx - table_idx % SD_SUPER_SECTION_ENTRIES;
+    uint32_t base = context->raw[ first ] & 0xFF000000;
+    // build section out of supersection
+    sd_context_section_t section = { .raw = context->raw[ first ] };
+    section.data.sbz = 0;
+    section.data.domain = SD_DOMAIN_CLIENT;
+    section.raw &= 0xFFFFF;
+
+    // set sections
+    for ( uint32_t idx = 0; idx < SD_SUPER_SECTION_ENTRIES; idx++ ) {
+      context->raw[ first + idx ] = section.raw | ( base + idx * SD_SECTION_SIZE );
+    }
+    // push entries to table walk
+    cache_clean_table( ( uintptr_t )&context->raw[ first ],
+      SD_SUPER_SECTION_ENTRIES * sizeof( sd_context_section_t ) );
+  }
+
+  // get section
+  sd_context_section_t section = context->section[ table_idx ];
+  // get new table
+  uintptr_t tbl = get_new_table();
+  sd_page_table_t* table = ( sd_page_table_t* )virt_pool_virtual( tbl );
+
+  // debug output
+  #if defined( PRINT_MM_VIRT )
+    DEBUG_OUTPUT( "split section %#08x into table %p\r\n",
+      section.raw, ( void* )tbl );
+  #endif
+
+  // translate attributes of section
+  sd_page_small_t small;
+  small.raw = section.raw & 0xFFF00000;
+  small.data.type = SD_TBL_SMALL_PAGE;
+  small.data.bufferable = section.data.bufferable;
+  small.data.cacheable = section.data.cacheable;
+  small.data.access_permision_0 = section.data.access_permision_0;
+  small.data.access_permision_1 = section.data.access_permision_1;
+  small.data.shareable = section.data.shareable;
+  small.data.not_global = section.data.not_global;
+  small.data.tex = section.data.tex;
+  small.data.execute_never = section.data.execute_never;
+
+  // fill table with small pages covering the section
+  for ( uint32_t idx = 0; idx < 256; idx++ ) {
+    table->page[ idx ].raw = small.raw + idx * SD_PAGE_SIZE;
+  }
+  // push table to table walk
+  cache_clean_table( ( uintptr_t )table, SD_TBL_SIZE );
+
+  // replace section by table, tlb entry of the section is dropped by the caller
+  context->table[ table_idx ].raw = ( uint32_t )tbl & 0xFFFFFC00;
+  context->table[ table_idx ].data.type = SD_TTBR_TYPE_PAGE_TABLE;
+  context->table[ table_idx ].data.domain = SD_DOMAIN_CLIENT;
+  context->table[ table_idx ].data.non_secure =
+    VIRT_CONTEXT_TYPE_USER == ctx->type ? 1 : 0;
+  // push entry to table walk
+  cache_clean_table(
+    ( uintptr_t )&context->table[ table_idx ], sizeof( sd_context_table_t ) );
+}
+
 /**
  * @brief Internal v7 short descriptor create table function
  *
@@ -426,10 +544,15 @@ uint64_t v7_short_create_table(
   // kernel context
   if ( VIRT_CONTEXT_TYPE_KERNEL == ctx->type ) {
     // get context
-    sd_context_total_t* context = ( sd_context_total_t* )map_temporary(
-      ( uintptr_t )ctx->context, SD_TTBR_SIZE_4G
+    sd_context_total_t* context = ( sd_context_total_t* )virt_pool_virtual(
+      ctx->context
     );
 
+    // replace section mapping by page table
+    if ( SD_TTBR_IS_SECTION( context->raw[ table_idx ] ) ) {
+      split_section( ctx, table_idx );
+    }
+
     // check for already existing
     if ( 0 != context->table[ table_idx ].raw ) {
       // debug output
@@ -438,14 +561,8 @@ uint64_t v7_short_create_table(
           table_idx, context->table[ table_idx ].raw );
       #endif
 
-      // return object
-      uintptr_t ret = context->table[ table_idx ].raw & 0xFFFFFC00;
-
-      // unmap temporary
-      unmap_temporary( ( uintptr_t )context, SD_TTBR_SIZE_4G );
-
       // return table address
-      return ret;
+      return context->table[ table_idx ].raw & 0xFFFFFC00;
     }
 
     // create table if necessary
@@ -468,6 +585,9 @@ uint64_t v7_short_create_table(
     context->table[ table_idx ].data.type = SD_TTBR_TYPE_PAGE_TABLE;
     context->table[ table_idx ].data.domain = SD_DOMAIN_CLIENT;
     context->table[ table_idx ].data.non_secure = 0;
+    // push entry to table walk
+    cache_clean_table(
+      ( uintptr_t )&context->table[ table_idx ], sizeof( sd_context_table_t ) );
 
     // debug output
     #if defined( PRINT_MM_VIRT )
@@ -475,9 +595,6 @@ uint64_t v7_short_create_table(
         table_idx, context->table[ table_idx ].raw );
     #endif
 
-    // unmap temporary
-    unmap_temporary( ( uintptr_t )context, SD_TTBR_SIZE_4G );
-
     // return created table
     return tbl;
   }
@@ -485,10 +602,15 @@ uint64_t v7_short_create_table(
   // user context
   if ( VIRT_CONTEXT_TYPE_USER == ctx->type ) {
     // get context
-    sd_context_half_t* context = ( sd_context_half_t* )map_temporary(
-      ( uintptr_t )ctx->context, SD_TTBR_SIZE_2G
+    sd_context_half_t* context = ( sd_context_half_t* )virt_pool_virtual(
+      ctx->context
     );
 
+    // replace section mapping by page table
+    if ( SD_TTBR_IS_SECTION( context->raw[ table_idx ] ) ) {
+      split_section( ctx, table_idx );
+    }
+
     // check for already existing
     if ( 0 != context->table[ table_idx ].raw ) {
       // debug output
@@ -497,14 +619,8 @@ uint64_t v7_short_create_table(
           table_idx, context->table[ table_idx ].raw );
       #endif
 
-      // return object
-      uintptr_t ret = context->table[ table_idx ].raw  & 0xFFFFFC00;
-
-      // unmap temporary
-      unmap_temporary( ( uintptr_t )context, SD_TTBR_SIZE_4G );
-
       // return table address
-      return ret;
+      return context->table[ table_idx ].raw & 0xFFFFFC00;
     }
 
     // create table if necessary
@@ -524,6 +640,9 @@ uint64_t v7_short_create_table(
     context->table[ table_idx ].data.type = SD_TTBR_TYPE_PAGE_TABLE;
     context->table[ table_idx ].data.domain = SD_DOMAIN_CLIENT;
     context->table[ table_idx ].data.non_secure = 1;
+    // push entry to table walk
+    cache_clean_table(
+      ( uintptr_t )&context->table[ table_idx ], sizeof( sd_context_table_t ) );
 
     // debug output
     #if defined( PRINT_MM_VIRT )
@@ -531,9 +650,6 @@ uint64_t v7_short_create_table(
         table_idx, context->table[ table_idx ].raw );
     #endif
 
-    // unmap temporary
-    unmap_temporary( ( uintptr_t )context, SD_TTBR_SIZE_4G );
-
     // return table address
     return tbl;
   }
@@ -543,70 +659,46 @@ uint64_t v7_short_create_table(
 }
 
 /**
- * @brief Internal v7 short descriptor mapping function
+ * @brief Helper to build a small page descriptor
  *
  * @param ctx pointer to page context
- * @param vaddr pointer to virtual address
- * @param paddr pointer to physical address
+ * @param paddr physical address
  * @param memory memory type
  * @param page page attributes
+ * @return sd_page_small_t built descriptor
  */
-void v7_short_map(
+static sd_page_small_t build_small_page(
   virt_context_ptr_t ctx,
-  uintptr_t vaddr,
   uint64_t paddr,
   virt_memory_type_t memory,
   uint32_t page
 ) {
-  // get page index
-  uint32_t page_idx = SD_VIRTUAL_PAGE_INDEX( vaddr );
-
-  // get table for mapping
-  sd_page_table_t* table = ( sd_page_table_t* )(
-    ( uintptr_t )v7_short_create_table(
-      ctx, vaddr, 0
-    )
-  );
-
-  #if defined( PRINT_MM_VIRT )
-    DEBUG_OUTPUT( "table: %p\r\n", ( void* )table );
-  #endif
-
-  // map temporary
-  table = ( sd_page_table_t* )map_temporary( ( uintptr_t )table, SD_TBL_SIZE );
-
-  // assert existence
-  assert( NULL != table );
-
-  // debug output
-  #if defined( PRINT_MM_VIRT )
-    DEBUG_OUTPUT( "table: %p\r\n", ( void* )table );
-    DEBUG_OUTPUT( "table->page[ %u ].raw = %#08x\r\n",
-      page_idx, table->page[ page_idx ].raw );
-  #endif
-
-  // ensure not already mapped
-  assert( 0 == table->page[ page_idx ].raw );
-
-  // debug output
-  #if defined( PRINT_MM_VIRT )
-    DEBUG_OUTPUT( "page physical address = %#016llx\r\n", paddr );
-  #endif
+  sd_page_small_t entry;
 
   // set page
-  table->page[ page_idx ].raw = paddr & 0xFFFFF000;
+  entry.raw = ( uint32_t )paddr & 0xFFFFF000;
 
   // set attributes
-  table->page[ page_idx ].data.type = SD_TBL_SMALL_PAGE;
-  table->page[ page_idx ].data.access_permision_0 =
+  entry.data.type = SD_TBL_SMALL_PAGE;
+  // user mappings are tagged with the asid of the context
+  entry.data.not_global = VIRT_CONTEXT_TYPE_USER == ctx->type ? 1 : 0;
+  entry.data.access_permision_0 =
     ( VIRT_CONTEXT_TYPE_KERNEL == ctx->type )
       ? SD_MAC_APX0_PRIVILEGED_RW
       : SD_MAC_APX0_FULL_RW;
+  // read only user mapping
+  if (
+    VIRT_CONTEXT_TYPE_USER == ctx->type
+    && page & VIRT_PAGE_TYPE_READ_ONLY
+  ) {
+    entry.data.access_permision_1 = 1;
+    entry.data.access_permision_0 = SD_MAC_APX1_FULL_RO;
+  }
   // execute never attribute
   if ( page & VIRT_PAGE_TYPE_EXECUTABLE ) {
-    table->page[ page_idx ].data.execute_never = 0;
+    entry.data.execute_never = 0;
   } else if ( page & VIRT_PAGE_TYPE_NON_EXECUTABLE ) {
-    table->page[ page_idx ].data.execute_never = 1;
+    entry.data.execute_never = 1;
   }
   // handle memory types
   if (
@@ -614,36 +706,435 @@ void v7_short_map(
     || memory == VIRT_MEMORY_TYPE_DEVICE
   ) {
     // set cacheable and bufferable to 0
-    table->page[ page_idx ].data.cacheable = 0;
-    table->page[ page_idx ].data.bufferable = 0;
+    entry.data.cacheable = 0;
+    entry.data.bufferable = 0;
     // set tex depending on type
-    table->page[ page_idx ].data.tex =
-      memory == VIRT_MEMORY_TYPE_DEVICE_STRONG ? 0 : 2;
+    entry.data.tex = memory == VIRT_MEMORY_TYPE_DEVICE_STRONG ? 0 : 2;
     // overwrite execute never
-    table->page[ page_idx ].data.execute_never = 1;
+    entry.data.execute_never = 1;
   } else {
     // set cacheable and bufferable depending on type
-    table->page[ page_idx ].data.cacheable =
-      memory == VIRT_MEMORY_TYPE_NORMAL ? 1 : 0;
-    table->page[ page_idx ].data.bufferable =
-      memory == VIRT_MEMORY_TYPE_NORMAL ? 1 : 0;
+    entry.data.cacheable = memory == VIRT_MEMORY_TYPE_NORMAL ? 1 : 0;
+    entry.data.bufferable = memory == VIRT_MEMORY_TYPE_NORMAL ? 1 : 0;
     // set tex
-    table->page[ page_idx ].data.tex = 1;
+    entry.data.tex = 1;
+  }
+
+  // return built entry
+  return entry;
+}
+
+/**
+ * @brief Helper to fill a small page descriptor
+ *
+ * @param entry descriptor to fill
+ * @param ctx pointer to page context
+ * @param paddr physical address
+ * @param memory memory type
+ * @param page page attributes
+ */
+static void fill_small_page(
+  sd_page_small_t* entry,
+  virt_context_ptr_t ctx,
+  uint64_t paddr,
+  virt_memory_type_t memory,
+  uint32_t page
+) {
+  // ensure not already mapped
+  assert( 0 == entry->raw );
+
+  // debug output
+  #if defined( PRINT_MM_VIRT )
+    DEBUG_OUTPUT( "page physical address = %#016llx\r\n", paddr );
+  #endif
+
+  // set page with attributes
+  *entry = build_small_page( ctx, paddr, memory, page );
+
+  // push entry to table walk
+  cache_clean_table( ( uintptr_t )entry, sizeof( sd_page_small_t ) );
+
+  // debug output
+  #if defined( PRINT_MM_VIRT )
+    DEBUG_OUTPUT( "entry->raw = %#08x\r\n", entry->raw );
+  #endif
+}
+
+/**
+ * @brief Helper to fill a large page, which occupies 16 consecutive entries
+ *
+ * @param entry first of the descriptors to fill
+ * @param ctx pointer to page context
+ * @param paddr physical address aligned to large page size
+ * @param memory memory type
+ * @param page page attributes
+ */
+static void fill_large_page(
+  sd_page_small_t* entry,
+  virt_context_ptr_t ctx,
+  uint64_t paddr,
+  virt_memory_type_t memory,
+  uint32_t page
+) {
+  sd_page_small_t small = build_small_page( ctx, paddr, memory, page );
+  sd_page_large_t large;
+
+  // debug output
+  #if defined( PRINT_MM_VIRT )
+    DEBUG_OUTPUT( "large page physical address = %#016llx\r\n", paddr );
+  #endif
+
+  // translate attributes of small page
+  large.raw = ( uint32_t )paddr & 0xFFFF0000;
+  large.data.type = 1;
+  large.data.bufferable = small.data.bufferable;
+  large.data.cacheable = small.data.cacheable;
+  large.data.access_permision_0 = small.data.access_permision_0;
+  large.data.access_permision_1 = small.data.access_permision_1;
+  large.data.shareable = small.data.shareable;
+  large.data.not_global = small.data.not_global;
+  large.data.tex = small.data.tex;
+  large.data.execute_never = small.data.execute_never;
+
+  // large page descriptor is repeated within all covered entries
+  for ( uint32_t idx = 0; idx < SD_LARGE_PAGE_ENTRIES; idx++ ) {
+    // ensure not already mapped
+    assert( 0 == entry[ idx ].raw );
+    // set entry
+    entry[ idx ].raw = large.raw;
+  }
+
+  // push entries to table walk
+  cache_clean_table(
+    ( uintptr_t )entry, SD_LARGE_PAGE_ENTRIES * sizeof( sd_page_small_t ) );
+}
+
+/**
+ * @brief Helper to fill a section or supersection
+ *
+ * @param entry first of the first level descriptors to fill
+ * @param ctx pointer to page context
+ * @param paddr physical address aligned to section or supersection size
+ * @param memory memory type
+ * @param page page attributes
+ * @param super flag to fill a supersection occupying 16 entries
+ */
+static void fill_section(
+  sd_context_section_t* entry,
+  virt_context_ptr_t ctx,
+  uint64_t paddr,
+  virt_memory_type_t memory,
+  uint32_t page,
+  bool super
+) {
+  sd_page_small_t small = build_small_page( ctx, paddr, memory, page );
+  sd_context_section_t section;
+  uint32_t amount = super ? SD_SUPER_SECTION_ENTRIES : 1;
+
+  // debug output
+  #if defined( PRINT_MM_VIRT )
+    DEBUG_OUTPUT( "section physical address = %#016llx, super = %d\r\n",
+      paddr, super );
+  #endif
+
+  // translate attributes of small page
+  section.raw = ( uint32_t )paddr & 0xFFF00000;
+  section.data.type = 1;
+  section.data.bufferable = small.data.bufferable;
+  section.data.cacheable = small.data.cacheable;
+  section.data.execute_never = small.data.execute_never;
+  section.data.access_permision_0 = small.data.access_permision_0;
+  section.data.access_permision_1 = small.data.access_permision_1;
+  section.data.tex = small.data.tex;
+  section.data.shareable = small.data.shareable;
+  section.data.not_global = small.data.not_global;
+  section.data.non_secure = VIRT_CONTEXT_TYPE_USER == ctx->type ? 1 : 0;
+  // supersections are always within domain 0 and flagged by bit 18
+  if ( super ) {
+    section.raw &= 0xFF000000 | 0xFFFFF;
+    section.data.sbz = 1;
+  } else {
+    section.data.domain = SD_DOMAIN_CLIENT;
+  }
+
+  // supersection descriptor is repeated within all covered entries
+  for ( uint32_t idx = 0; idx < amount; idx++ ) {
+    // ensure not already mapped
+    assert( 0 == entry[ idx ].raw );
+    // set entry
+    entry[ idx ].raw = section.raw;
+  }
+
+  // push entries to table walk
+  cache_clean_table(
+    ( uintptr_t )entry, amount * sizeof( sd_context_section_t ) );
+}
+
+/**
+ * @brief Helper to check whether a section or supersection fits
+ *
+ * @param context first level table, user contexts cover only the lower half
+ * @param vaddr virtual address
+ * @param paddr physical address
+ * @param size remaining size to map
+ * @param super flag to check for supersection
+ * @return true if aligned, large enough and not yet mapped
+ */
+static bool section_fits(
+  sd_context_total_t* context,
+  uintptr_t vaddr,
+  uint64_t paddr,
+  size_t size,
+  bool super
+) {
+  size_t section_size = super ? SD_SUPER_SECTION_SIZE : SD_SECTION_SIZE;
+  uint32_t amount = super ? SD_SUPER_SECTION_ENTRIES : 1;
+  uint32_t table_idx = SD_VIRTUAL_TABLE_INDEX( vaddr );
+
+  // skip if not aligned, too small or above 32 bit physical address space
+  if (
+    0 != vaddr % section_size
+    || 0 != paddr % section_size
+    || section_size > size
+    || 0x100000000ULL < paddr + section_size
+  ) {
+    return false;
+  }
+
+  // ensure neither table nor mapping is existing
+  for ( uint32_t idx = 0; idx < amount; idx++ ) {
+    if ( 0 != context->raw[ table_idx + idx ] ) {
+      return false;
+    }
+  }
+
+  // section fits
+  return true;
+}
+
+/**
+ * @brief Helper to map a section or supersection if possible
+ *
+ * @param ctx pointer to page context
+ * @param vaddr virtual address
+ * @param paddr physical address
+ * @param size remaining size to map
+ * @param memory memory type
+ * @param page page attributes
+ * @return size_t mapped size or 0 if not possible
+ */
+static size_t map_section(
+  virt_context_ptr_t ctx,
+  uintptr_t vaddr,
+  uint64_t paddr,
+  size_t size,
+  virt_memory_type_t memory,
+  uint32_t page
+) {
+  // get context, user contexts cover only the lower half
+  sd_context_total_t* context = ( sd_context_total_t* )virt_pool_virtual(
+    ctx->context );
+
+  // prefer supersection over section
+  bool super = section_fits( context, vaddr, paddr, size, true );
+  if ( ! super && ! section_fits( context, vaddr, paddr, size, false ) ) {
+    return 0;
+  }
+
+  // fill section
+  fill_section( &context->section[ SD_VIRTUAL_TABLE_INDEX( vaddr ) ],
+    ctx, paddr, memory, page, super );
+  // return mapped size
+  return super ? SD_SUPER_SECTION_SIZE : SD_SECTION_SIZE;
+}
+
+/**
+ * @brief Helper to map a range with the largest possible page sizes
+ *
+ * @param ctx pointer to page context
+ * @param vaddr start of virtual range
+ * @param paddr start of physical range, ignored when random is set
+ * @param size size of range, every touched page is mapped
+ * @param memory memory type
+ * @param page page attributes
+ * @param random flag to use a free physical page per entry
+ */
+static void map_range(
+  virt_context_ptr_t ctx,
+  uintptr_t vaddr,
+  uint64_t paddr,
+  size_t size,
+  virt_memory_type_t memory,
+  uint32_t page,
+  bool random
+) {
+  // page aligned start and amount of touched pages
+  uintptr_t addr = vaddr - vaddr % PAGE_SIZE;
+  size_t count = ( size + ( vaddr - addr ) + PAGE_SIZE - 1 ) / PAGE_SIZE;
+  // keep range for flush
+  uintptr_t start = addr;
+  size_t total = count * PAGE_SIZE;
+
+  // page aligned physical start
+  paddr -= paddr % PAGE_SIZE;
+
+  // debug output
+  #if defined( PRINT_MM_VIRT )
+    DEBUG_OUTPUT( "vaddr = %p, size = %#x, count = %u\r\n",
+      ( void* )vaddr, size, count );
+  #endif
+
+  // loop until everything is mapped
+  while ( 0 < count ) {
+    // physically contiguous ranges try sections first
+    if ( ! random ) {
+      size_t mapped = map_section(
+        ctx, addr, paddr, count * PAGE_SIZE, memory, page );
+      // continue with next address if mapped
+      if ( 0 < mapped ) {
+        addr += mapped;
+        paddr += mapped;
+        count -= mapped / PAGE_SIZE;
+        continue;
+      }
+    }
+
+    // get permanently mapped table for current address
+    sd_page_table_t* table = ( sd_page_table_t* )virt_pool_virtual(
+      ( uintptr_t )v7_short_create_table( ctx, addr, 0 ) );
+    // assert existence
+    assert( NULL != table );
+
+    // fill consecutive entries within this table
+    uint32_t page_idx = SD_VIRTUAL_PAGE_INDEX( addr );
+    while ( 0 < count && 256 > page_idx ) {
+      uint32_t amount = 1;
+      bool large = ! random
+        && 0 == page_idx % SD_LARGE_PAGE_ENTRIES
+        && 0 == paddr % SD_LARGE_PAGE_SIZE
+        && SD_LARGE_PAGE_ENTRIES <= count;
+
+      // ensure all entries of a large page are free
+      for ( uint32_t idx = 0; large && idx < SD_LARGE_PAGE_ENTRIES; idx++ ) {
+        large = 0 == table->page[ page_idx + idx ].raw;
+      }
+
+      // fill descriptor
+      if ( large ) {
+        fill_large_page( &table->page[ page_idx ], ctx, paddr, memory, page );
+        amount = SD_LARGE_PAGE_ENTRIES;
+      } else if ( random ) {
+        // get free physical page
+        uint64_t phys = phys_find_free_page( PAGE_SIZE );
+        // assert
+        assert( 0 != phys );
+        fill_small_page( &table->page[ page_idx ], ctx, phys, memory, page );
+      } else {
+        fill_small_page( &table->page[ page_idx ], ctx, paddr, memory, page );
+      }
+
+      // next entry
+      page_idx += amount;
+      count -= amount;
+      addr += amount * PAGE_SIZE;
+      paddr += amount * PAGE_SIZE;
+    }
   }
 
+  // flush whole range at once if running
+  virt_flush_range( ctx, start, total );
+}
+
+/**
+ * @brief Internal v7 short descriptor mapping function
+ *
+ * @param ctx pointer to page context
+ * @param vaddr pointer to virtual address
+ * @param paddr pointer to physical address
+ * @param memory memory type
+ * @param page page attributes
+ */
+void v7_short_map(
+  virt_context_ptr_t ctx,
+  uintptr_t vaddr,
+  uint64_t paddr,
+  virt_memory_type_t memory,
+  uint32_t page
+) {
+  // get page index
+  uint32_t page_idx = SD_VIRTUAL_PAGE_INDEX( vaddr );
+
+  // get table for mapping
+  sd_page_table_t* table = ( sd_page_table_t* )(
+    ( uintptr_t )v7_short_create_table(
+      ctx, vaddr, 0
+    )
+  );
+
+  #if defined( PRINT_MM_VIRT )
+    DEBUG_OUTPUT( "table: %p\r\n", ( void* )table );
+  #endif
+
+  // get permanently mapped table
+  table = ( sd_page_table_t* )virt_pool_virtual( ( uintptr_t )table );
+
+  // assert existence
+  assert( NULL != table );
+
   // debug output
   #if defined( PRINT_MM_VIRT )
+    DEBUG_OUTPUT( "table: %p\r\n", ( void* )table );
     DEBUG_OUTPUT( "table->page[ %u ].raw = %#08x\r\n",
       page_idx, table->page[ page_idx ].raw );
   #endif
 
-  // unmap temporary
-  unmap_temporary( ( uintptr_t )table, SD_TBL_SIZE );
+  // fill descriptor
+  fill_small_page( &table->page[ page_idx ], ctx, paddr, memory, page );
 
   // flush context if running
   virt_flush_address( ctx, vaddr );
 }
 
+/**
+ * @brief Internal v7 short descriptor range mapping function
+ *
+ * @param ctx pointer to page context
+ * @param vaddr start of virtual range
+ * @param paddr start of physical range
+ * @param size size of range
+ * @param memory memory type
+ * @param page page attributes
+ */
+void v7_short_map_range(
+  virt_context_ptr_t ctx,
+  uintptr_t vaddr,
+  uint64_t paddr,
+  size_t size,
+  virt_memory_type_t memory,
+  uint32_t page
+) {
+  map_range( ctx, vaddr, paddr, size, memory, page, false );
+}
+
+/**
+ * @brief Internal v7 short descriptor random range mapping function
+ *
+ * @param ctx pointer to page context
+ * @param vaddr start of virtual range
+ * @param size size of range
+ * @param memory memory type
+ * @param page page attributes
+ */
+void v7_short_map_range_random(
+  virt_context_ptr_t ctx,
+  uintptr_t vaddr,
+  size_t size,
+  virt_memory_type_t memory,
+  uint32_t page
+) {
+  map_range( ctx, vaddr, 0, size, memory, page, true );
+}
+
 /**
  * @brief Internal v7 short descriptor random mapping function
  *
@@ -651,8 +1142,9 @@ void v7_short_map(
  * @param vaddr pointer to virtual address
  * @param memory memory type
  * @param page page attributes
+ * @return bool false when no physical page is available
  */
-void v7_short_map_random(
+bool v7_short_map_random(
   virt_context_ptr_t ctx,
   uintptr_t vaddr,
   virt_memory_type_t memory,
@@ -660,10 +1152,13 @@ void v7_short_map_random(
 ) {
   // get physical address
   uint64_t phys = phys_find_free_page( PAGE_SIZE );
-  // assert
-  assert( 0 != phys );
+  // handle out of memory
+  if ( 0 == phys ) {
+    return false;
+  }
   // map it
   v7_short_map( ctx, vaddr, phys, memory, page );
+  return true;
 }
 
 /**
@@ -693,19 +1188,23 @@ void v7_short_unmap( virt_context_ptr_t ctx, uintptr_t vaddr, bool free_phys ) {
     ( uintptr_t )v7_short_create_table( ctx, vaddr, 0 )
   );
 
-   // map temporary
-  table = ( sd_page_table_t* )map_temporary( ( uintptr_t )table, SD_TBL_SIZE );
+  // get permanently mapped table
+  table = ( sd_page_table_t* )virt_pool_virtual( ( uintptr_t )table );
   // assert existence
   assert( NULL != table );
 
   // ensure not already mapped
   if ( 0 == table->page[ page_idx ].raw ) {
-    // unmap temporary
-    unmap_temporary( ( uintptr_t )table, SD_TBL_SIZE );
     // skip rest
     return;
   }
 
+  // replace large page by small pages
+  if ( SD_TBL_IS_LARGE_PAGE( table->page[ page_idx ].raw ) ) {
+    split_large_page(
+      &table->page[ page_idx - page_idx % SD_LARGE_PAGE_ENTRIES ] );
+  }
+
   // get page
   uintptr_t page = table->page[ page_idx ].raw & 0xFFFFF000;
 
@@ -716,19 +1215,161 @@ void v7_short_unmap( virt_context_ptr_t ctx, uintptr_t vaddr, bool free_phys ) {
 
   // set page table entry as invalid
   table->page[ page_idx ].raw = SD_TBL_INVALID;
+  // push entry to table walk
+  cache_clean_table(
+    ( uintptr_t )&table->page[ page_idx ], sizeof( sd_page_small_t ) );
 
   // free physical page
   if ( true == free_phys ) {
     phys_free_page( page );
   }
 
-  // unmap temporary
-  unmap_temporary( ( uintptr_t )table, SD_TBL_SIZE );
-
   // flush context if running
   virt_flush_address( ctx, vaddr );
 }
 
+/**
+ * @brief Helper to unmap a completely covered section or supersection
+ *
+ * @param ctx pointer to page context
+ * @param vaddr virtual address
+ * @param size remaining size to unmap
+ * @param free_phys flag to free also physical memory
+ * @return size_t unmapped size or 0 if no section is completely covered
+ */
+static size_t unmap_section(
+  virt_context_ptr_t ctx,
+  uintptr_t vaddr,
+  size_t size,
+  bool free_phys
+) {
+  // get context, user contexts cover only the lower half
+  sd_context_total_t* context = ( sd_context_total_t* )virt_pool_virtual(
+    ctx->context );
+  uint32_t table_idx = SD_VIRTUAL_TABLE_INDEX( vaddr );
+  uint32_t entry = context->raw[ table_idx ];
+
+  // skip if no section
+  if ( ! SD_TTBR_IS_SECTION( entry ) ) {
+    return 0;
+  }
+
+  // determine size, amount of entries and physical base
+  bool super = SD_TTBR_IS_SUPER_SECTION( entry );
+  size_t section_size = super ? SD_SUPER_SECTION_SIZE : SD_SECTION_SIZE;
+  uint32_t amount = super ? SD_SUPER_SECTION_ENTRIES : 1;
+  uint64_t base = entry & ( super ? 0xFF000000 : 0xFFF00000 );
+
+  // partially covered sections are split by create table
+  if ( 0 != vaddr % section_size || section_size > size ) {
+    return 0;
+  }
+
+  // set entries as invalid
+  for ( uint32_t idx = 0; idx < amount; idx++ ) {
+    context->raw[ table_idx + idx ] = SD_TTBR_TYPE_INVALID;
+  }
+  // push entries to table walk
+  cache_clean_table( ( uintptr_t )&context->raw[ table_idx ],
+    amount * sizeof( sd_context_section_t ) );
+
+  // free physical memory
+  if ( true == free_phys ) {
+    phys_free_page_range( base, section_size );
+  }
+
+  // return unmapped size
+  return section_size;
+}
+
+/**
+ * @brief Internal v7 short descriptor range unmapping function
+ *
+ * @param ctx pointer to page context
+ * @param vaddr start of virtual range
+ * @param size size of range, every touched page is unmapped
+ * @param free_phys flag to free also physical memory
+ */
+void v7_short_unmap_range(
+  virt_context_ptr_t ctx,
+  uintptr_t vaddr,
+  size_t size,
+  bool free_phys
+) {
+  // page aligned start and amount of touched pages
+  uintptr_t addr = vaddr - vaddr % PAGE_SIZE;
+  size_t count = ( size + ( vaddr - addr ) + PAGE_SIZE - 1 ) / PAGE_SIZE;
+  // keep range for flush
+  uintptr_t start = addr;
+  size_t total = count * PAGE_SIZE;
+
+  // loop until everything is unmapped
+  while ( 0 < count ) {
+    // remove completely covered sections without table
+    size_t unmapped = unmap_section( ctx, addr, count * PAGE_SIZE, free_phys );
+    if ( 0 < unmapped ) {
+      addr += unmapped;
+      count -= unmapped / PAGE_SIZE;
+      continue;
+    }
+
+    // get permanently mapped table for current address
+    sd_page_table_t* table = ( sd_page_table_t* )virt_pool_virtual(
+      ( uintptr_t )v7_short_create_table( ctx, addr, 0 ) );
+    // assert existence
+    assert( NULL != table );
+
+    // clear consecutive entries within this table
+    uint32_t page_idx = SD_VIRTUAL_PAGE_INDEX( addr );
+    while ( 0 < count && 256 > page_idx ) {
+      uint32_t amount = 1;
+      uint32_t entry = table->page[ page_idx ].raw;
+
+      // handle large pages
+      if ( SD_TBL_IS_LARGE_PAGE( entry ) ) {
+        // completely covered large page is removed at once
+        if (
+          0 == page_idx % SD_LARGE_PAGE_ENTRIES
+          && SD_LARGE_PAGE_ENTRIES <= count
+        ) {
+          amount = SD_LARGE_PAGE_ENTRIES;
+        // split partially covered one
+        } else {
+          split_large_page(
+            &table->page[ page_idx - page_idx % SD_LARGE_PAGE_ENTRIES ] );
+          entry = table->page[ page_idx ].raw;
+        }
+      }
+
+      // clear mapped entries
+      if ( 0 != entry ) {
+        // set page table entries as invalid
+        for ( uint32_t idx = 0; idx < amount; idx++ ) {
+          table->page[ page_idx + idx ].raw = SD_TBL_INVALID;
+        }
+        // push entries to table walk
+        cache_clean_table( ( uintptr_t )&table->page[ page_idx ],
+          amount * sizeof( sd_page_small_t ) );
+        // free physical memory, large pages use bits 15:12 for attributes
+        if ( true == free_phys ) {
+          phys_free_page_range(
+            ( uint64_t )( entry & (
+              SD_TBL_IS_LARGE_PAGE( entry ) ? 0xFFFF0000 : 0xFFFFF000 ) ),
+            amount * PAGE_SIZE );
+        }
+      }
+
+      // next entry
+      page_idx += amount;
+      count -= amount;
+      addr += amount * PAGE_SIZE;
+    }
+  }
+
+  // flush whole range at once if running
+  virt_flush_range( ctx, start, total );
+}
+
 /**
  * @brief Unmap temporary mapped page again
  *
@@ -752,12 +1393,31 @@ void v7_short_set_context( virt_context_ptr_t ctx ) {
       DEBUG_OUTPUT( "list: %p\r\n",
         ( void* )( ( ( sd_context_half_t* )( ( uintptr_t )ctx->context ) )->raw ) );
     #endif
-    // Copy page table address to cp15 ( ttbr0 )
+    // assign asid, complete tlb flush necessary on rollover
+    bool rollover = virt_asid_assign( ctx );
+    // switch to reserved kernel asid while changing ttbr0
+    __asm__ __volatile__(
+      "mcr p15, 0, %0, c13, c0, 1" : : "r" ( VIRT_ASID_KERNEL ) : "memory"
+    );
+    barrier_instruction_sync();
+    // Copy page table address with cacheable walk to cp15 ( ttbr0 )
     __asm__ __volatile__(
       "mcr p15, 0, %0, c2, c0, 0"
-      : : "r" ( ( ( sd_context_half_t* )( ( uintptr_t )ctx->context ) )->raw )
+      : : "r" ( ( uint32_t )ctx->context | SD_TTBR_WALK_WRITE_BACK )
       : "memory"
     );
+    barrier_instruction_sync();
+    // set asid of context within contextidr
+    __asm__ __volatile__(
+      "mcr p15, 0, %0, c13, c0, 1" : : "r" ( ctx->asid ) : "memory"
+    );
+    // invalidate entire tlb and branch predictor on rollover
+    if ( rollover ) {
+      __asm__ __volatile__( "mcr p15, 0, %0, c8, c7, 0" : : "r" ( 0 ) );
+      __asm__ __volatile__( "mcr p15, 0, %0, c7, c5, 6" : : "r" ( 0 ) );
+      barrier_data_sync();
+    }
+    barrier_instruction_sync();
     // overwrite global pointer
     user_context = ctx;
   // kernel context handling
@@ -767,10 +1427,10 @@ void v7_short_set_context( virt_context_ptr_t ctx ) {
       DEBUG_OUTPUT( "list: %p\r\n",
         ( void* )( ( ( sd_context_total_t* )( ( uintptr_t )ctx->context ) )->raw ) );
     #endif
-    // Copy page table address to cp15 ( ttbr1 )
+    // Copy page table address with cacheable walk to cp15 ( ttbr1 )
     __asm__ __volatile__(
       "mcr p15, 0, %0, c2, c0, 1"
-      : : "r" ( ( ( sd_context_total_t* )( ( uintptr_t )ctx->context ) )->raw )
+      : : "r" ( ( uint32_t )ctx->context | SD_TTBR_WALK_WRITE_BACK )
       : "memory"
     );
     // overwrite global pointer
@@ -808,7 +1468,7 @@ void v7_short_flush_complete( void ) {
 /**
  * @brief Flush address in short mode
  *
- * @param addr virtual address to flush
+ * @param addr virtual address to flush, asid within lower bits
  */
 void v7_short_flush_address( uintptr_t addr ) {
   // flush specific address
@@ -819,6 +1479,36 @@ void v7_short_flush_address( uintptr_t addr ) {
   barrier_data_sync();
 }
 
+/**
+ * @brief Flush virtual range in short mode
+ *
+ * @param addr start of virtual range
+ * @param size size of range
+ * @param asid asid of the range or kernel asid for global mappings
+ */
+void v7_short_flush_range( uintptr_t addr, size_t size, uint32_t asid ) {
+  // ensure table updates are visible to the table walk
+  barrier_data_sync();
+  // invalidate by asid or entire tlb for larger ranges
+  if ( VIRT_FLUSH_RANGE_THRESHOLD < size / PAGE_SIZE ) {
+    if ( VIRT_ASID_KERNEL == asid ) {
+      __asm__ __volatile__( "mcr p15, 0, %0, c8, c7, 0" : : "r" ( 0 ) );
+    } else {
+      __asm__ __volatile__( "mcr p15, 0, %0, c8, c7, 2" : : "r" ( asid ) );
+    }
+  } else {
+    // flush each address without intermediate barriers
+    for ( size_t offset = 0; offset < size; offset += PAGE_SIZE ) {
+      __asm__ __volatile__(
+        "mcr p15, 0, %0, c8, c7, 1" :: "r"( ( addr + offset ) | asid ) );
+    }
+  }
+  // data synchronization barrier
+  barrier_data_sync();
+  // instruction synchronization barrier
+  barrier_instruction_sync();
+}
+
 /**
  * @brief Helper to reserve temporary area for mappings
  *
@@ -828,10 +1518,12 @@ void v7_short_prepare_temporary( virt_context_ptr_t ctx ) {
   // ensure kernel for temporary
   assert( VIRT_CONTEXT_TYPE_KERNEL == ctx->type );
 
-  // free page table
-  uintptr_t table = ( uintptr_t )phys_find_free_page( PAGE_SIZE );
-  // overwrite page with zero
-  memset( ( void* )table, 0, PAGE_SIZE );
+  // create tables for permanent page table window
+  virt_pool_prepare( ctx );
+
+  // get cleared pages for tables from page table pool
+  uintptr_t table = ( uintptr_t )virt_pool_allocate(
+    PAGE_SIZE, TEMPORARY_SPACE_TABLE_SIZE );
 
   // determine offset
   uint32_t start = SD_VIRTUAL_TABLE_INDEX( TEMPORARY_SPACE_START );
@@ -844,20 +1536,26 @@ void v7_short_prepare_temporary( virt_context_ptr_t ctx ) {
   ) {
     // table offset
     uint32_t offset = SD_VIRTUAL_TABLE_INDEX( v );
-    // determine table size
-    uintptr_t tbl = table + ( start - offset ) * SD_TBL_SIZE;
+    // determine table address
+    uintptr_t tbl = table + ( offset - start ) * SD_TBL_SIZE;
     // create table
     v7_short_create_table( ctx, v, tbl );
   }
 
-  // map page table
-  v7_short_map(
-    ctx,
-    TEMPORARY_SPACE_START,
-    table,
-    VIRT_MEMORY_TYPE_NORMAL_NC,
-    VIRT_PAGE_TYPE_NON_EXECUTABLE
-  );
+  // map page tables at the beginning of temporary area
+  for (
+    uintptr_t offset = 0;
+    offset < TEMPORARY_SPACE_TABLE_SIZE;
+    offset += PAGE_SIZE
+  ) {
+    v7_short_map(
+      ctx,
+      TEMPORARY_SPACE_START + offset,
+      table + offset,
+      VIRT_MEMORY_TYPE_NORMAL,
+      VIRT_PAGE_TYPE_NON_EXECUTABLE
+    );
+  }
 }
 
 /**
@@ -878,26 +1576,14 @@ virt_context_ptr_t v7_short_create_context( virt_context_type_t type ) {
     ? SD_TTBR_ALIGNMENT_4G
     : SD_TTBR_ALIGNMENT_2G;
 
-  // create new context
-  uintptr_t ctx;
-  if ( ! virt_init_get() ) {
-    ctx = ( uintptr_t )VIRT_2_PHYS( aligned_alloc( alignment, size ) );
-  } else {
-    ctx = ( uintptr_t )phys_find_free_page_range( alignment, size );
-  }
+  // create new cleared context within page table pool
+  uintptr_t ctx = ( uintptr_t )virt_pool_allocate( alignment, size );
 
   // debug output
   #if defined( PRINT_MM_VIRT )
     DEBUG_OUTPUT( "type: %d, ctx: %p\r\n", type, ( void* )ctx );
   #endif
 
-  // map temporary
-  uintptr_t tmp = map_temporary( ctx, size );
-  // initialize with zero
-  memset( ( void* )tmp, 0, size );
-  // unmap temporary
-  unmap_temporary( tmp, size );
-
   // create new context structure for return
   virt_context_ptr_t context = ( virt_context_ptr_t )malloc(
     sizeof( virt_context_t )
@@ -948,10 +1634,10 @@ void v7_short_prepare( void ) {
     DEBUG_OUTPUT( "reg = %#08x\r\n", reg );
   #endif
 
-  // set access flag to 1 within sctlr
-  reg |= ( 1 << 29 );
-  // set TRE flag to 0 within sctlr
+  // disable access flag, ap[ 0 ] is used as access permission bit
   reg &= ( uint32_t )( ~( 1 << 29 ) );
+  // disable tex remap, so that tex, c and b encode the memory type
+  reg &= ( uint32_t )( ~( 1 << 28 ) );
 
   // debug output
   #if defined( PRINT_MM_VIRT )
@@ -979,6 +1665,13 @@ bool v7_short_is_mapped_in_context( virt_context_ptr_t ctx, uintptr_t addr ) {
   uint32_t page_idx = SD_VIRTUAL_PAGE_INDEX( addr );
   bool mapped = false;
 
+  // sections are mapped without page table
+  sd_context_total_t* context = ( sd_context_total_t* )virt_pool_virtual(
+    ctx->context );
+  if ( SD_TTBR_IS_SECTION( context->raw[ SD_VIRTUAL_TABLE_INDEX( addr ) ] ) ) {
+    return true;
+  }
+
   // get table for checking
   sd_page_table_t* table = ( sd_page_table_t* )(
     ( uintptr_t )v7_short_create_table( ctx, addr, 0 ) );
@@ -986,8 +1679,8 @@ bool v7_short_is_mapped_in_context( virt_context_ptr_t ctx, uintptr_t addr ) {
   #if defined( PRINT_MM_VIRT )
     DEBUG_OUTPUT( "table: %p\r\n", ( void* )table );
   #endif
-  // map temporary
-  table = ( sd_page_table_t* )map_temporary( ( uintptr_t )table, SD_TBL_SIZE );
+  // get permanently mapped table
+  table = ( sd_page_table_t* )virt_pool_virtual( ( uintptr_t )table );
   // assert existence
   assert( NULL != table );
 
@@ -1003,9 +1696,87 @@ bool v7_short_is_mapped_in_context( virt_context_ptr_t ctx, uintptr_t addr ) {
     mapped = true;
   }
 
-  // unmap temporary
-  unmap_temporary( ( uintptr_t )table, SD_TBL_SIZE );
-
   // return flag
   return mapped;
 }
+
+/**
+ * @brief Checks whether address is mapped writable
+ *
+ * @param ctx
+ * @param addr
+ * @return true if mapped and writable
+ * @return false if not mapped or read only
+ */
+bool v7_short_is_writable_in_context( virt_context_ptr_t ctx, uintptr_t addr ) {
+  // sections are mapped without page table
+  sd_context_total_t* context = ( sd_context_total_t* )virt_pool_virtual(
+    ctx->context );
+  uint32_t entry = context->raw[ SD_VIRTUAL_TABLE_INDEX( addr ) ];
+  if ( SD_TTBR_IS_SECTION( entry ) ) {
+    return ! SD_TTBR_IS_READ_ONLY( entry );
+  }
+
+  // get table
+  sd_page_table_t* table = ( sd_page_table_t* )virt_pool_virtual(
+    ( uintptr_t )v7_short_create_table( ctx, addr, 0 ) );
+  // assert existence
+  assert( NULL != table );
+
+  // get entry and check access permission
+  entry = table->page[ SD_VIRTUAL_PAGE_INDEX( addr ) ].raw;
+  return 0 != entry && ! SD_TBL_IS_READ_ONLY( entry );
+}
+
+/**
+ * @brief Get physical address of a mapped virtual address
+ *
+ * @param ctx
+ * @param addr
+ * @return uint64_t
+ */
+uint64_t v7_short_get_mapped_address_in_context(
+  virt_context_ptr_t ctx,
+  uintptr_t addr
+) {
+  // get page index
+  uint32_t page_idx = SD_VIRTUAL_PAGE_INDEX( addr );
+
+  // sections are mapped without page table
+  sd_context_total_t* context = ( sd_context_total_t* )virt_pool_virtual(
+    ctx->context );
+  uint32_t entry = context->raw[ SD_VIRTUAL_TABLE_INDEX( addr ) ];
+  if ( SD_TTBR_IS_SECTION( entry ) ) {
+    // supersection base address
+    if ( SD_TTBR_IS_SUPER_SECTION( entry ) ) {
+      return ( entry & ~( uint32_t )( SD_SUPER_SECTION_SIZE - 1 ) )
+        | ( addr & ( SD_SUPER_SECTION_SIZE - 1 ) );
+    }
+    // section base address
+    return ( entry & ~( uint32_t )( SD_SECTION_SIZE - 1 ) )
+      | ( addr & ( SD_SECTION_SIZE - 1 ) );
+  }
+
+  // get table
+  sd_page_table_t* table = ( sd_page_table_t* )virt_pool_virtual(
+    ( uintptr_t )v7_short_create_table( ctx, addr, 0 ) );
+  // assert existence
+  assert( NULL != table );
+
+  // get entry and assert mapping
+  entry = table->page[ page_idx ].raw;
+  assert( 0 != entry );
+
+  // debug output
+  #if defined( PRINT_MM_VIRT )
+    DEBUG_OUTPUT( "table->page[ %u ] = %#08x\r\n", page_idx, entry );
+  #endif
+
+  // large page base address
+  if ( SD_TBL_IS_LARGE_PAGE( entry ) ) {
+    return ( entry & ~( uint32_t )( SD_LARGE_PAGE_SIZE - 1 ) )
+      | ( addr & ( SD_LARGE_PAGE_SIZE - 1 ) );
+  }
+  // small page base address
+  return ( entry & 0xFFFFF000 ) | ( addr & 0xFFF );
+}
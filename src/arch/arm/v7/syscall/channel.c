@@ -0,0 +1,162 @@
+
+/**
+ * Copyright (C) 2018 - 2020 bolthur project.
+ *
+ * This file is part of bolthur/kernel.
+ *
+ * bolthur/kernel is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * bolthur/kernel is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <core/syscall.h>
+#include <core/interrupt.h>
+#include <core/task/process.h>
+#include <core/task/thread.h>
+#include <core/task/channel.h>
+#include <core/task/wait.h>
+#include <arch/arm/v7/syscall.h>
+
+/**
+ * Register layout of send and receive:
+ * r0 - channel id
+ * r1 - message buffer
+ * r2 - amount of messages
+ * r3 - flags, SYSCALL_CHANNEL_NONBLOCK to return instead of blocking
+ */
+
+/**
+ * @brief Helper to validate channel message buffer
+ *
+ * @param context cpu context
+ * @param count amount of messages, capped at channel size
+ * @param write buffer is written by the kernel
+ * @return bool true if buffer is mapped user memory
+ */
+static bool validate_message_buffer(
+  void* context,
+  size_t* count,
+  bool write
+) {
+  // more than a channel is able to hold is never transferred
+  if ( TASK_CHANNEL_SIZE < *count ) {
+    *count = TASK_CHANNEL_SIZE;
+  }
+  // validate whole span once
+  return syscall_validate_buffer(
+    SYSCALL_ARGUMENT( context, 1 ),
+    *count * sizeof( task_channel_message_t ),
+    write );
+}
+
+/**
+ * @brief Create channel received by calling process
+ *
+ * @param context
+ */
+void syscall_channel_create( void* context ) {
+  // get context
+  INTERRUPT_DETERMINE_CONTEXT( context )
+
+  // create channel and return id
+  task_channel_ptr_t channel = task_channel_create(
+    task_thread_current_thread->process );
+  SYSCALL_RETURN( context, channel->id );
+}
+
+/**
+ * @brief Enqueue batch of messages to channel
+ *
+ * @param context
+ */
+void syscall_channel_send( void* context ) {
+  // get context
+  INTERRUPT_DETERMINE_CONTEXT( context )
+
+  // get arguments
+  task_channel_ptr_t channel = task_channel_get_by_id(
+    SYSCALL_ARGUMENT( context, 0 ) );
+  size_t count = SYSCALL_ARGUMENT( context, 2 );
+  uint32_t flags = SYSCALL_ARGUMENT( context, 3 );
+
+  // validate channel and buffer
+  if (
+    NULL == channel
+    || ! validate_message_buffer( context, &count, false )
+  ) {
+    SYSCALL_RETURN( context, SYSCALL_ERROR_INVALID );
+    return;
+  }
+
+  // push as much as possible, user mapping is active
+  size_t pushed = task_channel_push(
+    channel,
+    task_thread_current_thread->process->id,
+    ( const task_channel_message_t* )SYSCALL_ARGUMENT( context, 1 ),
+    count );
+  // block while channel is full, syscall is repeated after wakeup
+  if (
+    0 == pushed
+    && 0 < count
+    && ! ( flags & SYSCALL_CHANNEL_NONBLOCK )
+  ) {
+    SYSCALL_RESTART( context );
+    task_wait_block( &channel->sender, task_thread_current_thread );
+    return;
+  }
+  // return pushed amount
+  SYSCALL_RETURN( context, pushed );
+}
+
+/**
+ * @brief Dequeue batch of messages from channel
+ *
+ * @param context
+ */
+void syscall_channel_receive( void* context ) {
+  // get context
+  INTERRUPT_DETERMINE_CONTEXT( context )
+
+  // get arguments
+  task_channel_ptr_t channel = task_channel_get_by_id(
+    SYSCALL_ARGUMENT( context, 0 ) );
+  size_t count = SYSCALL_ARGUMENT( context, 2 );
+  uint32_t flags = SYSCALL_ARGUMENT( context, 3 );
+
+  // validate channel, owner and buffer
+  if (
+    NULL == channel
+    || task_thread_current_thread->process->id != channel->owner
+    || ! validate_message_buffer( context, &count, true )
+  ) {
+    SYSCALL_RETURN( context, SYSCALL_ERROR_INVALID );
+    return;
+  }
+
+  // pop as much as possible, user mapping is active
+  size_t popped = task_channel_pop(
+    channel,
+    ( task_channel_message_t* )SYSCALL_ARGUMENT( context, 1 ),
+    count );
+  // block while channel is empty, syscall is repeated after wakeup
+  if (
+    0 == popped
+    && 0 < count
+    && ! ( flags & SYSCALL_CHANNEL_NONBLOCK )
+  ) {
+    SYSCALL_RESTART( context );
+    task_wait_block( &channel->receiver, task_thread_current_thread );
+    return;
+  }
+  // return popped amount
+  SYSCALL_RETURN( context, popped );
+}
@@ -0,0 +1,40 @@
+
+/**
+ * Copyright (C) 2018 - 2020 bolthur project.
+ *
+ * This file is part of bolthur/kernel.
+ *
+ * bolthur/kernel is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * bolthur/kernel is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <core/syscall.h>
+#include <core/interrupt.h>
+#include <core/task/process.h>
+#include <core/task/thread.h>
+#include <arch/arm/v7/syscall.h>
+
+/**
+ * @brief Fork running thread into new process sharing pages copy on write
+ *
+ * @param context
+ */
+void syscall_fork( void* context ) {
+  // get context
+  INTERRUPT_DETERMINE_CONTEXT( context )
+
+  // fork process, forked thread returns 0
+  task_process_ptr_t process = task_process_fork( task_thread_current_thread );
+  // return id of forked process to parent
+  SYSCALL_RETURN( context, process->id );
+}
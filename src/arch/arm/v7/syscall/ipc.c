@@ -0,0 +1,384 @@
+
+/**
+ * Copyright (C) 2018 - 2020 bolthur project.
+ *
+ * This file is part of bolthur/kernel.
+ *
+ * bolthur/kernel is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * bolthur/kernel is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <core/syscall.h>
+#include <core/interrupt.h>
+#include <core/mm/phys.h>
+#include <core/mm/virt.h>
+#include <core/mm/cow.h>
+#include <core/mm/shared.h>
+#include <core/task/process.h>
+#include <core/task/thread.h>
+#include <core/task/wait.h>
+#include <core/task/region.h>
+#include <core/debug/debug.h>
+#include <arch/arm/v7/syscall.h>
+
+/**
+ * Message layout within registers:
+ * r0 - partner thread id on entry, partner id or status on return
+ * r1 - r3 - message words
+ * r4 - page aligned address of pages to grant / receive window
+ * r5 - size of pages to grant / receive window, 0 if unused
+ */
+
+/**
+ * @brief Helper to validate page range passed within r4 / r5
+ *
+ * @param address start address
+ * @param size range size
+ * @return true if range is page aligned user space
+ * @return false if range is invalid
+ */
+static bool validate_page_range( uintptr_t address, size_t size ) {
+  return 0 == address % PAGE_SIZE
+    && 0 == size % PAGE_SIZE
+    && address + size >= address
+    && address + size <= VIRT_USER_SPACE_END;
+}
+
+/**
+ * @brief Helper to validate grant of sender
+ *
+ * @param cpu sender context
+ * @return true if nothing or a completely mapped range is granted
+ * @return false if grant is invalid
+ */
+static bool validate_grant( cpu_register_context_ptr_t cpu ) {
+  // nothing granted
+  if ( 0 == cpu->reg.r5 ) {
+    return true;
+  }
+  if (
+    ! validate_page_range( cpu->reg.r4, cpu->reg.r5 )
+    || ! syscall_validate_buffer( cpu->reg.r4, cpu->reg.r5, false )
+  ) {
+    return false;
+  }
+  // read only pages may be shared with other processes and can't be granted
+  task_process_ptr_t process = task_thread_current_thread->process;
+  for ( size_t offset = 0; offset < cpu->reg.r5; offset += PAGE_SIZE ) {
+    if ( task_region_read_only( process, cpu->reg.r4 + offset ) ) {
+      return false;
+    }
+    // shared memory frames are owned by their object
+    if ( shared_is_mapped( process->virtual_context, cpu->reg.r4 + offset ) ) {
+      return false;
+    }
+  }
+  // return success
+  return true;
+}
+
+/**
+ * @brief Helper to validate receive window
+ *
+ * @param cpu receiver context
+ * @return true if nothing or a completely unmapped range is offered
+ * @return false if window is invalid
+ */
+static bool validate_window( cpu_register_context_ptr_t cpu ) {
+  // no receive window
+  if ( 0 == cpu->reg.r5 ) {
+    return true;
+  }
+  // check range
+  if ( ! validate_page_range( cpu->reg.r4, cpu->reg.r5 ) ) {
+    return false;
+  }
+  // window has to be unmapped
+  virt_context_ptr_t ctx = task_thread_current_thread->process->virtual_context;
+  for ( size_t offset = 0; offset < cpu->reg.r5; offset += PAGE_SIZE ) {
+    if ( virt_is_mapped_in_context( ctx, cpu->reg.r4 + offset ) ) {
+      return false;
+    }
+  }
+  // return success
+  return true;
+}
+
+/**
+ * @brief Transfer message from sender to receiver registers
+ *
+ * @param sender sending thread
+ * @param receiver receiving thread
+ * @param grant transfer granted pages into receive window
+ * @return true if message has been transferred
+ * @return false if receive window has been populated meanwhile
+ */
+static bool transfer(
+  task_thread_ptr_t sender,
+  task_thread_ptr_t receiver,
+  bool grant
+) {
+  cpu_register_context_ptr_t source =
+    ( cpu_register_context_ptr_t )sender->current_context;
+  cpu_register_context_ptr_t target =
+    ( cpu_register_context_ptr_t )receiver->current_context;
+
+  // debug output
+  #if defined( PRINT_SYSCALL )
+    DEBUG_OUTPUT( "IPC transfer from %zu to %zu\r\n",
+      sender->id, receiver->id );
+  #endif
+
+  // remap granted pages, limited by receive window
+  size_t size = 0;
+  if ( grant ) {
+    size = source->reg.r5 < target->reg.r5
+      ? source->reg.r5 : target->reg.r5;
+    // other threads of receiver may have mapped into window after validation
+    for ( size_t offset = 0; offset < size; offset += PAGE_SIZE ) {
+      if ( virt_is_mapped_in_context(
+        receiver->process->virtual_context, target->reg.r4 + offset
+      ) ) {
+        return false;
+      }
+    }
+    for ( size_t offset = 0; offset < size; offset += PAGE_SIZE ) {
+      // get private copy of pages shared copy on write
+      cow_fault( sender->process->virtual_context, source->reg.r4 + offset,
+        VIRT_PAGE_TYPE_NON_EXECUTABLE );
+      // get physical page of sender
+      uint64_t page = virt_get_mapped_address_in_context(
+        sender->process->virtual_context, source->reg.r4 + offset );
+      // remove from sender without freeing
+      virt_unmap_address(
+        sender->process->virtual_context, source->reg.r4 + offset, false );
+      // map into receive window
+      virt_map_address(
+        receiver->process->virtual_context,
+        target->reg.r4 + offset,
+        page,
+        VIRT_MEMORY_TYPE_NORMAL,
+        VIRT_PAGE_TYPE_NON_EXECUTABLE );
+    }
+  }
+
+  // copy message words
+  target->reg.r0 = sender->id;
+  target->reg.r1 = source->reg.r1;
+  target->reg.r2 = source->reg.r2;
+  target->reg.r3 = source->reg.r3;
+  // window address is kept, size is replaced by transferred size
+  target->reg.r5 = size;
+  // return success
+  return true;
+}
+
+/**
+ * @brief Helper to remove sender from queue of a receiver
+ *
+ * @param queue sender queue
+ * @param source sender id or 0 for any sender
+ * @return task_thread_ptr_t removed sender or NULL
+ */
+static task_thread_ptr_t sender_take( task_wait_queue_ptr_t queue, size_t source ) {
+  task_thread_ptr_t previous = NULL;
+  task_thread_ptr_t current = queue->first;
+  // find matching sender
+  while ( NULL != current && 0 != source && current->id != source ) {
+    previous = current;
+    current = current->queue_next;
+  }
+  // handle no match
+  if ( NULL == current ) {
+    return NULL;
+  }
+
+  // unlink sender
+  if ( NULL == previous ) {
+    queue->first = current->queue_next;
+  } else {
+    previous->queue_next = current->queue_next;
+  }
+  if ( queue->last == current ) {
+    queue->last = previous;
+  }
+  current->queue_next = NULL;
+  // return sender
+  return current;
+}
+
+/**
+ * @brief Send or call, shared between both syscalls
+ *
+ * @param context sender context
+ * @param state ipc state of sender while blocked
+ */
+static void send( void* context, task_thread_ipc_state_t state ) {
+  // get running thread and destination
+  task_thread_ptr_t current = task_thread_current_thread;
+  task_thread_ptr_t destination = task_thread_get_by_id(
+    SYSCALL_ARGUMENT( context, 0 ) );
+
+  // validate destination and grant
+  if (
+    NULL == destination
+    || current == destination
+    || ! validate_grant( ( cpu_register_context_ptr_t )context )
+  ) {
+    SYSCALL_RETURN( context, SYSCALL_ERROR_INVALID );
+    return;
+  }
+
+  // sender return value for plain send
+  SYSCALL_RETURN( context, 0 );
+  current->ipc_partner = destination->id;
+
+  // receiver not yet waiting, so queue up at receiver
+  if (
+    TASK_THREAD_IPC_RECEIVE != destination->ipc_state
+    || (
+      0 != destination->ipc_partner
+      && current->id != destination->ipc_partner
+    )
+  ) {
+    current->ipc_state = state;
+    task_wait_block( &destination->ipc_sender, current );
+    return;
+  }
+
+  // fast path: transfer registers and pages directly
+  if ( ! transfer( current, destination, true ) ) {
+    current->ipc_partner = 0;
+    SYSCALL_RETURN( context, SYSCALL_ERROR_INVALID );
+    return;
+  }
+  destination->ipc_state = TASK_THREAD_IPC_NONE;
+  destination->state = TASK_THREAD_STATE_READY;
+
+  // caller waits for reply
+  if ( TASK_THREAD_IPC_CALL == state ) {
+    current->ipc_state = TASK_THREAD_IPC_REPLY;
+    current->state = TASK_THREAD_STATE_BLOCKED;
+  } else {
+    current->ipc_state = TASK_THREAD_IPC_NONE;
+  }
+
+  // switch directly to receiver
+  task_process_switch( destination );
+}
+
+/**
+ * @brief Send message to thread, blocks until received
+ *
+ * @param context
+ */
+void syscall_ipc_send( void* context ) {
+  // get context
+  INTERRUPT_DETERMINE_CONTEXT( context )
+  // send message
+  send( context, TASK_THREAD_IPC_SEND );
+}
+
+/**
+ * @brief Send message to thread and wait for its reply
+ *
+ * @param context
+ */
+void syscall_ipc_call( void* context ) {
+  // get context
+  INTERRUPT_DETERMINE_CONTEXT( context )
+  // send message and wait for reply
+  send( context, TASK_THREAD_IPC_CALL );
+}
+
+/**
+ * @brief Receive message from given or any thread, blocks until sent
+ *
+ * @param context
+ */
+void syscall_ipc_receive( void* context ) {
+  // get context
+  INTERRUPT_DETERMINE_CONTEXT( context )
+
+  // get running thread and source
+  task_thread_ptr_t current = task_thread_current_thread;
+  size_t source = SYSCALL_ARGUMENT( context, 0 );
+
+  // validate receive window
+  if ( ! validate_window( ( cpu_register_context_ptr_t )context ) ) {
+    SYSCALL_RETURN( context, SYSCALL_ERROR_INVALID );
+    return;
+  }
+
+  // get waiting sender
+  task_thread_ptr_t sender = sender_take( &current->ipc_sender, source );
+  // nothing sent yet, so block until a sender arrives
+  if ( NULL == sender ) {
+    current->ipc_state = TASK_THREAD_IPC_RECEIVE;
+    current->ipc_partner = source;
+    task_wait_suspend( current );
+    return;
+  }
+
+  // transfer registers and pages, fail send when window has been populated
+  if ( ! transfer( sender, current, true ) ) {
+    SYSCALL_RETURN( sender->current_context, SYSCALL_ERROR_INVALID );
+    sender->ipc_state = TASK_THREAD_IPC_NONE;
+    task_wait_resume( sender );
+    SYSCALL_RETURN( context, SYSCALL_ERROR_INVALID );
+    return;
+  }
+  // caller stays blocked until reply
+  if ( TASK_THREAD_IPC_CALL == sender->ipc_state ) {
+    sender->ipc_state = TASK_THREAD_IPC_REPLY;
+  } else {
+    sender->ipc_state = TASK_THREAD_IPC_NONE;
+    task_wait_resume( sender );
+  }
+}
+
+/**
+ * @brief Reply to thread waiting within call, doesn't block
+ *
+ * @param context
+ */
+void syscall_ipc_reply( void* context ) {
+  // get context
+  INTERRUPT_DETERMINE_CONTEXT( context )
+
+  // get running thread and caller
+  task_thread_ptr_t current = task_thread_current_thread;
+  task_thread_ptr_t caller = task_thread_get_by_id(
+    SYSCALL_ARGUMENT( context, 0 ) );
+
+  // caller has to wait for reply of running thread
+  if (
+    NULL == caller
+    || TASK_THREAD_IPC_REPLY != caller->ipc_state
+    || current->id != caller->ipc_partner
+  ) {
+    SYSCALL_RETURN( context, SYSCALL_ERROR_INVALID );
+    return;
+  }
+
+  // transfer registers only, pages are granted by send and call
+  transfer( current, caller, false );
+  SYSCALL_RETURN( context, 0 );
+  caller->ipc_state = TASK_THREAD_IPC_NONE;
+  caller->state = TASK_THREAD_STATE_READY;
+
+  // switch directly to caller
+  task_process_switch( caller );
+}
@@ -21,7 +21,7 @@
 #include <core/event.h>
 #include <core/syscall.h>
 #include <core/interrupt.h>
-#include <arch/arm/v7/cpu.h>
+#include <arch/arm/v7/syscall.h>
 
 /**
  * @brief Dummy system call for testing purposes
@@ -34,9 +34,8 @@ void syscall_putc( void* context ) {
   // get context
   INTERRUPT_DETERMINE_CONTEXT( context )
 
-  // transform to cpu structure
-  cpu_register_context_ptr_t cpu = ( cpu_register_context_ptr_t )context;
-
   // simple character printing
-  printf( "%c", ( uint8_t )cpu->reg.r0 );
+  printf( "%c", ( uint8_t )SYSCALL_ARGUMENT( context, 0 ) );
+  // return success
+  SYSCALL_RETURN( context, 0 );
 }
@@ -0,0 +1,98 @@
+
+/**
+ * Copyright (C) 2018 - 2020 bolthur project.
+ *
+ * This file is part of bolthur/kernel.
+ *
+ * bolthur/kernel is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * bolthur/kernel is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <core/syscall.h>
+#include <core/interrupt.h>
+#include <core/mm/shared.h>
+#include <core/task/process.h>
+#include <core/task/thread.h>
+#include <arch/arm/v7/syscall.h>
+
+/**
+ * @brief Helper to get running process
+ *
+ * @return task_process_ptr_t
+ */
+static task_process_ptr_t current_process( void ) {
+  return task_thread_current_thread->process;
+}
+
+/**
+ * @brief Create shared memory object mapped at given address
+ *
+ * @param context
+ */
+void syscall_shm_create( void* context ) {
+  // get context
+  INTERRUPT_DETERMINE_CONTEXT( context )
+
+  // get arguments
+  size_t size = SYSCALL_ARGUMENT( context, 0 );
+  uintptr_t address = SYSCALL_ARGUMENT( context, 1 );
+
+  // create object and return id, 0 on error
+  SYSCALL_RETURN( context, shared_create( current_process(), address, size ) );
+}
+
+/**
+ * @brief Map shared memory object at given address
+ *
+ * @param context
+ */
+void syscall_shm_map( void* context ) {
+  // get context
+  INTERRUPT_DETERMINE_CONTEXT( context )
+
+  // get arguments
+  size_t id = SYSCALL_ARGUMENT( context, 0 );
+  uintptr_t address = SYSCALL_ARGUMENT( context, 1 );
+
+  // map object
+  if ( ! shared_map( current_process(), id, address ) ) {
+    SYSCALL_RETURN( context, SYSCALL_ERROR_INVALID );
+    return;
+  }
+  // return success
+  SYSCALL_RETURN( context, 0 );
+}
+
+/**
+ * @brief Unmap shared memory object from given address
+ *
+ * @param context
+ */
+void syscall_shm_unmap( void* context ) {
+  // get context
+  INTERRUPT_DETERMINE_CONTEXT( context )
+
+  // get arguments
+  size_t id = SYSCALL_ARGUMENT( context, 0 );
+  uintptr_t address = SYSCALL_ARGUMENT( context, 1 );
+
+  // unmap object, backing memory is released with last mapping
+  if ( ! shared_unmap(
+    current_process()->virtual_context, id, address
+  ) ) {
+    SYSCALL_RETURN( context, SYSCALL_ERROR_INVALID );
+    return;
+  }
+  // return success
+  SYSCALL_RETURN( context, 0 );
+}
@@ -0,0 +1,46 @@
+
+/**
+ * Copyright (C) 2018 - 2020 bolthur project.
+ *
+ * This file is part of bolthur/kernel.
+ *
+ * bolthur/kernel is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * bolthur/kernel is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <core/event.h>
+#include <core/timer.h>
+#include <core/syscall.h>
+#include <core/interrupt.h>
+#include <core/task/wait.h>
+#include <arch/arm/v7/syscall.h>
+
+/**
+ * @brief Put running thread to sleep for given milliseconds
+ *
+ * @param context
+ */
+void syscall_sleep( void* context ) {
+  // get context
+  INTERRUPT_DETERMINE_CONTEXT( context )
+
+  // get milliseconds from first argument
+  uint64_t milliseconds = SYSCALL_ARGUMENT( context, 0 );
+  // calculate absolute deadline in microseconds
+  uint64_t wakeup = timer_get_microsecond() + milliseconds * 1000;
+
+  // return success, blocking happens when returning to user
+  SYSCALL_RETURN( context, 0 );
+  // block running thread until deadline has been reached
+  task_wait_sleep( task_thread_current_thread, wakeup );
+}
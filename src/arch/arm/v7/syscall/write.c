@@ -0,0 +1,55 @@
+
+/**
+ * Copyright (C) 2018 - 2020 bolthur project.
+ *
+ * This file is part of bolthur/kernel.
+ *
+ * bolthur/kernel is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * bolthur/kernel is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <core/tty.h>
+#include <core/syscall.h>
+#include <core/interrupt.h>
+#include <arch/arm/v7/syscall.h>
+
+/**
+ * @brief Write user buffer to console with one call
+ *
+ * @param context
+ */
+void syscall_write( void* context ) {
+  // get context
+  INTERRUPT_DETERMINE_CONTEXT( context )
+
+  // get arguments
+  uint32_t fd = SYSCALL_ARGUMENT( context, 0 );
+  uintptr_t buffer = SYSCALL_ARGUMENT( context, 1 );
+  size_t length = SYSCALL_ARGUMENT( context, 2 );
+
+  // only console descriptors are supported
+  if ( SYSCALL_FD_STDOUT != fd && SYSCALL_FD_STDERR != fd ) {
+    SYSCALL_RETURN( context, SYSCALL_ERROR_INVALID );
+    return;
+  }
+  // validate whole buffer once
+  if ( ! syscall_validate_buffer( buffer, length, false ) ) {
+    SYSCALL_RETURN( context, SYSCALL_ERROR_INVALID );
+    return;
+  }
+
+  // hand whole span to console, user mapping is active
+  tty_write( ( const uint8_t* )buffer, length );
+  // return written amount
+  SYSCALL_RETURN( context, length );
+}
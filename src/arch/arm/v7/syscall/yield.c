@@ -0,0 +1,38 @@
+
+/**
+ * Copyright (C) 2018 - 2020 bolthur project.
+ *
+ * This file is part of bolthur/kernel.
+ *
+ * bolthur/kernel is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * bolthur/kernel is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <core/event.h>
+#include <core/syscall.h>
+#include <core/interrupt.h>
+#include <arch/arm/v7/syscall.h>
+
+/**
+ * @brief Give up remaining time slice
+ *
+ * @param context
+ */
+void syscall_yield( void* context ) {
+  // get context
+  INTERRUPT_DETERMINE_CONTEXT( context )
+  // return success
+  SYSCALL_RETURN( context, 0 );
+  // trigger scheduling, running thread is expired as ready
+  event_enqueue( EVENT_TIMER, EVENT_DETERMINE_ORIGIN( context ) );
+}
@@ -26,6 +26,8 @@
 #include <core/arch.h>
 #include <core/task/queue.h>
 #include <core/task/process.h>
+#include <core/task/wait.h>
+#include <core/timer.h>
 #include <core/debug/debug.h>
 #include <core/interrupt.h>
 #include <arch/arm/v7/cpu.h>
@@ -46,24 +48,19 @@ void task_process_start( void ) {
     return;
   }
 
-  // variable for next thread queue
-  task_priority_queue_ptr_t next_queue = task_queue_get_queue(
-    process_manager, next_thread->priority );
-  // assert queue
-  assert( NULL != next_queue );
-
   // set current running thread
-  task_thread_set_current( next_thread, next_queue );
+  task_thread_set_current( next_thread );
+  // start time slice and program its end
+  process_manager->slice_start = timer_get_microsecond();
+  task_process_timer_update();
 
   // debug output
   #if defined( PRINT_PROCESS )
-    DEBUG_OUTPUT( "next_thread = %p, next_queue = %p\r\n",
-      ( void* )next_thread, ( void* )next_queue );
+    DEBUG_OUTPUT( "next_thread = %p\r\n", ( void* )next_thread );
   #endif
 
-  // set context and flush
+  // set context, tlb entries are tagged by asid
   virt_set_context( next_thread->process->virtual_context );
-  virt_flush_complete();
 
   // debug output
   #if defined( PRINT_PROCESS )
@@ -111,64 +108,76 @@ void task_process_schedule( __unused event_origin_t origin, void* context ) {
 
   // set running thread
   task_thread_ptr_t running_thread = task_thread_current_thread;
-  // get running queue if set
-  task_priority_queue_ptr_t running_queue = NULL;
-  if ( NULL != running_thread ) {
-    running_queue = task_queue_get_queue(
-      process_manager, running_thread->priority );
-    // assert queue
-    assert( NULL != running_queue );
-    // set last handled within running queue
-    running_queue->last_handled = running_thread;
-    // update running task to halt due to switch
-    running_thread->state = TASK_THREAD_STATE_HALT_SWITCH;
+  // requeue running thread for next round, blocked ones stay in wait queues
+  if (
+    NULL != running_thread
+    && TASK_THREAD_STATE_ACTIVE == running_thread->state
+  ) {
+    // reset state to ready
+    running_thread->state = TASK_THREAD_STATE_READY;
+    // push to expired set, so that all other threads are handled first
+    task_queue_expire( process_manager->thread_run_queue, running_thread );
   }
 
+  // wake up sleeping threads
+  task_wait_wake_sleeping( timer_get_microsecond() );
+
   // get next thread
   task_thread_ptr_t next_thread;
-  do {
-    // get next thread
-    next_thread = task_thread_next();
-
-    // reset queue if nothing found
-    if ( NULL == next_thread ) {
-      // reset
-      task_process_queue_reset();
-      // wait for exception
-      arch_halt();
-    }
-  } while ( NULL == next_thread );
-
-  // variable for next thread
-  task_priority_queue_ptr_t next_queue = NULL;
-  if ( NULL != next_thread ) {
-    next_queue = task_queue_get_queue(
-      process_manager, next_thread->priority );
-    // assert queue
-    assert( NULL != next_queue );
-  }
+  while ( NULL == ( next_thread = task_thread_next() ) ) {
+    // debug output
+    #if defined( PRINT_PROCESS )
+      DEBUG_OUTPUT( "No runnable thread, waiting for interrupt\r\n" );
+    #endif
 
-  // reset current if queue changed
-  if ( NULL != running_queue && running_queue != next_queue ) {
-    running_queue->current = NULL;
+    // stop tick or program earliest wakeup while idle
+    task_process_timer_update();
+    // wait for interrupt, irqs are masked so exception is not taken
+    arch_halt();
+    // handle pending interrupts directly
+    interrupt_handle_pending( cpu );
+    // wake up sleeping threads
+    task_wait_wake_sleeping( timer_get_microsecond() );
   }
 
-  // save context of current thread
-  if ( NULL != running_thread ) {
+  // switch to next thread
+  task_process_switch( next_thread );
+}
+
+/**
+ * @brief Switch directly to thread without picking from run queue
+ *
+ * @param next_thread thread to switch to
+ *
+ * @note A still active running thread stays runnable within current round
+ */
+void task_process_switch( task_thread_ptr_t next_thread ) {
+  // set running thread
+  task_thread_ptr_t running_thread = task_thread_current_thread;
+  // requeue still active running thread
+  if (
+    NULL != running_thread
+    && TASK_THREAD_STATE_ACTIVE == running_thread->state
+  ) {
     // reset state to ready
     running_thread->state = TASK_THREAD_STATE_READY;
+    // push to active set
+    task_queue_push( process_manager->thread_run_queue, running_thread );
   }
+
   // overwrite current running thread
-  task_thread_set_current( next_thread, next_queue );
+  task_thread_set_current( next_thread );
+  // start time slice and program its end or next wakeup
+  process_manager->slice_start = timer_get_microsecond();
+  task_process_timer_update();
 
   // Switch to thread ttbr when thread is a different process in user mode
   if (
     NULL == running_thread
     || running_thread->process != next_thread->process
   ) {
-    // set context and flush
+    // set context, tlb entries are tagged by asid
     virt_set_context( next_thread->process->virtual_context );
-    virt_flush_complete();
     // debug output
     #if defined( PRINT_PROCESS )
       DUMP_REGISTER( next_thread->current_context );
@@ -31,6 +31,7 @@
 #include <core/task/process.h>
 #include <core/task/thread.h>
 #include <core/task/stack.h>
+#include <core/task/region.h>
 #include <arch/arm/v7/cpu.h>
 
 /**
@@ -53,8 +54,6 @@ task_thread_ptr_t task_thread_create(
       ( void* )entry, ( void* )process, priority );
   #endif
 
-  // create stack
-  uint64_t stack_physical = phys_find_free_page_range( STACK_SIZE, STACK_SIZE );
   // get next stack address for user area
   uintptr_t stack_virtual = task_stack_manager_next( process->thread_stack_manager );
   // debug output
@@ -85,20 +84,11 @@ task_thread_ptr_t task_thread_create(
     ( void* )current_context,
     sizeof( cpu_register_context_t ) );
 
-  // map stack temporary
-  uintptr_t tmp_virtual_user = virt_map_temporary( stack_physical, STACK_SIZE );
-  // prepare stack
-  memset( ( void* )tmp_virtual_user, 0, STACK_SIZE );
-  // unmap again
-  virt_unmap_temporary( tmp_virtual_user, STACK_SIZE );
   // create node for stack address management tree
   task_stack_manager_add( stack_virtual, process->thread_stack_manager );
-  // map allocated stack
-  virt_map_address(
-    process->virtual_context,
-    stack_virtual,
-    stack_physical,
-    VIRT_MEMORY_TYPE_NORMAL,
+  // record stack, zeroed pages are populated on first access
+  task_region_add(
+    process, stack_virtual, STACK_SIZE, 0, 0, false,
     VIRT_PAGE_TYPE_EXECUTABLE );
 
   // create thread structure
@@ -117,7 +107,6 @@ task_thread_ptr_t task_thread_create(
   thread->id = task_thread_generate_id();
   thread->priority = priority;
   thread->process = process;
-  thread->stack_physical = stack_physical;
   thread->stack_virtual = stack_virtual;
   thread->current_context = ( void* )current_context;
   thread->initial_context = ( void* )initial_context;
@@ -127,12 +116,84 @@ task_thread_ptr_t task_thread_create(
   avl_prepare_node( &thread->node_id, ( void* )thread->id );
   // add to tree
   avl_insert_by_node( process->thread_manager, &thread->node_id );
+  // add to global tree
+  avl_prepare_node( &thread->node_global, ( void* )thread->id );
+  avl_insert_by_node( process_manager->tree_thread_id, &thread->node_global );
 
-  // get thread queue by priority
-  task_priority_queue_ptr_t queue = task_queue_get_queue(
-    process_manager, priority );
-  // add thread to thread list for switching
-  list_push_back( queue->thread_list, thread );
+  // add thread to run queue for switching
+  task_queue_push( process_manager->thread_run_queue, thread );
+
+  // cppcheck-suppress memleak
+  // return created thread
+  return thread;
+}
+
+/**
+ * @brief Duplicate thread into forked process
+ *
+ * The forked thread continues with the current register context of the
+ * duplicated one, but gets 0 as return value within r0.
+ *
+ * @param source thread to duplicate
+ * @param process forked process
+ * @return task_thread_ptr_t pointer to thread structure
+ */
+task_thread_ptr_t task_thread_fork(
+  task_thread_ptr_t source,
+  task_process_ptr_t process
+) {
+  // debug output
+  #if defined( PRINT_PROCESS )
+    DEBUG_OUTPUT(
+      "task_thread_fork( %p, %p ) called\r\n",
+      ( void* )source, ( void* )process );
+  #endif
+
+  // create context
+  cpu_register_context_ptr_t current_context = ( cpu_register_context_ptr_t )malloc(
+    sizeof( cpu_register_context_t ) );
+  cpu_register_context_ptr_t initial_context = ( cpu_register_context_ptr_t )malloc(
+    sizeof( cpu_register_context_t ) );
+  // assert malloc return
+  assert( NULL != current_context && NULL != initial_context );
+  // copy over contexts
+  memcpy(
+    ( void* )current_context,
+    source->current_context,
+    sizeof( cpu_register_context_t ) );
+  memcpy(
+    ( void* )initial_context,
+    source->initial_context,
+    sizeof( cpu_register_context_t ) );
+  // forked thread returns 0
+  current_context->reg.r0 = 0;
+
+  // create thread structure
+  task_thread_ptr_t thread = ( task_thread_ptr_t )malloc(
+    sizeof( task_thread_t ) );
+  // assert malloc return
+  assert( NULL != thread );
+  // prepare
+  memset( ( void* )thread, 0, sizeof( task_thread_t ) );
+  // populate thread structure, stack is part of cloned regions
+  thread->state = TASK_THREAD_STATE_READY;
+  thread->id = task_thread_generate_id();
+  thread->priority = source->priority;
+  thread->process = process;
+  thread->stack_virtual = source->stack_virtual;
+  thread->current_context = ( void* )current_context;
+  thread->initial_context = ( void* )initial_context;
+
+  // prepare node
+  avl_prepare_node( &thread->node_id, ( void* )thread->id );
+  // add to tree
+  avl_insert_by_node( process->thread_manager, &thread->node_id );
+  // add to global tree
+  avl_prepare_node( &thread->node_global, ( void* )thread->id );
+  avl_insert_by_node( process_manager->tree_thread_id, &thread->node_global );
+
+  // add thread to run queue for switching
+  task_queue_push( process_manager->thread_run_queue, thread );
 
   // cppcheck-suppress memleak
   // return created thread
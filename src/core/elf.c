@@ -18,12 +18,12 @@
  * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <string.h>
 #include <core/elf/common.h>
 #include <core/elf/elf32.h>
-#include <core/mm/phys.h>
 #include <core/entry.h>
 #include <core/debug/debug.h>
+#include <core/initrd.h>
+#include <core/task/region.h>
 
 /**
  * @brief Check elf header for execution
@@ -132,53 +132,27 @@ static void load_program_header( uintptr_t elf, task_process_ptr_t process ) {
       continue;
     }
 
-    // determine needed space
-    uintptr_t needed_size = program_header->p_memsz;
-    if ( needed_size % PAGE_SIZE ) {
-      needed_size += ( PAGE_SIZE - needed_size % PAGE_SIZE );
+    // determine page attributes from segment flags
+    uint32_t page = program_header->p_flags & PF_X
+      ? VIRT_PAGE_TYPE_EXECUTABLE
+      : VIRT_PAGE_TYPE_NON_EXECUTABLE;
+    if ( ! ( program_header->p_flags & PF_W ) ) {
+      page |= VIRT_PAGE_TYPE_READ_ONLY;
     }
 
-    // loop until needed size is zero
-    uintptr_t offset = 0;
-    while ( needed_size != 0 ) {
-      // get physical page
-      uint64_t phys = phys_find_free_page( PAGE_SIZE );
-
-      // map it temporary
-      uintptr_t tmp = virt_map_temporary( phys, PAGE_SIZE );
-
-      // partial data copy
-      if ( offset < program_header->p_filesz ) {
-        // determine amount to copy
-        size_t to_copy = program_header->p_filesz - offset;
-        // copy up to one page size
-        if ( to_copy > PAGE_SIZE ) {
-          to_copy = PAGE_SIZE;
-        }
-        // copy over data
-        memcpy(
-          ( void* )tmp,
-          ( void* )( ( uintptr_t )header + program_header->p_offset + offset ),
-          program_header->p_filesz - offset
-        );
-      }
-
-      // unmap temporary
-      virt_unmap_temporary( tmp, PAGE_SIZE );
-
-      // map it wotjom process context
-      virt_map_address(
-        process->virtual_context,
-        program_header->p_vaddr + offset,
-        phys,
-        VIRT_MEMORY_TYPE_NORMAL,
-        VIRT_PAGE_TYPE_EXECUTABLE
-      );
-
-      // subtract one page
-      needed_size -= PAGE_SIZE;
-      offset += PAGE_SIZE;
-    }
+    // record segment, pages are populated on first access and read only
+    // pages within initrd are mapped directly
+    task_region_add(
+      process,
+      program_header->p_vaddr,
+      program_header->p_memsz,
+      elf + program_header->p_offset,
+      program_header->p_filesz,
+      initrd_exist()
+        && elf >= initrd_get_start_address()
+        && elf < initrd_get_end_address(),
+      page
+    );
   }
 }
 
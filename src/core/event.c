@@ -35,30 +35,96 @@
 event_manager_ptr_t event = NULL;
 
 /**
- * @brief Compare event callback necessary for avl tree
+ * @brief Helper to get ring buffer by origin
  *
- * @param a node a
- * @param b node b
- * @return int32_t
+ * @param origin event origin
+ * @return event_queue_ptr_t
  */
-static int32_t compare_event_callback(
-  const avl_node_ptr_t a,
-  const avl_node_ptr_t b
-) {
-  // get blocks
-  event_block_ptr_t block_a = EVENT_GET_BLOCK( a );
-  event_block_ptr_t block_b = EVENT_GET_BLOCK( b );
+static event_queue_ptr_t queue_by_origin( event_origin_t origin ) {
+  return EVENT_ORIGIN_KERNEL == origin
+    ? &event->queue_kernel
+    : &event->queue_user;
+}
+
+/**
+ * @brief Helper to append event to ring buffer
+ *
+ * @param queue ring buffer
+ * @param type event type
+ */
+static void queue_push( event_queue_ptr_t queue, event_type_t type ) {
+  // get tail
+  uint32_t tail = queue->tail;
+  // handle full ring buffer
+  if ( EVENT_QUEUE_SIZE == tail - queue->head ) {
+    PANIC( "Event queue overflow!" );
+  }
+
+  // populate entry
+  event_entry_ptr_t entry = &queue->entry[ tail & ( EVENT_QUEUE_SIZE - 1 ) ];
+  entry->type = type;
+  // publish entry
+  queue->tail = tail + 1;
+}
 
-  // -1 if address of a is greater than address of b
-  if ( block_a->type > block_b->type ) {
-    return -1;
-  // 1 if address of b is greater than address of a
-  } else if ( block_b->type > block_a->type ) {
-    return 1;
+/**
+ * @brief Helper to remove first event from ring buffer
+ *
+ * @param queue ring buffer
+ * @param entry entry to fill
+ * @return true if an event has been removed
+ * @return false if queue is empty
+ */
+static bool queue_pop( event_queue_ptr_t queue, event_entry_ptr_t entry ) {
+  // get head
+  uint32_t head = queue->head;
+  // handle empty ring buffer
+  if ( head == queue->tail ) {
+    return false;
   }
 
-  // equal => return 0
-  return 0;
+  // copy entry
+  *entry = queue->entry[ head & ( EVENT_QUEUE_SIZE - 1 ) ];
+  // release slot
+  queue->head = head + 1;
+  // return success
+  return true;
+}
+
+/**
+ * @brief Helper to execute callback list
+ *
+ * @param list list of callback wrappers
+ * @param origin event origin
+ * @param data data to pass through
+ */
+static void fire( list_manager_ptr_t list, event_origin_t origin, void* data ) {
+  // handle nothing bound
+  if ( NULL == list ) {
+    return;
+  }
+
+  // get first element
+  list_item_ptr_t current = list->first;
+  // debug output
+  #if defined( PRINT_EVENT )
+    DEBUG_OUTPUT( "Used first element for looping at %p\r\n",
+      ( void* )current );
+  #endif
+  // loop through list
+  while ( NULL != current ) {
+    // get callback from data
+    event_callback_wrapper_ptr_t wrapper =
+      ( event_callback_wrapper_ptr_t )current->data;
+    // debug output
+    #if defined( PRINT_EVENT )
+      DEBUG_OUTPUT( "Executing bound callback %p\r\n", ( void* )wrapper );
+    #endif
+    // fire with data
+    wrapper->callback( origin, data );
+    // step to next
+    current = current->next;
+  }
 }
 
 /**
@@ -69,24 +135,13 @@ void event_init( void ) {
   event = ( event_manager_ptr_t )malloc( sizeof( event_manager_t ) );
   // assert result
   assert( NULL != event );
-  // prepare
+  // prepare, ring buffers start empty
   memset( ( void* )event, 0, sizeof( event_manager_t ) );
   // debug output
   #if defined( PRINT_EVENT )
     DEBUG_OUTPUT( "Initialized event manager structure at %p\r\n",
       ( void* )event );
   #endif
-
-  // create tree
-  event->tree = avl_create_tree( compare_event_callback );
-  // debug output
-  #if defined( PRINT_EVENT )
-    DEBUG_OUTPUT( "Created event tree at: %p\r\n", ( void* )event->tree );
-  #endif
-
-  // create queue
-  event->queue_kernel = list_construct();
-  event->queue_user = list_construct();
 }
 
 /**
@@ -109,38 +164,14 @@ bool event_bind( event_type_t type, event_callback_t callback, bool post ) {
     DEBUG_OUTPUT( "Called event_bind( %d, %p, %s )\r\n",
       type, callback, post ? "true" : "false" );
   #endif
-  // get correct tree to use
-  avl_tree_ptr_t tree = event->tree;
-
-  // try to find node
-  avl_node_ptr_t node = avl_find_by_data( tree, ( void* )type );
-  event_block_ptr_t block;
-  // debug output
-  #if defined( PRINT_EVENT )
-    DEBUG_OUTPUT( "Found node %p\r\n", ( void* )node );
-  #endif
-  // handle not yet added
-  if ( NULL == node ) {
-    // allocate block
-    block = ( event_block_ptr_t )malloc( sizeof( event_block_t ) );
-    // assert initialization
-    assert( NULL != block );
-    // prepare memory
-    memset( ( void* )block, 0, sizeof( event_block_t ) );
-    // debug output
-    #if defined( PRINT_EVENT )
-      DEBUG_OUTPUT( "Initialized new node at %p\r\n", ( void* )block );
-    #endif
-    // populate block
-    block->type = type;
+  // assert valid type
+  assert( EVENT_TYPE_COUNT > type );
+  // get block from handler table
+  event_block_ptr_t block = &event->block[ type ];
+  // create callback lists if not yet done
+  if ( NULL == block->handler ) {
     block->handler = list_construct();
     block->post = list_construct();
-    // prepare and insert node
-    avl_prepare_node( &block->node, ( void* )type );
-    avl_insert_by_node( tree, &block->node );
-  // existing? => gather block
-  } else {
-    block = EVENT_GET_BLOCK( node );
   }
 
   // debug output
@@ -224,7 +255,7 @@ void event_unbind(
 }
 
 /**
- * @brief Enqueue event
+ * @brief Enqueue event, coalesced with an identical pending event
  *
  * @param type type to enqueue
  * @param origin event origin
@@ -235,13 +266,18 @@ void event_enqueue( event_type_t type, event_origin_t origin ) {
     return;
   }
 
-  // push back event
-  list_push_back(
-    EVENT_ORIGIN_KERNEL == origin
-      ? event->queue_kernel
-      : event->queue_user,
-    ( void* )type
-  );
+  // assert valid type
+  assert( EVENT_TYPE_COUNT > type );
+  // get queue
+  event_queue_ptr_t queue = queue_by_origin( origin );
+  // skip when same event is still pending
+  if ( queue->pending & ( 1U << type ) ) {
+    return;
+  }
+
+  // mark pending and push back event
+  queue->pending |= 1U << type;
+  queue_push( queue, type );
 }
 
 /**
@@ -267,84 +303,22 @@ void event_handle( void* data ) {
     DEBUG_OUTPUT( "origin = %d\r\n", origin );
   #endif
   // queue to use
-  list_manager_ptr_t queue = EVENT_ORIGIN_KERNEL == origin
-    ? event->queue_kernel
-    : event->queue_user;
+  event_queue_ptr_t queue = queue_by_origin( origin );
   // debug output
   #if defined( PRINT_EVENT )
     DEBUG_OUTPUT( "queue = %p\r\n", ( void* )queue );
   #endif
 
-  // variables
-  list_item_ptr_t current_event = list_pop_front( queue );
-  // get correct tree to use
-  avl_tree_ptr_t tree = event->tree;
-
-  while ( NULL != current_event ) {
-    // try to find node
-    avl_node_ptr_t node = avl_find_by_data( tree, current_event );
-    event_block_ptr_t block;
-    // debug output
-    #if defined( PRINT_EVENT )
-      DEBUG_OUTPUT( "Found node %p\r\n", ( void* )node );
-    #endif
-
-    // handle no existing
-    if ( NULL == node ) {
-      // pop next
-      current_event = list_pop_front( queue );
-      // skip rest
-      continue;
-    }
-    // get block
-    block = EVENT_GET_BLOCK( node );
-
-    // get first element of normal callback list
-    list_item_ptr_t current = block->handler->first;
-    // debug output
-    #if defined( PRINT_EVENT )
-      DEBUG_OUTPUT( "Used first normal element for looping at %p\r\n",
-        ( void* )current );
-    #endif
-    // loop through list
-    while ( NULL != current ) {
-      // get callback from data
-      event_callback_wrapper_ptr_t wrapper =
-        ( event_callback_wrapper_ptr_t )current->data;
-      // debug output
-      #if defined( PRINT_EVENT )
-        DEBUG_OUTPUT( "Executing bound callback %p\r\n", ( void* )wrapper );
-      #endif
-      // fire with data
-      wrapper->callback( origin, data );
-      // step to next
-      current = current->next;
-    }
-
-    // get first element of post callback list
-    current = block->post->first;
-    // debug output
-    #if defined( PRINT_EVENT )
-      DEBUG_OUTPUT( "Used first post element for looping at %p\r\n",
-        ( void* )current );
-    #endif
-    // loop through list
-    while ( NULL != current ) {
-      // get callback from data
-      event_callback_wrapper_ptr_t wrapper =
-        ( event_callback_wrapper_ptr_t )current->data;
-      // debug output
-      #if defined( PRINT_EVENT )
-        DEBUG_OUTPUT( "Executing bound callback %p\r\n", ( void* )wrapper );
-      #endif
-      // fire with data
-      wrapper->callback( origin, data );
-      // step to next
-      current = current->next;
-    }
-
-    // get next element
-    current_event = list_pop_front( queue );
+  event_entry_t entry;
+  // handle events until ring buffer is empty
+  while ( queue_pop( queue, &entry ) ) {
+    // allow enqueue of same type again while handling
+    queue->pending &= ~( 1U << entry.type );
+    // get block from handler table
+    event_block_ptr_t block = &event->block[ entry.type ];
+    // fire normal and post callbacks
+    fire( block->handler, origin, data );
+    fire( block->post, origin, data );
   }
 
   // debug output
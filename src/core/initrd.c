@@ -21,8 +21,20 @@
 #include <stdint.h>
 #include <stddef.h>
 
+#include <assert.h>
 #include <tar.h>
+#include <lz4.h>
+#include <core/entry.h>
 #include <core/initrd.h>
+#include <core/panic.h>
+#include <core/timer.h>
+#include <core/mm/phys.h>
+#include <core/mm/virt.h>
+#include <core/mm/heap.h>
+#include <core/task/region.h>
+#include <core/debug/debug.h>
+
+#include <arch/arm/cache.h>
 
 /**
  * @brief internal initrd load address
@@ -34,6 +46,11 @@ static uintptr_t initrd_address = 0;
  */
 static size_t initrd_size = 0;
 
+/**
+ * @brief initrd file index
+ */
+static tar_index_ptr_t initrd_index = NULL;
+
 /**
  * @brief Method to get initrd address
  *
@@ -88,3 +105,186 @@ void initrd_set_size( size_t size ) {
 bool initrd_exist( void ) {
   return 0 < initrd_size;
 }
+
+/**
+ * @brief Decompress lz4 compressed initrd
+ *
+ * Has to be called after virtual memory setup, as the decompressed initrd is
+ * placed within physical pages mapped linearly into the kernel context. The
+ * compressed pages are released afterwards.
+ */
+void initrd_decompress( void ) {
+  // skip without initrd or when not compressed
+  if ( ! initrd_exist() || ! lz4_check( initrd_address, initrd_size ) ) {
+    return;
+  }
+
+  // get start time
+  uint64_t start = timer_get_microsecond();
+
+  // determine decompressed size
+  size_t size = lz4_size( initrd_address, initrd_size );
+  if ( 0 == size ) {
+    PANIC( "Invalid compressed initrd!" );
+  }
+  // round up to page size
+  size_t aligned = size;
+  if ( aligned % PAGE_SIZE ) {
+    aligned += ( PAGE_SIZE - aligned % PAGE_SIZE );
+  }
+
+  // get physical pages for decompressed initrd
+  uint64_t phys = phys_find_free_page_range( PAGE_SIZE, aligned );
+  // linear mapping must not reach into heap area
+  if (
+    0 == phys
+    || HEAP_START - KERNEL_OFFSET < phys + aligned
+  ) {
+    PANIC( "Unable to allocate space for decompressed initrd!" );
+  }
+  uintptr_t address = PHYS_2_VIRT( phys );
+
+  // debug output
+  #if defined( PRINT_INITRD )
+    DEBUG_OUTPUT( "Decompress initrd %p - %p to %p - %p\r\n",
+      ( void* )initrd_address, ( void* )( initrd_address + initrd_size ),
+      ( void* )address, ( void* )( address + size ) );
+  #endif
+
+  // map linearly
+  virt_map_range(
+    kernel_context,
+    address,
+    phys,
+    aligned,
+    VIRT_MEMORY_TYPE_NORMAL,
+    VIRT_PAGE_TYPE_AUTO
+  );
+  // decompress block by block
+  if ( size != lz4_decompress( initrd_address, initrd_size, address, size ) ) {
+    PANIC( "Decompression of initrd failed!" );
+  }
+  // push written data out, as executable pages are mapped directly to user
+  cache_clean_range( address, size );
+  // drop possibly stale instructions
+  cache_invalidate_instruction_cache();
+
+  // get end time
+  uint64_t elapsed = timer_get_microsecond() - start;
+  // report throughput
+  DEBUG_OUTPUT(
+    "Decompressed initrd from %zu to %zu bytes in %llu us ( %llu KiB/s )\r\n",
+    initrd_size, size, elapsed,
+    0 < elapsed ? ( uint64_t )size * 1000000 / 1024 / elapsed : 0
+  );
+
+  // release full pages of compressed initrd, partial ones may be shared
+  uintptr_t compressed_start = initrd_address;
+  uintptr_t compressed_end = initrd_address + initrd_size;
+  if ( compressed_start % PAGE_SIZE ) {
+    compressed_start += ( PAGE_SIZE - compressed_start % PAGE_SIZE );
+  }
+  compressed_end -= compressed_end % PAGE_SIZE;
+  if ( compressed_start < compressed_end ) {
+    virt_unmap_range(
+      kernel_context,
+      compressed_start,
+      compressed_end - compressed_start,
+      true
+    );
+  }
+
+  // set decompressed initrd
+  initrd_address = address;
+  initrd_size = size;
+}
+
+/**
+ * @brief Build file index of initrd once
+ */
+void initrd_index_init( void ) {
+  // assert not yet built
+  assert( NULL == initrd_index );
+  // skip without initrd
+  if ( ! initrd_exist() ) {
+    return;
+  }
+
+  // build index
+  initrd_index = tar_index_create( initrd_address );
+  // assert creation
+  assert( NULL != initrd_index );
+
+  // debug output
+  #if defined( PRINT_INITRD )
+    for (
+      tar_index_entry_ptr_t entry = tar_index_next( initrd_index, "", NULL );
+      NULL != entry;
+      entry = tar_index_next( initrd_index, "", entry )
+    ) {
+      DEBUG_OUTPUT( "%p: initrd file name: %s, size: %llu\r\n",
+        ( void* )entry->header, entry->header->file_name, entry->size );
+    }
+  #endif
+}
+
+/**
+ * @brief Get file index of initrd
+ *
+ * @return tar_index_ptr_t index or NULL if not built
+ */
+tar_index_ptr_t initrd_index_get( void ) {
+  return initrd_index;
+}
+
+/**
+ * @brief Release initrd pages not needed by any process
+ *
+ * Has to be called after initial processes have been created. Pages still
+ * referenced as region source, e.g. for demand paging or direct mapped read
+ * only segments, are kept. The initrd is not accessible afterwards.
+ */
+void initrd_reclaim( void ) {
+  // skip without initrd
+  if ( ! initrd_exist() ) {
+    return;
+  }
+
+  // destroy index, as it references the initrd
+  if ( initrd_index ) {
+    tar_index_destroy( initrd_index );
+    initrd_index = NULL;
+  }
+
+  // determine completely covered pages, partial ones may be shared
+  uintptr_t start = initrd_address;
+  uintptr_t end = initrd_address + initrd_size;
+  if ( start % PAGE_SIZE ) {
+    start += ( PAGE_SIZE - start % PAGE_SIZE );
+  }
+  end -= end % PAGE_SIZE;
+
+  // release unused pages
+  size_t released = 0;
+  for ( uintptr_t page = start; page < end; page += PAGE_SIZE ) {
+    // skip pages still used by regions
+    if ( task_region_source_used( page, page + PAGE_SIZE ) ) {
+      continue;
+    }
+    // unmap and free
+    virt_unmap_range( kernel_context, page, PAGE_SIZE, true );
+    released += PAGE_SIZE;
+  }
+
+  // debug output
+  #if defined( PRINT_INITRD )
+    DEBUG_OUTPUT( "Released %zu of %zu initrd bytes\r\n",
+      released, initrd_size );
+  #else
+    ( void )released;
+  #endif
+
+  // initrd is gone
+  initrd_address = 0;
+  initrd_size = 0;
+}
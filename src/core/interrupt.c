@@ -20,7 +20,6 @@
 
 #include <stddef.h>
 
-#include <avl.h>
 #include <assert.h>
 #include <string.h>
 #include <stdlib.h>
@@ -30,89 +29,61 @@
 #include <core/interrupt.h>
 
 /**
- * @brief Interrupt management structure
+ * @brief Interrupt dispatch table indexed by type and number
  */
-interrupt_manager_ptr_t interrupt_manager = NULL;
+static interrupt_manager_t interrupt_manager;
 
 /**
- * @brief Compare interrupt callback necessary for avl tree
+ * @brief Helper to get dispatch block by type and number
  *
- * @param a node a
- * @param b node b
- * @return int32_t
+ * @param type interrupt type
+ * @param num interrupt number
+ * @return interrupt_block_ptr_t block or NULL for invalid number
  */
-static int32_t compare_interrupt_callback(
-  const avl_node_ptr_t a,
-  const avl_node_ptr_t b
+static interrupt_block_ptr_t block_by_type(
+  interrupt_type_t type,
+  size_t num
 ) {
-  // get blocks
-  interrupt_block_ptr_t block_a = INTERRUPT_GET_BLOCK( a );
-  interrupt_block_ptr_t block_b = INTERRUPT_GET_BLOCK( b );
-
-  // -1 if address of a is greater than address of b
-  if ( block_a->interrupt > block_b->interrupt ) {
-    return -1;
-  // 1 if address of b is greater than address of a
-  } else if ( block_b->interrupt > block_a->interrupt ) {
-    return 1;
-  }
-
-  // equal => return 0
-  return 0;
-}
-
-/**
- * @brief Helper to get interrupt manager tree by type
- *
- * @param type type to get tree from
- * @return avl_tree_ptr_t
- */
-static avl_tree_ptr_t tree_by_type( interrupt_type_t type ) {
-  // assert heap existence
-  assert( true == heap_init_get() );
   // debug output
-  #if defined( PRINT_EVENT )
-    DEBUG_OUTPUT( "Called tree_by_type( %d )\r\n", type );
+  #if defined( PRINT_INTERRUPT )
+    DEBUG_OUTPUT( "Called block_by_type( %d, %zu )\r\n", type, num );
   #endif
-  // setup interrupt manager if not done existing
-  if ( NULL == interrupt_manager ) {
-    // initialize interrupt manager
-    interrupt_manager = ( interrupt_manager_ptr_t )malloc(
-      sizeof( interrupt_manager_t ) );
-    // assert initialization
-    assert( NULL != interrupt_manager );
-    // prepare memory
-    memset( ( void* )interrupt_manager, 0, sizeof( interrupt_manager_t ) );
-    // create trees for interrupt types
-    interrupt_manager->normal_interrupt = avl_create_tree(
-      compare_interrupt_callback );
-    interrupt_manager->fast_interrupt = avl_create_tree(
-      compare_interrupt_callback );
-    interrupt_manager->software_interrupt = avl_create_tree(
-      compare_interrupt_callback );
-    // debug output
-    #if defined( PRINT_INTERRUPT )
-      DEBUG_OUTPUT( "Initialized interrupt manager with address %p\r\n",
-        ( void* )interrupt_manager );
-    #endif
-  }
 
-  // set by type
+  // get by type
   switch ( type ) {
     case INTERRUPT_NORMAL:
-      return interrupt_manager->normal_interrupt;
+      return INTERRUPT_HARDWARE_COUNT > num
+        ? &interrupt_manager.normal_interrupt[ num ] : NULL;
 
     case INTERRUPT_FAST:
-      return interrupt_manager->fast_interrupt;
-
-    case INTERRUPT_SOFTWARE:
-      return interrupt_manager->software_interrupt;
+      return INTERRUPT_HARDWARE_COUNT > num
+        ? &interrupt_manager.fast_interrupt[ num ] : NULL;
   }
 
   // invalid
   return NULL;
 }
 
+/**
+ * @brief Helper to execute callbacks of a slot chain
+ *
+ * @param slot inline slot
+ * @param context interrupt context
+ */
+static void fire( interrupt_slot_ptr_t slot, void* context ) {
+  // loop through inline slot and overflow chain
+  while ( NULL != slot && NULL != slot->callback ) {
+    // debug output
+    #if defined( PRINT_INTERRUPT )
+      DEBUG_OUTPUT( "Handling slot %p\r\n", ( void* )slot );
+    #endif
+    // fire with data
+    slot->callback( context );
+    // step to next
+    slot = slot->next;
+  }
+}
+
 /**
  * @brief Unregister interrupt handler
  *
@@ -146,71 +117,41 @@ void interrupt_unregister_handler(
     assert( interrupt_validate_number( num ) );
   }
 
-  // get correct tree to use
-  avl_tree_ptr_t tree = tree_by_type( type );
-  // handle no tree
-  if ( NULL == tree ) {
+  // get block
+  interrupt_block_ptr_t block = block_by_type( type, num );
+  // handle invalid
+  if ( NULL == block ) {
     return;
   }
-  // debug output
-  #if defined( PRINT_INTERRUPT )
-    DEBUG_OUTPUT(
-      "Using interrupt tree \"%p\" for lookup!\r\n", ( void* )tree );
-  #endif
 
-  // try to find node
-  avl_node_ptr_t node = avl_find_by_data( tree, ( void* )num );
-  interrupt_block_ptr_t block;
-  // debug output
-  #if defined( PRINT_INTERRUPT )
-    DEBUG_OUTPUT( "Found node %p\r\n", ( void* )node );
-  #endif
-  // handle not yet added
-  if ( NULL == node ) {
+  // get inline slot
+  interrupt_slot_ptr_t slot = true != post ? &block->handler : &block->post;
+  // handle match of inline slot
+  if ( slot->callback == callback ) {
+    interrupt_slot_ptr_t next = slot->next;
+    // move first chained slot inline
+    if ( NULL != next ) {
+      *slot = *next;
+      free( ( void* )next );
+    } else {
+      slot->callback = NULL;
+    }
     return;
   }
-  // gather block
-  block = INTERRUPT_GET_BLOCK( node );
 
-  // debug output
-  #if defined( PRINT_EVENT )
-    DEBUG_OUTPUT( "Checking for not bound interrupt callback\r\n" );
-  #endif
-  // get first element
-  list_item_ptr_t match = NULL;
-  list_manager_ptr_t list = true != post
-    ? block->handler : block->post;
-  list_item_ptr_t current = list->first;
-  // debug output
-  #if defined( PRINT_EVENT )
-    DEBUG_OUTPUT( "Used first element for looping at %p\r\n", ( void* )current );
-  #endif
-  // loop through list for check callback
-  while ( NULL != current ) {
-    // get callback from data
-    interrupt_callback_wrapper_ptr_t wrapper =
-      ( interrupt_callback_wrapper_ptr_t )current->data;
-    // debug output
-    #if defined( PRINT_EVENT )
-      DEBUG_OUTPUT( "Check bound callback at %p\r\n", ( void* )wrapper );
-    #endif
+  // loop through overflow chain
+  while ( NULL != slot->next ) {
+    interrupt_slot_ptr_t current = slot->next;
     // handle match
-    if ( wrapper->callback == callback ) {
-      match = current;
-      break;
+    if ( current->callback == callback ) {
+      // unlink and free
+      slot->next = current->next;
+      free( ( void* )current );
+      return;
     }
     // get to next
-    current = current->next;
+    slot = current;
   }
-
-  // handle no match
-  if ( NULL == match ) {
-    return;
-  }
-  // free allocated wrapper
-  free( match->data );
-  // remove element
-  list_remove( list, match );
 }
 
 /**
@@ -246,92 +187,53 @@ void interrupt_register_handler(
     assert( interrupt_validate_number( num ) );
   }
 
-  // get correct tree to use
-  avl_tree_ptr_t tree = tree_by_type( type );
+  // get block
+  interrupt_block_ptr_t block = block_by_type( type, num );
   // assert return
-  assert( NULL != tree );
-  // debug output
-  #if defined( PRINT_INTERRUPT )
-    DEBUG_OUTPUT(
-      "Using interrupt tree \"%p\" for lookup!\r\n", ( void* )tree );
-  #endif
+  assert( NULL != block );
 
-  // try to find node
-  avl_node_ptr_t node = avl_find_by_data( tree, ( void* )num );
-  interrupt_block_ptr_t block;
-  // debug output
-  #if defined( PRINT_INTERRUPT )
-    DEBUG_OUTPUT( "Found node %p\r\n", ( void* )node );
-  #endif
-  // handle not yet added
-  if ( NULL == node ) {
-    // allocate block
-    block = ( interrupt_block_ptr_t )malloc( sizeof( interrupt_block_t ) );
-    // assert initialization
-    assert( NULL != block );
-    // prepare memory
-    memset( ( void* )block, 0, sizeof( interrupt_block_t ) );
-    // debug output
-    #if defined( PRINT_INTERRUPT )
-      DEBUG_OUTPUT( "Initialized new node at %p\r\n", ( void* )block );
-    #endif
-    // populate block
-    block->interrupt = num;
-    block->handler = list_construct();
-    block->post = list_construct();
-    // prepare and insert node
-    avl_prepare_node( &block->node, ( void* )num );
-    avl_insert_by_node( tree, &block->node );
-  // existing? => gather block
-  } else {
-    block = INTERRUPT_GET_BLOCK( node );
+  // get inline slot
+  interrupt_slot_ptr_t slot = true != post ? &block->handler : &block->post;
+  // use inline slot if free
+  if ( NULL == slot->callback ) {
+    slot->callback = callback;
+    return;
   }
 
   // debug output
-  #if defined( PRINT_EVENT )
+  #if defined( PRINT_INTERRUPT )
     DEBUG_OUTPUT( "Checking for already bound interrupt callback\r\n" );
   #endif
-  // get first element
-  list_manager_ptr_t list = true != post
-    ? block->handler : block->post;
-  list_item_ptr_t current = list->first;
-  // debug output
-  #if defined( PRINT_EVENT )
-    DEBUG_OUTPUT( "Used first element for looping at %p\r\n", ( void* )current );
-  #endif
-  // loop through list for check callback
-  while ( NULL != current ) {
-    // get callback from data
-    interrupt_callback_wrapper_ptr_t wrapper =
-      ( interrupt_callback_wrapper_ptr_t )current->data;
-    // debug output
-    #if defined( PRINT_EVENT )
-      DEBUG_OUTPUT( "Check bound callback at %p\r\n", ( void* )wrapper );
-    #endif
+  // loop through chain for check callback
+  while ( true ) {
     // handle match
-    if ( wrapper->callback == callback ) {
+    if ( slot->callback == callback ) {
       return;
     }
+    // stop at end of chain
+    if ( NULL == slot->next ) {
+      break;
+    }
     // get to next
-    current = current->next;
+    slot = slot->next;
   }
 
-  // create wrapper
-  interrupt_callback_wrapper_ptr_t wrapper = ( interrupt_callback_wrapper_ptr_t )
-    malloc( sizeof( interrupt_callback_wrapper_t ) );
+  // create overflow slot for shared line
+  interrupt_slot_ptr_t overflow = ( interrupt_slot_ptr_t )malloc(
+    sizeof( interrupt_slot_t ) );
   // assert initialization
-  assert( NULL != wrapper );
+  assert( NULL != overflow );
   // prepare memory
-  memset( ( void* )wrapper, 0, sizeof( interrupt_callback_wrapper_t ) );
-  // populate wrapper
-  wrapper->callback = callback;
+  memset( ( void* )overflow, 0, sizeof( interrupt_slot_t ) );
+  // populate slot
+  overflow->callback = callback;
   // debug output
   #if defined( PRINT_INTERRUPT )
-    DEBUG_OUTPUT( "Created wrapper container at %p\r\n", ( void* )wrapper );
+    DEBUG_OUTPUT( "Created overflow slot at %p\r\n", ( void* )overflow );
   #endif
 
-  // push to list
-  list_push_back( list, ( void* )wrapper );
+  // append to chain
+  slot->next = overflow;
 }
 
 /**
@@ -342,11 +244,6 @@ void interrupt_register_handler(
  * @param context interrupt context
  */
 void interrupt_handle( size_t num, interrupt_type_t type, void* context ) {
-  // handle no interrupt manager as not bound
-  if ( NULL == interrupt_manager ) {
-    return;
-  }
-
   // validate interrupt number by vendor
   if ( type == INTERRUPT_NORMAL || type == INTERRUPT_FAST ) {
     assert( interrupt_validate_number( num ) );
@@ -357,77 +254,47 @@ void interrupt_handle( size_t num, interrupt_type_t type, void* context ) {
     DEBUG_OUTPUT( "Handle interrupt %zu\r\n", num );
   #endif
 
-  // get correct tree to use
-  avl_tree_ptr_t tree = tree_by_type( type );
-  // assert return
-  assert( NULL != tree );
-
-  // debug output
-  #if defined( PRINT_INTERRUPT )
-    DEBUG_OUTPUT( "Using interrupt tree \"%p\" for lookup!\r\n", ( void* )tree );
-  #endif
-
-  // try to get node by interrupt
-  avl_node_ptr_t node = avl_find_by_data( tree, ( void* )num );
-  // debug output
-  #if defined( PRINT_INTERRUPT )
-    DEBUG_OUTPUT( "Found node %p\r\n", ( void* )node );
-  #endif
-
-  // handle nothing found which means nothing bound
-  if ( NULL == node ) {
+  // get block, nothing bound for invalid numbers
+  interrupt_block_ptr_t block = block_by_type( type, num );
+  if ( NULL == block ) {
     return;
   }
-  // get interrupt block
-  interrupt_block_ptr_t block = INTERRUPT_GET_BLOCK( node );
 
-  // get first element of normal handler
-  list_item_ptr_t current = block->handler->first;
-  // debug output
-  #if defined( PRINT_INTERRUPT )
-    DEBUG_OUTPUT( "Looping through mapped callbacks and execute them\r\n" );
-  #endif
-  // loop through list
-  while ( NULL != current ) {
-    // get callback from data
-    interrupt_callback_wrapper_ptr_t wrapper =
-      ( interrupt_callback_wrapper_ptr_t )current->data;
-    // debug output
-    #if defined( PRINT_INTERRUPT )
-      DEBUG_OUTPUT( "Handling wrapper container %p\r\n", ( void* )wrapper );
-    #endif
-    // fire with data
-    wrapper->callback( context );
-    // step to next
-    current = current->next;
-  }
+  // fire normal and post callbacks
+  fire( &block->handler, context );
+  fire( &block->post, context );
 
-  // get first element of post callbacks
-  current = block->post->first;
-  // debug output
-  #if defined( PRINT_INTERRUPT )
-    DEBUG_OUTPUT( "Looping through mapped callbacks and execute them\r\n" );
-  #endif
-  // loop through list
-  while ( NULL != current ) {
-    // get callback from data
-    interrupt_callback_wrapper_ptr_t wrapper =
-      ( interrupt_callback_wrapper_ptr_t )current->data;
-    // debug output
-    #if defined( PRINT_INTERRUPT )
-      DEBUG_OUTPUT( "Handling wrapper container %p\r\n", ( void* )wrapper );
-    #endif
-    // fire with data
-    wrapper->callback( context );
-    // step to next
-    current = current->next;
-  }
   // debug output
   #if defined( PRINT_INTERRUPT )
     DEBUG_OUTPUT( "Handling of callbacks finished!\r\n" );
   #endif
 }
 
+/**
+ * @brief Handle all pending normal interrupts
+ *
+ * @param context interrupt context
+ * @return size_t amount of handled interrupts
+ *
+ * @note Bounded by INTERRUPT_DRAIN_MAX, so that a source which isn't
+ * acknowledged by its handler cannot lock up the exception handler.
+ */
+size_t interrupt_handle_pending( void* context ) {
+  size_t count = 0;
+  int8_t interrupt;
+  // handle pending until nothing is left
+  while (
+    INTERRUPT_DRAIN_MAX > count
+    && -1 != ( interrupt = interrupt_get_pending( false ) )
+  ) {
+    // handle bound interrupt handlers
+    interrupt_handle( ( uint8_t )interrupt, INTERRUPT_NORMAL, context );
+    count++;
+  }
+  // return amount
+  return count;
+}
+
 /**
  * @brief Generic interrupt init method
  */
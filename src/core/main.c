@@ -33,9 +33,12 @@
 #include <core/mm/phys.h>
 #include <core/mm/virt.h>
 #include <core/mm/heap.h>
+#include <core/mm/slab.h>
+#include <core/mm/shared.h>
+#include <core/mm/cow.h>
 #include <core/event.h>
 #include <core/task/process.h>
-#include <core/syscall.h>
+#include <core/task/thread.h>
 
 #if defined( REMOTE_DEBUG )
   #include <core/serial.h>
@@ -110,19 +113,6 @@ noreturn void kernel_main( void ) {
     DEBUG_OUTPUT( "initrd = %p\r\n", ( void* )initrd_get_end_address() );
     DEBUG_OUTPUT( "size = %zo\r\n", initrd_get_size() );
     DEBUG_OUTPUT( "size = %zu\r\n", initrd_get_size() );
-
-    // set iterator
-    tar_header_ptr_t iter = ( tar_header_ptr_t )initrd;
-
-    // loop through tar
-    while ( ! tar_end_reached( iter ) ) {
-      // debug output
-      DEBUG_OUTPUT( "%p: initrd file name: %s\r\n",
-        ( void* )iter, iter->file_name );
-
-      // next
-      iter = tar_next( iter );
-    }
   }
 
   uintptr_t atag_fdt = ( uintptr_t )firmware_info.atag_fdt;
@@ -136,6 +126,10 @@ noreturn void kernel_main( void ) {
   DEBUG_OUTPUT( "[bolthur/kernel -> memory -> virtual] initialize ...\r\n" );
   virt_init();
 
+  // Decompress initrd if necessary
+  DEBUG_OUTPUT( "[bolthur/kernel -> initrd] decompress ...\r\n" );
+  initrd_decompress();
+
   // print size
   if ( initrd_exist() ) {
     uintptr_t initrd = initrd_get_start_address();
@@ -143,19 +137,6 @@ noreturn void kernel_main( void ) {
     DEBUG_OUTPUT( "initrd = %p\r\n", ( void* )initrd_get_end_address() );
     DEBUG_OUTPUT( "size = %zo\r\n", initrd_get_size() );
     DEBUG_OUTPUT( "size = %zu\r\n", initrd_get_size() );
-
-    // set iterator
-    tar_header_ptr_t iter = ( tar_header_ptr_t )initrd;
-
-    // loop through tar
-    while ( ! tar_end_reached( iter ) ) {
-      // debug output
-      DEBUG_OUTPUT( "%p: initrd file name: %s\r\n",
-        ( void* )iter, iter->file_name );
-
-      // next
-      iter = tar_next( iter );
-    }
   }
 
   atag_fdt = ( uintptr_t )firmware_info.atag_fdt;
@@ -171,43 +152,67 @@ noreturn void kernel_main( void ) {
   DEBUG_OUTPUT( "[bolthur/kernel -> memory -> heap] initialize ...\r\n" );
   heap_init( HEAP_INIT_NORMAL );
 
+  // Setup slab allocator for small objects
+  DEBUG_OUTPUT( "[bolthur/kernel -> memory -> slab] initialize ...\r\n" );
+  slab_init();
+
+  // Setup shared memory objects
+  DEBUG_OUTPUT( "[bolthur/kernel -> memory -> shared] initialize ...\r\n" );
+  shared_init();
+
+  // Setup copy on write tracking
+  DEBUG_OUTPUT( "[bolthur/kernel -> memory -> cow] initialize ...\r\n" );
+  cow_init();
+
+  // Build initrd file index once
+  DEBUG_OUTPUT( "[bolthur/kernel -> initrd -> index] initialize ...\r\n" );
+  initrd_index_init();
+
   // Setup multitasking
   DEBUG_OUTPUT( "[bolthur/kernel -> process] initialize ...\r\n" );
   task_process_init();
 
-  // setup syscalls
-  DEBUG_OUTPUT( "[bolthur/kernel -> syscall] initialize ...\r\n" );;
-  syscall_init();
-
   // FIXME: Create init process from initialramdisk and pass initrd to init process
   // create processes for elf files
-  if ( initrd_exist() ) {
-    // get iterator
-    tar_header_ptr_t iter = ( tar_header_ptr_t )initrd_get_start_address();
-
-    // loop
-    while ( ! tar_end_reached( iter ) ) {
+  tar_index_ptr_t index = initrd_index_get();
+  if ( NULL != index ) {
+    // loop through indexed files
+    for (
+      tar_index_entry_ptr_t entry = tar_index_next( index, "", NULL );
+      NULL != entry;
+      entry = tar_index_next( index, "", entry )
+    ) {
       // get file
-      DEBUG_OUTPUT( "Current file %s\r\n", iter->file_name );
-      uintptr_t file = ( uintptr_t )tar_file( iter );
+      DEBUG_OUTPUT( "Current file %s\r\n", entry->header->file_name );
+      uintptr_t file = ( uintptr_t )entry->data;
 
       // skip non elf files
       if ( elf_check( file ) ) {
         // create process
-        uint64_t file_size = tar_size( iter );
-        DEBUG_OUTPUT( "Create process for file %s\r\n", iter->file_name );
-        DEBUG_OUTPUT( "File size: %#llx\r\n", file_size );
-
-        task_process_create( file, 0 );
-        task_process_create( file, 0 );
-        task_process_create( file, 0 );
+        DEBUG_OUTPUT( "Create process for file %s\r\n",
+          entry->header->file_name );
+        DEBUG_OUTPUT( "File size: %#llx\r\n", entry->size );
+
+        task_process_ptr_t template = task_process_create( file, 0 );
+        // spawn further workers sharing pages of template
+        if ( NULL != template ) {
+          task_thread_ptr_t thread = TASK_THREAD_GET_BLOCK(
+            template->thread_manager->root );
+          task_process_fork( thread );
+          task_process_fork( thread );
+        }
       }
-
-      // next task
-      iter = tar_next( iter );
     }
   }
 
+  // Release initrd pages not needed by created processes
+  DEBUG_OUTPUT( "[bolthur/kernel -> initrd] reclaim ...\r\n" );
+  initrd_reclaim();
+
+  // Release bootstrap code and data
+  DEBUG_OUTPUT( "[bolthur/kernel -> memory -> virtual] reclaim bootstrap ...\r\n" );
+  virt_bootstrap_reclaim();
+
   // Setup timer
   DEBUG_OUTPUT( "[bolthur/kernel -> timer] initialize ...\r\n" );
   timer_init();
@@ -0,0 +1,392 @@
+
+/**
+ * Copyright (C) 2018 - 2020 bolthur project.
+ *
+ * This file is part of bolthur/kernel.
+ *
+ * bolthur/kernel is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * bolthur/kernel is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <core/debug/debug.h>
+#include <core/mm/buddy.h>
+
+/**
+ * @brief Buddy manager
+ */
+static phys_buddy_manager_t buddy_manager;
+
+/**
+ * @brief static initialized flag
+ */
+static bool buddy_initialized = false;
+
+/**
+ * @brief Helper to check whether block of order is free
+ *
+ * @param order order
+ * @param block block index within order
+ * @return true
+ * @return false
+ */
+static bool block_free( size_t order, size_t block ) {
+  phys_buddy_order_ptr_t current = &buddy_manager.order[ order ];
+
+  // blocks outside are never free
+  if ( block >= current->block_count ) {
+    return false;
+  }
+
+  // check bit
+  return current->map[ block / PHYS_BUDDY_BITS_PER_ENTRY ]
+    & ( 1U << ( block % PHYS_BUDDY_BITS_PER_ENTRY ) );
+}
+
+/**
+ * @brief Helper to mark block of order as free
+ *
+ * @param order order
+ * @param block block index within order
+ */
+static void block_mark_free( size_t order, size_t block ) {
+  phys_buddy_order_ptr_t current = &buddy_manager.order[ order ];
+  size_t index = block / PHYS_BUDDY_BITS_PER_ENTRY;
+
+  // assert valid and not yet free block
+  assert( block < current->block_count );
+  assert( ! block_free( order, block ) );
+
+  // set bit within map and summary
+  current->map[ index ] |= 1U << ( block % PHYS_BUDDY_BITS_PER_ENTRY );
+  current->summary[ index / PHYS_BUDDY_BITS_PER_ENTRY ] |=
+    1U << ( index % PHYS_BUDDY_BITS_PER_ENTRY );
+  // increase free count
+  current->free_count++;
+}
+
+/**
+ * @brief Helper to mark block of order as used
+ *
+ * @param order order
+ * @param block block index within order
+ */
+static void block_mark_used( size_t order, size_t block ) {
+  phys_buddy_order_ptr_t current = &buddy_manager.order[ order ];
+  size_t index = block / PHYS_BUDDY_BITS_PER_ENTRY;
+
+  // assert free block
+  assert( block_free( order, block ) );
+
+  // clear bit within map
+  current->map[ index ] &= ~( 1U << ( block % PHYS_BUDDY_BITS_PER_ENTRY ) );
+  // clear summary bit if whole entry is used now
+  if ( 0 == current->map[ index ] ) {
+    current->summary[ index / PHYS_BUDDY_BITS_PER_ENTRY ] &=
+      ~( 1U << ( index % PHYS_BUDDY_BITS_PER_ENTRY ) );
+  }
+  // decrease free count
+  current->free_count--;
+}
+
+/**
+ * @brief Helper to find first free block of order
+ *
+ * @param order order
+ * @return size_t block index or PHYS_BUDDY_INVALID_FRAME
+ */
+static size_t block_find( size_t order ) {
+  phys_buddy_order_ptr_t current = &buddy_manager.order[ order ];
+
+  // skip empty orders
+  if ( 0 == current->free_count ) {
+    return PHYS_BUDDY_INVALID_FRAME;
+  }
+
+  // loop through summary, each bit covers one map entry
+  for ( size_t idx = 0; idx < current->summary_length; idx++ ) {
+    // skip entries without free blocks
+    if ( 0 == current->summary[ idx ] ) {
+      continue;
+    }
+
+    // determine map entry and block within entry
+    size_t index = idx * PHYS_BUDDY_BITS_PER_ENTRY
+      + ( size_t )__builtin_ctz( current->summary[ idx ] );
+    return index * PHYS_BUDDY_BITS_PER_ENTRY
+      + ( size_t )__builtin_ctz( current->map[ index ] );
+  }
+
+  // free count and summary out of sync
+  assert( false );
+  return PHYS_BUDDY_INVALID_FRAME;
+}
+
+/**
+ * @brief Initialize buddy allocator with all frames used
+ *
+ * @param frame_count amount of physical frames to manage
+ */
+void phys_buddy_init( size_t frame_count ) {
+  // assert not yet initialized
+  assert( ! buddy_initialized );
+
+  // clear manager
+  memset( &buddy_manager, 0, sizeof( phys_buddy_manager_t ) );
+  // set frame count
+  buddy_manager.frame_count = frame_count;
+
+  // setup orders
+  for ( size_t order = 0; order < PHYS_BUDDY_ORDER_SIZE; order++ ) {
+    phys_buddy_order_ptr_t current = &buddy_manager.order[ order ];
+
+    // calculate lengths
+    current->block_count = frame_count >> order;
+    current->map_length = current->block_count / PHYS_BUDDY_BITS_PER_ENTRY + 1;
+    current->summary_length =
+      current->map_length / PHYS_BUDDY_BITS_PER_ENTRY + 1;
+
+    // allocate map and summary
+    current->map = ( uint32_t* )malloc(
+      current->map_length * sizeof( uint32_t ) );
+    current->summary = ( uint32_t* )malloc(
+      current->summary_length * sizeof( uint32_t ) );
+    assert( NULL != current->map && NULL != current->summary );
+
+    // mark everything as used
+    memset( current->map, 0, current->map_length * sizeof( uint32_t ) );
+    memset(
+      current->summary, 0, current->summary_length * sizeof( uint32_t ) );
+
+    // debug output
+    #if defined( PRINT_MM_PHYS )
+      DEBUG_OUTPUT(
+        "order: %zu, blocks: %zu, map: %p, summary: %p\r\n",
+        order, current->block_count,
+        ( void* )current->map, ( void* )current->summary
+      );
+    #endif
+  }
+
+  // set initialized
+  buddy_initialized = true;
+}
+
+/**
+ * @brief Get initialized flag
+ *
+ * @return true
+ * @return false
+ */
+bool phys_buddy_init_get( void ) {
+  return buddy_initialized;
+}
+
+/**
+ * @brief Determine smallest order covering amount of frames
+ *
+ * @param frame_amount amount of frames
+ * @return size_t order
+ */
+size_t phys_buddy_order( size_t frame_amount ) {
+  size_t order = 0;
+
+  // increase order until it fits
+  while ( ( ( size_t )1 << order ) < frame_amount ) {
+    order++;
+  }
+
+  // return order
+  return order;
+}
+
+/**
+ * @brief Allocate naturally aligned block of order
+ *
+ * @param order order to allocate
+ * @return size_t first frame of block or PHYS_BUDDY_INVALID_FRAME
+ */
+size_t phys_buddy_allocate( size_t order ) {
+  size_t current, block;
+
+  // handle not initialized or invalid order
+  if ( ! buddy_initialized || PHYS_BUDDY_MAX_ORDER < order ) {
+    return PHYS_BUDDY_INVALID_FRAME;
+  }
+
+  // find smallest order with free block
+  block = PHYS_BUDDY_INVALID_FRAME;
+  for ( current = order; current < PHYS_BUDDY_ORDER_SIZE; current++ ) {
+    block = block_find( current );
+    if ( PHYS_BUDDY_INVALID_FRAME != block ) {
+      break;
+    }
+  }
+  // handle out of memory
+  if ( PHYS_BUDDY_INVALID_FRAME == block ) {
+    return PHYS_BUDDY_INVALID_FRAME;
+  }
+
+  // take block
+  block_mark_used( current, block );
+  // split down to requested order, upper half is returned as free
+  while ( current > order ) {
+    current--;
+    block <<= 1;
+    block_mark_free( current, block + 1 );
+  }
+
+  // debug output
+  #if defined( PRINT_MM_PHYS )
+    DEBUG_OUTPUT( "order: %zu, frame: %zu\r\n", order, block << order );
+  #endif
+
+  // return frame
+  return block << order;
+}
+
+/**
+ * @brief Free naturally aligned block of order with merge
+ *
+ * @param frame first frame of block
+ * @param order order of block
+ */
+void phys_buddy_free( size_t frame, size_t order ) {
+  size_t block, buddy;
+
+  // skip if not initialized
+  if ( ! buddy_initialized ) {
+    return;
+  }
+
+  // assert valid parameters
+  assert( PHYS_BUDDY_MAX_ORDER >= order );
+  assert( 0 == frame % ( ( size_t )1 << order ) );
+
+  // debug output
+  #if defined( PRINT_MM_PHYS )
+    DEBUG_OUTPUT( "order: %zu, frame: %zu\r\n", order, frame );
+  #endif
+
+  // merge with free buddies as long as possible
+  block = frame >> order;
+  while ( PHYS_BUDDY_MAX_ORDER > order ) {
+    buddy = block ^ 1;
+    // stop if buddy is not free
+    if ( ! block_free( order, buddy ) ) {
+      break;
+    }
+    // take buddy and move up
+    block_mark_used( order, buddy );
+    block >>= 1;
+    order++;
+  }
+
+  // mark merged block as free
+  block_mark_free( order, block );
+}
+
+/**
+ * @brief Free arbitrary frame range by splitting into aligned blocks
+ *
+ * @param frame first frame
+ * @param amount amount of frames
+ */
+void phys_buddy_free_range( size_t frame, size_t amount ) {
+  size_t order;
+
+  // loop until everything has been freed
+  while ( 0 < amount ) {
+    // determine biggest aligned block fitting into the range
+    order = 0;
+    while (
+      PHYS_BUDDY_MAX_ORDER > order
+      && 0 == frame % ( ( size_t )1 << ( order + 1 ) )
+      && ( ( size_t )1 << ( order + 1 ) ) <= amount
+    ) {
+      order++;
+    }
+
+    // free block
+    phys_buddy_free( frame, order );
+    // next block
+    frame += ( size_t )1 << order;
+    amount -= ( size_t )1 << order;
+  }
+}
+
+/**
+ * @brief Remove single free frame from buddy allocator
+ *
+ * @param frame frame to claim
+ * @return true frame was free and has been claimed
+ * @return false frame was not free
+ */
+bool phys_buddy_claim( size_t frame ) {
+  size_t target;
+
+  // skip if not initialized
+  if ( ! buddy_initialized ) {
+    return false;
+  }
+
+  // find free block containing the frame
+  for ( size_t order = 0; order < PHYS_BUDDY_ORDER_SIZE; order++ ) {
+    size_t block = frame >> order;
+    // skip if not free
+    if ( ! block_free( order, block ) ) {
+      continue;
+    }
+
+    // take block
+    block_mark_used( order, block );
+    // split down and return halves not containing the frame
+    while ( 0 < order ) {
+      order--;
+      target = frame >> order;
+      block_mark_free( order, target ^ 1 );
+    }
+
+    // debug output
+    #if defined( PRINT_MM_PHYS )
+      DEBUG_OUTPUT( "claimed frame: %zu\r\n", frame );
+    #endif
+    // return success
+    return true;
+  }
+
+  // frame not free
+  return false;
+}
+
+/**
+ * @brief Get amount of free frames
+ *
+ * @return size_t amount of free frames
+ */
+size_t phys_buddy_free_frames( void ) {
+  size_t amount = 0;
+
+  // sum up all orders
+  for ( size_t order = 0; order < PHYS_BUDDY_ORDER_SIZE; order++ ) {
+    amount += buddy_manager.order[ order ].free_count << order;
+  }
+
+  // return amount
+  return amount;
+}
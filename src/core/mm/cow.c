@@ -0,0 +1,214 @@
+
+/**
+ * Copyright (C) 2018 - 2020 bolthur project.
+ *
+ * This file is part of bolthur/kernel.
+ *
+ * bolthur/kernel is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * bolthur/kernel is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <core/entry.h>
+#include <core/debug/debug.h>
+#include <core/mm/phys.h>
+#include <core/mm/virt.h>
+#include <core/mm/cow.h>
+#include <arch/arm/cache.h>
+
+/**
+ * @brief Frame number used as tree key, physical addresses may exceed 32 bit
+ */
+#define COW_FRAME( p ) ( ( void* )( uintptr_t )( ( p ) / PAGE_SIZE ) )
+
+/**
+ * @brief Tree of physical pages shared copy on write
+ */
+static avl_tree_ptr_t cow_tree = NULL;
+
+/**
+ * @brief Compare page frame callback necessary for avl tree
+ *
+ * @param a node a
+ * @param b node b
+ * @return int32_t
+ */
+static int32_t cow_compare_page_callback(
+  const avl_node_ptr_t a,
+  const avl_node_ptr_t b
+) {
+  // -1 if frame of a is greater than frame of b
+  if ( ( uintptr_t )a->data > ( uintptr_t )b->data ) {
+    return -1;
+  // 1 if frame of b is greater than frame of a
+  } else if ( ( uintptr_t )b->data > ( uintptr_t )a->data ) {
+    return 1;
+  }
+
+  // equal => return 0
+  return 0;
+}
+
+/**
+ * @brief Helper to get tracking entry of physical page
+ *
+ * @param page physical page
+ * @return cow_page_ptr_t found entry or NULL
+ */
+static cow_page_ptr_t cow_get( uint64_t page ) {
+  // find node by frame number
+  avl_node_ptr_t node = avl_find_by_data( cow_tree, COW_FRAME( page ) );
+  // return entry or null
+  return NULL != node ? COW_GET_BLOCK( node ) : NULL;
+}
+
+/**
+ * @brief Initialize copy on write tracking
+ */
+void cow_init( void ) {
+  // assert not initialized
+  assert( NULL == cow_tree );
+  // create tree
+  cow_tree = avl_create_tree( cow_compare_page_callback );
+  // assert tree creation
+  assert( NULL != cow_tree );
+}
+
+/**
+ * @brief Share mapped pages of range read only between two contexts
+ *
+ * Both mappings become read only, so the first write of either side
+ * duplicates the page within cow_fault.
+ *
+ * @param source context to clone from
+ * @param target context to clone into
+ * @param start page aligned start address
+ * @param size size of range
+ * @param page page attributes of range
+ */
+void cow_clone_range(
+  virt_context_ptr_t source,
+  virt_context_ptr_t target,
+  uintptr_t start,
+  size_t size,
+  uint32_t page
+) {
+  for ( uintptr_t address = start; address < start + size; address += PAGE_SIZE ) {
+    // skip not yet populated pages and pages shared by an earlier region
+    if (
+      ! virt_is_mapped_in_context( source, address )
+      || virt_is_mapped_in_context( target, address )
+    ) {
+      continue;
+    }
+
+    // get physical page
+    uint64_t physical = virt_get_mapped_address_in_context( source, address );
+    // read only pages are never written, so they're shared without tracking
+    if ( page & VIRT_PAGE_TYPE_READ_ONLY ) {
+      virt_map_address(
+        target, address, physical, VIRT_MEMORY_TYPE_NORMAL, page );
+      continue;
+    }
+    // get or create tracking entry, the source is the first reference
+    cow_page_ptr_t entry = cow_get( physical );
+    if ( NULL == entry ) {
+      entry = ( cow_page_ptr_t )malloc( sizeof( cow_page_t ) );
+      assert( NULL != entry );
+      entry->page = physical;
+      entry->reference = 1;
+      avl_prepare_node( &entry->node, COW_FRAME( physical ) );
+      avl_insert_by_node( cow_tree, &entry->node );
+      // remap source read only
+      virt_unmap_address( source, address, false );
+      virt_map_address(
+        source, address, physical, VIRT_MEMORY_TYPE_NORMAL,
+        page | VIRT_PAGE_TYPE_READ_ONLY );
+    }
+
+    // map read only into target
+    virt_map_address(
+      target, address, physical, VIRT_MEMORY_TYPE_NORMAL,
+      page | VIRT_PAGE_TYPE_READ_ONLY );
+    entry->reference++;
+  }
+
+  // debug output
+  #if defined( PRINT_MM_VIRT )
+    DEBUG_OUTPUT( "Cloned range %p - %p copy on write\r\n",
+      ( void* )start, ( void* )( start + size ) );
+  #endif
+}
+
+/**
+ * @brief Handle write fault on copy on write page
+ *
+ * @param ctx faulting context
+ * @param address faulting address
+ * @param page page attributes used for writable mapping
+ * @return true if page has been made writable
+ * @return false if page is not shared copy on write
+ */
+bool cow_fault( virt_context_ptr_t ctx, uintptr_t address, uint32_t page ) {
+  address -= address % PAGE_SIZE;
+  // ensure mapping
+  if ( ! virt_is_mapped_in_context( ctx, address ) ) {
+    return false;
+  }
+  // get tracking entry
+  uint64_t physical = virt_get_mapped_address_in_context( ctx, address );
+  cow_page_ptr_t entry = cow_get( physical );
+  // not shared, so a real permission fault
+  if ( NULL == entry ) {
+    return false;
+  }
+
+  // debug output
+  #if defined( PRINT_MM_VIRT )
+    DEBUG_OUTPUT( "Copy on write fault at %p, references: %zu\r\n",
+      ( void* )address, entry->reference );
+  #endif
+
+  // remove read only mapping
+  virt_unmap_address( ctx, address, false );
+  entry->reference--;
+
+  // last reference takes over page without copy
+  if ( 0 == entry->reference ) {
+    avl_remove_by_node( cow_tree, &entry->node );
+    free( entry );
+  // duplicate page for faulting context
+  } else {
+    uint64_t copy = phys_find_free_page( PAGE_SIZE );
+    assert( 0 != copy );
+    uintptr_t from = virt_map_temporary( physical, PAGE_SIZE );
+    uintptr_t to = virt_map_temporary( copy, PAGE_SIZE );
+    memcpy( ( void* )to, ( void* )from, PAGE_SIZE );
+    // push copied code to point of unification and drop stale instructions
+    if ( page & VIRT_PAGE_TYPE_EXECUTABLE ) {
+      cache_clean_range( to, PAGE_SIZE );
+      cache_invalidate_instruction_cache();
+      cache_invalidate_branch_predictor();
+    }
+    virt_unmap_temporary( to, PAGE_SIZE );
+    virt_unmap_temporary( from, PAGE_SIZE );
+    physical = copy;
+  }
+
+  // map writable again
+  virt_map_address( ctx, address, physical, VIRT_MEMORY_TYPE_NORMAL, page );
+  // return success
+  return true;
+}
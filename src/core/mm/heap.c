@@ -243,27 +243,21 @@ static void extend_heap_space( void ) {
   // assert size against max size
   assert( heap_size + HEAP_EXTENSION < HEAP_MAX_SIZE );
 
-  // map heap address space
-  for (
-    uintptr_t addr = heap_end;
-    addr < heap_end + HEAP_EXTENSION;
-    addr += PAGE_SIZE
-  ) {
-    // debug output
-    #if defined( PRINT_MM_HEAP )
-      DEBUG_OUTPUT( "Map %p with random physical address\r\n", ( void* )addr );
-    #endif
+  // debug output
+  #if defined( PRINT_MM_HEAP )
+    DEBUG_OUTPUT( "Map %p with random physical address\r\n", ( void* )heap_end );
+  #endif
 
-    // map address
-    virt_map_address_random(
-      kernel_context,
-      addr,
-      VIRT_MEMORY_TYPE_NORMAL,
-      VIRT_PAGE_TYPE_NON_EXECUTABLE );
+  // map heap address space
+  virt_map_range_random(
+    kernel_context,
+    heap_end,
+    HEAP_EXTENSION,
+    VIRT_MEMORY_TYPE_NORMAL,
+    VIRT_PAGE_TYPE_NON_EXECUTABLE );
 
-    // clear area
-    memset( ( void* )addr, 0, PAGE_SIZE );
-  }
+  // clear area
+  memset( ( void* )heap_end, 0, HEAP_EXTENSION );
 
   // extend free block
   if ( max == max_free ) {
@@ -414,13 +408,12 @@ static void shrink_heap_space( void ) {
   avl_insert_by_node( free_size, &max_block->node_size );
 
   // free up virtual memory
-  for (
-    uintptr_t start = max_block->address + max_block->size;
-    start < max_end;
-    start += PAGE_SIZE
-  ) {
-    virt_unmap_address( kernel_context, start, true );
-  }
+  virt_unmap_range(
+    kernel_context,
+    max_block->address + max_block->size,
+    max_end - ( max_block->address + max_block->size ),
+    true
+  );
 
   // Debug output
   #if defined( PRINT_MM_HEAP )
@@ -576,23 +569,18 @@ void heap_init( heap_init_state_t state ) {
 
   // map heap address space
   if ( HEAP_INIT_NORMAL == state ) {
-    for (
-      uintptr_t addr = start;
-      addr < start + min_size;
-      addr += PAGE_SIZE
-    ) {
-      // debug output
-      #if defined( PRINT_MM_HEAP )
-        DEBUG_OUTPUT( "Map %p with random physical address\r\n", ( void* )addr );
-      #endif
+    // debug output
+    #if defined( PRINT_MM_HEAP )
+      DEBUG_OUTPUT( "Map %p with random physical address\r\n", ( void* )start );
+    #endif
 
-      // map address
-      virt_map_address_random(
-        kernel_context,
-        addr,
-        VIRT_MEMORY_TYPE_NORMAL,
-        VIRT_PAGE_TYPE_NON_EXECUTABLE );
-    }
+    // map address range
+    virt_map_range_random(
+      kernel_context,
+      start,
+      min_size,
+      VIRT_MEMORY_TYPE_NORMAL,
+      VIRT_PAGE_TYPE_NON_EXECUTABLE );
   }
 
   // debug output
@@ -27,6 +27,7 @@
 #include <core/entry.h>
 #include <core/initrd.h>
 #include <core/mm/phys.h>
+#include <core/mm/buddy.h>
 
 /**
  * @brief Physical bitmap
@@ -44,11 +45,28 @@ uint32_t phys_bitmap_length;
 static bool phys_initialized = false;
 
 /**
- * @brief Mark physical page as used on arm
+ * @brief Helper to check whether page is marked as used within bitmap
  *
- * @param address address to mark as free
+ * @param address address to check
+ * @return true
+ * @return false
  */
-void phys_mark_page_used( uint64_t address ) {
+static bool bitmap_page_used( uint64_t address ) {
+  // get frame, index and offset
+  uint64_t frame = address / PAGE_SIZE;
+  uint64_t index = PAGE_INDEX( frame );
+  uint64_t offset = PAGE_OFFSET( frame );
+
+  // return used state
+  return phys_bitmap[ index ] & ( 1U << offset );
+}
+
+/**
+ * @brief Mark physical page as used within bitmap
+ *
+ * @param address address to mark as used
+ */
+static void bitmap_mark_page_used( uint64_t address ) {
   // get frame, index and offset
   uint64_t frame = address / PAGE_SIZE;
   uint64_t index = PAGE_INDEX( frame );
@@ -67,11 +85,11 @@ void phys_mark_page_used( uint64_t address ) {
 }
 
 /**
- * @brief Mark physical page as free on arm
+ * @brief Mark physical page as free within bitmap
  *
  * @param address address to mark as free
  */
-void phys_mark_page_free( uint64_t address ) {
+static void bitmap_mark_page_free( uint64_t address ) {
   // get frame, index and offset
   uint64_t frame = address / PAGE_SIZE;
   uint64_t index = PAGE_INDEX( frame );
@@ -89,6 +107,39 @@ void phys_mark_page_free( uint64_t address ) {
   #endif
 }
 
+/**
+ * @brief Mark physical page as used
+ *
+ * @param address address to mark as used
+ */
+void phys_mark_page_used( uint64_t address ) {
+  // remove from buddy allocator if still free
+  if ( phys_buddy_init_get() && ! bitmap_page_used( address ) ) {
+    bool claimed = phys_buddy_claim( ( size_t )( address / PAGE_SIZE ) );
+    // cross check bitmap with buddy allocator
+    assert( claimed );
+    ( void )claimed;
+  }
+
+  // mark within bitmap
+  bitmap_mark_page_used( address );
+}
+
+/**
+ * @brief Mark physical page as free
+ *
+ * @param address address to mark as free
+ */
+void phys_mark_page_free( uint64_t address ) {
+  // return to buddy allocator if used
+  if ( phys_buddy_init_get() && bitmap_page_used( address ) ) {
+    phys_buddy_free( ( size_t )( address / PAGE_SIZE ), 0 );
+  }
+
+  // mark within bitmap
+  bitmap_mark_page_free( address );
+}
+
 /**
  * @brief Method to free phys page range
  *
@@ -101,13 +152,26 @@ void phys_free_page_range( uint64_t address, size_t amount ) {
     DEBUG_OUTPUT( "address: %#016llx, amount: %zu\r\n", address, amount );
   #endif
 
+  // return range to buddy allocator
+  if ( phys_buddy_init_get() ) {
+    // cross check bitmap, range has to be completely used
+    #if defined( PRINT_MM_PHYS )
+      for ( size_t idx = 0; idx < amount / PAGE_SIZE; idx++ ) {
+        assert( bitmap_page_used( address + idx * PAGE_SIZE ) );
+      }
+    #endif
+    // free range within buddy
+    phys_buddy_free_range(
+      ( size_t )( address / PAGE_SIZE ), amount / PAGE_SIZE );
+  }
+
   // loop until amount and mark as free
   for (
     size_t idx = 0;
     idx < amount / PAGE_SIZE;
     idx++, address += PAGE_SIZE
   ) {
-    phys_mark_page_free( address );
+    bitmap_mark_page_free( address );
   }
 }
 
@@ -144,13 +208,16 @@ void phys_use_page_range( uint64_t address, size_t amount ) {
 }
 
 /**
- * @brief Method to find free page range
+ * @brief Method to find free page range by scanning the bitmap
  *
  * @param alignment wanted memory alignment
  * @param memory_amount amount of memory to find free page range for
  * @return uint64_t address of found memory
  */
-uint64_t phys_find_free_page_range( size_t alignment, size_t memory_amount ) {
+static uint64_t bitmap_find_free_page_range(
+  size_t alignment,
+  size_t memory_amount
+) {
   // debug output
   #if defined( PRINT_MM_PHYS )
     DEBUG_OUTPUT(
@@ -229,6 +296,77 @@ uint64_t phys_find_free_page_range( size_t alignment, size_t memory_amount ) {
   return address;
 }
 
+/**
+ * @brief Method to find free page range
+ *
+ * @param alignment wanted memory alignment
+ * @param memory_amount amount of memory to find free page range for
+ * @return uint64_t address of found memory
+ */
+uint64_t phys_find_free_page_range( size_t alignment, size_t memory_amount ) {
+  size_t page_amount, order, frame;
+  uint64_t address;
+
+  // fallback to bitmap scan until buddy allocator is ready
+  if ( ! phys_buddy_init_get() ) {
+    return bitmap_find_free_page_range( alignment, memory_amount );
+  }
+
+  // round up to full page
+  if ( 0 < memory_amount % PAGE_SIZE ) {
+    memory_amount += PAGE_SIZE - ( memory_amount % PAGE_SIZE );
+  }
+  // determine amount of pages and necessary order
+  page_amount = memory_amount / PAGE_SIZE;
+  order = phys_buddy_order( page_amount );
+  // blocks are naturally aligned, so raise order for bigger alignments
+  if ( PAGE_SIZE < alignment ) {
+    // assert power of two alignment
+    assert( 0 == ( alignment & ( alignment - 1 ) ) );
+    size_t alignment_order = phys_buddy_order( alignment / PAGE_SIZE );
+    if ( alignment_order > order ) {
+      order = alignment_order;
+    }
+  }
+
+  // debug output
+  #if defined( PRINT_MM_PHYS )
+    DEBUG_OUTPUT(
+      "memory_amount: %zu, alignment: %#016zx, order: %zu\r\n",
+      memory_amount, alignment, order
+    );
+  #endif
+
+  // requests bigger than max order are served by bitmap scan
+  if ( PHYS_BUDDY_MAX_ORDER < order ) {
+    return bitmap_find_free_page_range( alignment, memory_amount );
+  }
+
+  // allocate block
+  frame = phys_buddy_allocate( order );
+  // assert found block
+  assert( PHYS_BUDDY_INVALID_FRAME != frame );
+  // return not needed tail of block
+  if ( ( ( size_t )1 << order ) > page_amount ) {
+    phys_buddy_free_range(
+      frame + page_amount,
+      ( ( size_t )1 << order ) - page_amount
+    );
+  }
+
+  // mark pages used within bitmap
+  address = ( uint64_t )frame * PAGE_SIZE;
+  for ( size_t idx = 0; idx < page_amount; idx++ ) {
+    // cross check bitmap with buddy allocator
+    assert( ! bitmap_page_used( address + idx * PAGE_SIZE ) );
+    // mark used
+    bitmap_mark_page_used( address + idx * PAGE_SIZE );
+  }
+
+  // return address
+  return address;
+}
+
 /**
  * @brief Shorthand to find single free page
  *
@@ -300,6 +438,35 @@ void phys_init( void ) {
     }
   }
 
+  // setup buddy allocator with all pages free within bitmap
+  phys_buddy_init( phys_bitmap_length * PAGE_PER_ENTRY );
+  for ( size_t idx = 0; idx < phys_bitmap_length * PAGE_PER_ENTRY; ) {
+    // skip used pages
+    if ( bitmap_page_used( ( uint64_t )idx * PAGE_SIZE ) ) {
+      idx++;
+      continue;
+    }
+
+    // determine length of free run
+    size_t run = idx;
+    while (
+      run < phys_bitmap_length * PAGE_PER_ENTRY
+      && ! bitmap_page_used( ( uint64_t )run * PAGE_SIZE )
+    ) {
+      run++;
+    }
+
+    // pass free run to buddy allocator
+    phys_buddy_free_range( idx, run - idx );
+    // continue after run
+    idx = run;
+  }
+
+  // debug output
+  #if defined( PRINT_MM_PHYS )
+    DEBUG_OUTPUT( "free pages: %zu\r\n", phys_buddy_free_frames() );
+  #endif
+
   // mark initialized
   phys_initialized = true;
 }
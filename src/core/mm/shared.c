@@ -0,0 +1,443 @@
+
+/**
+ * Copyright (C) 2018 - 2020 bolthur project.
+ *
+ * This file is part of bolthur/kernel.
+ *
+ * bolthur/kernel is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * bolthur/kernel is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <core/debug/debug.h>
+#include <core/mm/phys.h>
+#include <core/mm/virt.h>
+#include <core/mm/shared.h>
+#include <core/task/process.h>
+#include <core/task/region.h>
+
+/**
+ * @brief Tree of shared memory objects by id
+ */
+static avl_tree_ptr_t shared_tree = NULL;
+
+/**
+ * @brief Compare id callback necessary for avl tree
+ *
+ * @param a node a
+ * @param b node b
+ * @return int32_t
+ */
+static int32_t shared_compare_id_callback(
+  const avl_node_ptr_t a,
+  const avl_node_ptr_t b
+) {
+  // -1 if id of a is greater than id of b
+  if ( ( size_t )a->data > ( size_t )b->data ) {
+    return -1;
+  // 1 if id of b is greater than id of a
+  } else if ( ( size_t )b->data > ( size_t )a->data ) {
+    return 1;
+  }
+
+  // equal => return 0
+  return 0;
+}
+
+/**
+ * @brief Method to generate new shared memory id
+ *
+ * @return size_t generated id
+ */
+static size_t shared_generate_id( void ) {
+  // current id, starting after reserved ones
+  static size_t current = SHARED_ID_RESERVED;
+  // return new id by simple increment
+  return ++current;
+}
+
+/**
+ * @brief Helper to get shared memory object by id
+ *
+ * @param id object id
+ * @return shared_entry_ptr_t found object or NULL
+ */
+static shared_entry_ptr_t shared_get_entry( size_t id ) {
+  // find node in tree
+  avl_node_ptr_t node = avl_find_by_data( shared_tree, ( void* )id );
+  // handle not existing
+  if ( NULL == node ) {
+    return NULL;
+  }
+  // return object
+  return SHARED_GET_BLOCK_ID( node );
+}
+
+/**
+ * @brief Helper to validate a page aligned and completely unmapped user range
+ *
+ * Ranges overlapping process regions are refused, as region pages are
+ * populated on demand and shared copy on write by fork.
+ *
+ * @param process process to check
+ * @param address start address
+ * @param size range size
+ * @return true if range can take a mapping
+ * @return false if range is invalid
+ */
+static bool shared_validate_range(
+  task_process_ptr_t process,
+  uintptr_t address,
+  size_t size
+) {
+  // check alignment and user space bounds
+  if (
+    0 != address % PAGE_SIZE
+    || 0 == size
+    || address + size < address
+    || address + size > VIRT_USER_SPACE_END
+    || task_region_overlap( process, address, size )
+  ) {
+    return false;
+  }
+  // range has to be unmapped
+  for ( size_t offset = 0; offset < size; offset += PAGE_SIZE ) {
+    if ( virt_is_mapped_in_context(
+      process->virtual_context, address + offset
+    ) ) {
+      return false;
+    }
+  }
+  // return success
+  return true;
+}
+
+/**
+ * @brief Helper to create and insert a shared memory object
+ *
+ * @param id object id
+ * @param start physical start address
+ * @param size object size
+ * @param fixed flag whether backing memory is never freed
+ * @param type memory type used for mappings
+ * @return shared_entry_ptr_t created object
+ */
+static shared_entry_ptr_t shared_create_entry(
+  size_t id,
+  uint64_t start,
+  size_t size,
+  bool fixed,
+  virt_memory_type_t type
+) {
+  // allocate object
+  shared_entry_ptr_t entry = ( shared_entry_ptr_t )malloc(
+    sizeof( shared_entry_t ) );
+  // assert malloc result
+  assert( NULL != entry );
+  // prepare structure
+  memset( ( void* )entry, 0, sizeof( shared_entry_t ) );
+
+  // populate object
+  entry->id = id;
+  entry->start = start;
+  entry->size = size;
+  entry->fixed = fixed;
+  entry->type = type;
+  entry->mapping = list_construct();
+  // assert list creation
+  assert( NULL != entry->mapping );
+
+  // prepare and insert node
+  avl_prepare_node( &entry->node_id, ( void* )id );
+  avl_insert_by_node( shared_tree, &entry->node_id );
+
+  // debug output
+  #if defined( PRINT_MM_SHARED )
+    DEBUG_OUTPUT( "Created shared object %zu at %#llx with size %#zx\r\n",
+      id, start, size );
+  #endif
+
+  // return object
+  return entry;
+}
+
+/**
+ * @brief Helper to map shared memory object into context
+ *
+ * @param entry object to map
+ * @param ctx context to map into
+ * @param address virtual start address
+ */
+static void shared_map_entry(
+  shared_entry_ptr_t entry,
+  virt_context_ptr_t ctx,
+  uintptr_t address
+) {
+  // allocate mapping
+  shared_mapping_ptr_t mapping = ( shared_mapping_ptr_t )malloc(
+    sizeof( shared_mapping_t ) );
+  // assert malloc result
+  assert( NULL != mapping );
+
+  // map whole object
+  virt_map_range(
+    ctx, address, entry->start, entry->size, entry->type,
+    VIRT_PAGE_TYPE_NON_EXECUTABLE );
+
+  // populate and push mapping
+  mapping->context = ctx;
+  mapping->address = address;
+  list_push_back( entry->mapping, ( void* )mapping );
+  // increment reference count
+  entry->reference++;
+
+  // debug output
+  #if defined( PRINT_MM_SHARED )
+    DEBUG_OUTPUT( "Mapped shared object %zu at %p, references: %zu\r\n",
+      entry->id, ( void* )address, entry->reference );
+  #endif
+}
+
+/**
+ * @brief Initialize shared memory management
+ */
+void shared_init( void ) {
+  // assert not initialized
+  assert( NULL == shared_tree );
+
+  // create tree for managing objects by id
+  shared_tree = avl_create_tree( shared_compare_id_callback );
+  // assert tree creation
+  assert( NULL != shared_tree );
+
+  // register platform objects
+  shared_platform_init();
+}
+
+/**
+ * @brief Register fixed shared memory object that is never freed
+ *
+ * @param id reserved object id
+ * @param start physical start address
+ * @param size object size
+ * @param type memory type used for mappings
+ * @return true on success
+ * @return false if id is invalid or already in use
+ */
+bool shared_create_fixed(
+  size_t id,
+  uint64_t start,
+  size_t size,
+  virt_memory_type_t type
+) {
+  // check id and alignment
+  if (
+    0 == id
+    || SHARED_ID_RESERVED < id
+    || 0 != start % PAGE_SIZE
+    || NULL != shared_get_entry( id )
+  ) {
+    return false;
+  }
+
+  // round up to full page
+  if ( 0 < size % PAGE_SIZE ) {
+    size += PAGE_SIZE - ( size % PAGE_SIZE );
+  }
+
+  // create object
+  shared_create_entry( id, start, size, true, type );
+  // return success
+  return true;
+}
+
+/**
+ * @brief Create shared memory object and map it into process
+ *
+ * @param process creating process
+ * @param address virtual start address within creator
+ * @param size object size
+ * @return size_t object id or 0 on error
+ */
+size_t shared_create(
+  task_process_ptr_t process,
+  uintptr_t address,
+  size_t size
+) {
+  // round up to full page
+  if ( 0 < size % PAGE_SIZE ) {
+    size += PAGE_SIZE - ( size % PAGE_SIZE );
+  }
+  // validate target range
+  if ( ! shared_validate_range( process, address, size ) ) {
+    return 0;
+  }
+
+  // get physical memory
+  uint64_t start = phys_find_free_page_range( PAGE_SIZE, size );
+  // handle out of memory
+  if ( 0 == start ) {
+    return 0;
+  }
+
+  // map temporary and clear area
+  uintptr_t tmp = virt_map_temporary( start, size );
+  memset( ( void* )tmp, 0, size );
+  virt_unmap_temporary( tmp, size );
+
+  // create object and map it for creator
+  shared_entry_ptr_t entry = shared_create_entry(
+    shared_generate_id(), start, size, false, VIRT_MEMORY_TYPE_NORMAL );
+  shared_map_entry( entry, process->virtual_context, address );
+  // return id
+  return entry->id;
+}
+
+/**
+ * @brief Map existing shared memory object into process
+ *
+ * @param process process to map into
+ * @param id object id
+ * @param address virtual start address
+ * @return true on success
+ * @return false if object doesn't exist or range is invalid
+ */
+bool shared_map( task_process_ptr_t process, size_t id, uintptr_t address ) {
+  // get object
+  shared_entry_ptr_t entry = shared_get_entry( id );
+  // validate object and target range
+  if (
+    NULL == entry
+    || ! shared_validate_range( process, address, entry->size )
+  ) {
+    return false;
+  }
+
+  // map object
+  shared_map_entry( entry, process->virtual_context, address );
+  // return success
+  return true;
+}
+
+/**
+ * @brief Unmap shared memory object from context
+ *
+ * @param ctx context to unmap from
+ * @param id object id
+ * @param address virtual start address of mapping
+ * @return true on success
+ * @return false if no such mapping exists
+ */
+bool shared_unmap( virt_context_ptr_t ctx, size_t id, uintptr_t address ) {
+  // get object
+  shared_entry_ptr_t entry = shared_get_entry( id );
+  // handle not existing
+  if ( NULL == entry ) {
+    return false;
+  }
+
+  // find mapping
+  list_item_ptr_t item = entry->mapping->first;
+  while ( NULL != item ) {
+    shared_mapping_ptr_t mapping = ( shared_mapping_ptr_t )item->data;
+    if ( ctx == mapping->context && address == mapping->address ) {
+      break;
+    }
+    item = item->next;
+  }
+  // handle not mapped
+  if ( NULL == item ) {
+    return false;
+  }
+
+  // unmap without freeing backing memory
+  virt_unmap_range( ctx, address, entry->size, false );
+  // remove mapping
+  free( item->data );
+  list_remove( entry->mapping, item );
+  // decrement reference count
+  entry->reference--;
+
+  // debug output
+  #if defined( PRINT_MM_SHARED )
+    DEBUG_OUTPUT( "Unmapped shared object %zu at %p, references: %zu\r\n",
+      entry->id, ( void* )address, entry->reference );
+  #endif
+
+  // keep object while still referenced or fixed
+  if ( 0 < entry->reference || entry->fixed ) {
+    return true;
+  }
+
+  // free backing memory and object
+  phys_free_page_range( entry->start, entry->size );
+  avl_remove_by_node( shared_tree, &entry->node_id );
+  list_destruct( entry->mapping );
+  free( entry );
+  // return success
+  return true;
+}
+
+/**
+ * @brief Helper to check mappings of an object subtree
+ *
+ * @param node object tree node
+ * @param ctx context to check
+ * @param address address to check
+ * @return true if address is part of a mapping within context
+ * @return false otherwise
+ */
+static bool shared_is_mapped_node(
+  avl_node_ptr_t node,
+  virt_context_ptr_t ctx,
+  uintptr_t address
+) {
+  // handle end of tree
+  if ( NULL == node ) {
+    return false;
+  }
+  // get object
+  shared_entry_ptr_t entry = SHARED_GET_BLOCK_ID( node );
+  // loop through mappings
+  for (
+    list_item_ptr_t item = entry->mapping->first;
+    NULL != item;
+    item = item->next
+  ) {
+    shared_mapping_ptr_t mapping = ( shared_mapping_ptr_t )item->data;
+    if (
+      ctx == mapping->context
+      && address >= mapping->address
+      && address < mapping->address + entry->size
+    ) {
+      return true;
+    }
+  }
+  // check children
+  return shared_is_mapped_node( node->left, ctx, address )
+    || shared_is_mapped_node( node->right, ctx, address );
+}
+
+/**
+ * @brief Check whether address belongs to a shared memory mapping
+ *
+ * @param ctx context to check
+ * @param address address to check
+ * @return true if address is part of a shared memory mapping
+ * @return false otherwise
+ */
+bool shared_is_mapped( virt_context_ptr_t ctx, uintptr_t address ) {
+  return shared_is_mapped_node( shared_tree->root, ctx, address );
+}
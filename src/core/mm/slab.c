@@ -0,0 +1,485 @@
+
+/**
+ * Copyright (C) 2018 - 2020 bolthur project.
+ *
+ * This file is part of bolthur/kernel.
+ *
+ * bolthur/kernel is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * bolthur/kernel is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <core/debug/debug.h>
+#include <core/panic.h>
+#include <core/mm/phys.h>
+#include <core/mm/virt.h>
+#include <core/mm/slab.h>
+
+/**
+ * @brief Slab manager
+ */
+static slab_manager_t slab_manager;
+
+/**
+ * @brief Slab initialized flag
+ */
+static bool slab_initialized = false;
+
+/**
+ * @brief Helper to determine size class for allocation
+ *
+ * @param alignment requested alignment
+ * @param size requested size
+ * @return slab_class_t class or SLAB_CLASS_SIZE if not suitable
+ */
+static slab_class_t determine_class( size_t alignment, size_t size ) {
+  size_t object_size;
+
+  // treat empty allocations as smallest possible object
+  if ( 0 == size ) {
+    size = 1;
+  }
+  // alignment of zero behaves like byte alignment
+  if ( 0 == alignment ) {
+    alignment = 1;
+  }
+
+  // skip too big requests and non power of two alignments
+  if (
+    SLAB_MAX_OBJECT_SIZE < size
+    || SLAB_MAX_OBJECT_SIZE < alignment
+    || 0 != ( alignment & ( alignment - 1 ) )
+  ) {
+    return SLAB_CLASS_SIZE;
+  }
+
+  // loop through classes and return first fitting one
+  object_size = SLAB_MIN_OBJECT_SIZE;
+  for ( slab_class_t class = SLAB_CLASS_16; class < SLAB_CLASS_SIZE; class++ ) {
+    // objects are aligned to their size within a slab page
+    if ( object_size >= size && object_size >= alignment ) {
+      return class;
+    }
+    // next class
+    object_size <<= 1;
+  }
+
+  // not suitable
+  return SLAB_CLASS_SIZE;
+}
+
+/**
+ * @brief Helper to remove page from partial list of cache
+ *
+ * @param cache cache to remove the page from
+ * @param page page to remove
+ */
+static void partial_remove( slab_cache_ptr_t cache, slab_page_ptr_t page ) {
+  // unlink previous
+  if ( NULL != page->previous ) {
+    page->previous->next = page->next;
+  } else {
+    cache->partial = page->next;
+  }
+  // unlink next
+  if ( NULL != page->next ) {
+    page->next->previous = page->previous;
+  }
+  // reset pointers
+  page->previous = NULL;
+  page->next = NULL;
+}
+
+/**
+ * @brief Helper to push page to partial list of cache
+ *
+ * @param cache cache to push the page to
+ * @param page page to push
+ */
+static void partial_push( slab_cache_ptr_t cache, slab_page_ptr_t page ) {
+  // set pointers
+  page->previous = NULL;
+  page->next = cache->partial;
+  // link old head
+  if ( NULL != cache->partial ) {
+    cache->partial->previous = page;
+  }
+  // set new head
+  cache->partial = page;
+}
+
+/**
+ * @brief Helper to get a new backing page, either recycled or freshly mapped
+ *
+ * @return slab_page_ptr_t page or NULL
+ */
+static slab_page_ptr_t get_page( void ) {
+  slab_page_ptr_t page;
+
+  // reuse already mapped but unused page
+  if ( NULL != slab_manager.free_page ) {
+    page = slab_manager.free_page;
+    slab_manager.free_page = page->next;
+    // return page
+    return page;
+  }
+
+  // check for address space exhausted
+  if ( SLAB_START + SLAB_MAX_SIZE < slab_manager.end + PAGE_SIZE - 1 ) {
+    // debug output
+    #if defined( PRINT_MM_SLAB )
+      DEBUG_OUTPUT( "Slab address space exhausted\r\n" );
+    #endif
+    // return NULL
+    return NULL;
+  }
+
+  // take end as page
+  page = ( slab_page_ptr_t )slab_manager.end;
+  // debug output
+  #if defined( PRINT_MM_SLAB )
+    DEBUG_OUTPUT( "Map slab page %p with random physical address\r\n",
+      ( void* )page );
+  #endif
+  // map address, fallback to heap when out of memory
+  if ( ! virt_map_address_random(
+    kernel_context,
+    ( uintptr_t )page,
+    VIRT_MEMORY_TYPE_NORMAL,
+    VIRT_PAGE_TYPE_NON_EXECUTABLE
+  ) ) {
+    // debug output
+    #if defined( PRINT_MM_SLAB )
+      DEBUG_OUTPUT( "Mapping slab page failed\r\n" );
+    #endif
+    // return NULL
+    return NULL;
+  }
+  // increase end
+  slab_manager.end += PAGE_SIZE;
+  // return page
+  return page;
+}
+
+/**
+ * @brief Helper to prepare a backing page for a class
+ *
+ * @param page page to prepare
+ * @param class class the page is used for
+ */
+static void prepare_page( slab_page_ptr_t page, slab_class_t class ) {
+  size_t object_size, offset;
+  slab_object_ptr_t object;
+
+  // get object size
+  object_size = slab_manager.cache[ class ].object_size;
+  // clear page
+  memset( ( void* )page, 0, PAGE_SIZE );
+
+  // populate header
+  page->magic = SLAB_MAGIC;
+  page->class = class;
+  page->used = 0;
+  page->free = NULL;
+
+  // first object is placed aligned to object size after header
+  offset = sizeof( slab_page_t );
+  if ( offset % object_size ) {
+    offset += object_size - offset % object_size;
+  }
+
+  // build free list from the end so that objects are handed out ascending
+  for (
+    size_t current = PAGE_SIZE - object_size;
+    current >= offset;
+    current -= object_size
+  ) {
+    object = ( slab_object_ptr_t )( ( uintptr_t )page + current );
+    object->next = page->free;
+    page->free = object;
+  }
+
+  // debug output
+  #if defined( PRINT_MM_SLAB )
+    DEBUG_OUTPUT( "Prepared slab page %p for object size %zu\r\n",
+      ( void* )page, object_size );
+  #endif
+}
+
+/**
+ * @brief Getter for slab initialized flag
+ *
+ * @return true
+ * @return false
+ */
+bool slab_init_get( void ) {
+  return slab_initialized;
+}
+
+/**
+ * @brief Initialize slab allocator
+ */
+void slab_init( void ) {
+  size_t object_size;
+
+  // assert not yet initialized
+  assert( ! slab_initialized );
+
+  // clear manager
+  memset( &slab_manager, 0, sizeof( slab_manager_t ) );
+  // set end
+  slab_manager.end = SLAB_START;
+
+  // setup caches
+  object_size = SLAB_MIN_OBJECT_SIZE;
+  for ( slab_class_t class = SLAB_CLASS_16; class < SLAB_CLASS_SIZE; class++ ) {
+    slab_manager.cache[ class ].object_size = object_size;
+    object_size <<= 1;
+  }
+
+  // assert correct setup
+  assert(
+    SLAB_MAX_OBJECT_SIZE
+      == slab_manager.cache[ SLAB_CLASS_SIZE - 1 ].object_size
+  );
+
+  // debug output
+  #if defined( PRINT_MM_SLAB )
+    DEBUG_OUTPUT( "Slab area %p - %p\r\n",
+      ( void* )SLAB_START, ( void* )( SLAB_START + SLAB_MAX_SIZE ) );
+  #endif
+
+  // set initialized
+  slab_initialized = true;
+}
+
+/**
+ * @brief Check whether address belongs to slab area
+ *
+ * @param addr address to check
+ * @return true
+ * @return false
+ */
+bool slab_responsible( uintptr_t addr ) {
+  return slab_initialized
+    && SLAB_START <= addr
+    && slab_manager.end > addr;
+}
+
+/**
+ * @brief Check whether allocation can be served by slab allocator
+ *
+ * @param alignment requested alignment
+ * @param size requested size
+ * @return true
+ * @return false
+ */
+bool slab_suitable( size_t alignment, size_t size ) {
+  return slab_initialized
+    && SLAB_CLASS_SIZE != determine_class( alignment, size );
+}
+
+/**
+ * @brief Allocate object from slab
+ *
+ * @param alignment requested alignment
+ * @param size requested size
+ * @return uintptr_t address of object or 0
+ */
+uintptr_t slab_allocate( size_t alignment, size_t size ) {
+  slab_class_t class;
+  slab_cache_ptr_t cache;
+  slab_page_ptr_t page;
+  slab_object_ptr_t object;
+
+  // stop if not setup
+  if ( ! slab_initialized ) {
+    return ( uintptr_t )NULL;
+  }
+
+  // get class
+  class = determine_class( alignment, size );
+  // handle not suitable
+  if ( SLAB_CLASS_SIZE == class ) {
+    return ( uintptr_t )NULL;
+  }
+  // get cache
+  cache = &slab_manager.cache[ class ];
+
+  // handle no partial page existing
+  if ( NULL == cache->partial ) {
+    // get new page
+    page = get_page();
+    // handle error
+    if ( NULL == page ) {
+      return ( uintptr_t )NULL;
+    }
+    // prepare page and push to partial list
+    prepare_page( page, class );
+    partial_push( cache, page );
+    // update statistic
+    cache->statistic.miss++;
+    cache->statistic.pages++;
+  } else {
+    // update statistic
+    cache->statistic.hit++;
+  }
+
+  // get first partial page
+  page = cache->partial;
+  // pop object from free list
+  object = page->free;
+  assert( NULL != object );
+  page->free = object->next;
+  page->used++;
+
+  // remove full page from partial list
+  if ( NULL == page->free ) {
+    partial_remove( cache, page );
+  }
+
+  // update statistic
+  cache->statistic.allocated++;
+
+  // debug output
+  #if defined( PRINT_MM_SLAB )
+    DEBUG_OUTPUT( "size = %zu, object = %p, page = %p\r\n",
+      size, ( void* )object, ( void* )page );
+  #endif
+
+  // return object
+  return ( uintptr_t )object;
+}
+
+/**
+ * @brief Free slab object
+ *
+ * @param addr object address to free
+ */
+void slab_free( uintptr_t addr ) {
+  slab_page_ptr_t page;
+  slab_cache_ptr_t cache;
+  slab_object_ptr_t object;
+
+  // skip if not responsible
+  if ( ! slab_responsible( addr ) ) {
+    return;
+  }
+
+  // get page and assert correct magic
+  page = SLAB_GET_PAGE( addr );
+  assert( SLAB_MAGIC == page->magic );
+  assert( 0 < page->used );
+  // get cache
+  cache = &slab_manager.cache[ page->class ];
+
+  // debug output
+  #if defined( PRINT_MM_SLAB )
+    DEBUG_OUTPUT( "addr = %p, page = %p, object size = %zu\r\n",
+      ( void* )addr, ( void* )page, cache->object_size );
+  #endif
+
+  // full page becomes partial again
+  if ( NULL == page->free ) {
+    partial_push( cache, page );
+  }
+
+  // push object back to free list
+  object = ( slab_object_ptr_t )addr;
+  object->next = page->free;
+  page->free = object;
+  page->used--;
+
+  // update statistic
+  cache->statistic.freed++;
+
+  // return completely unused page for reuse by any class
+  if ( 0 == page->used ) {
+    // remove from partial list
+    partial_remove( cache, page );
+    // push to free page list
+    page->magic = 0;
+    page->next = slab_manager.free_page;
+    slab_manager.free_page = page;
+    // update statistic
+    cache->statistic.pages--;
+  }
+}
+
+/**
+ * @brief Get object size of slab allocated address
+ *
+ * @param addr address to get size for
+ * @return size_t object size or 0
+ */
+size_t slab_object_size( uintptr_t addr ) {
+  slab_page_ptr_t page;
+
+  // skip if not responsible
+  if ( ! slab_responsible( addr ) ) {
+    return 0;
+  }
+
+  // get page
+  page = SLAB_GET_PAGE( addr );
+  // handle invalid page
+  if ( SLAB_MAGIC != page->magic ) {
+    return 0;
+  }
+
+  // return object size
+  return slab_manager.cache[ page->class ].object_size;
+}
+
+/**
+ * @brief Get statistic of size class
+ *
+ * @param class size class
+ * @return slab_statistic_ptr_t statistic or NULL
+ */
+slab_statistic_ptr_t slab_statistic_get( slab_class_t class ) {
+  // handle invalid
+  if ( SLAB_CLASS_SIZE <= class ) {
+    return NULL;
+  }
+
+  // return statistic
+  return &slab_manager.cache[ class ].statistic;
+}
+
+/**
+ * @brief Print statistic of all size classes
+ */
+void slab_statistic_print( void ) {
+  slab_cache_ptr_t cache;
+
+  // loop through classes
+  for ( slab_class_t class = SLAB_CLASS_16; class < SLAB_CLASS_SIZE; class++ ) {
+    // get cache
+    cache = &slab_manager.cache[ class ];
+    // print statistic
+    printf(
+      "slab %3zu: hit = %zu, miss = %zu, allocated = %zu, freed = %zu, pages = %zu\r\n",
+      cache->object_size,
+      cache->statistic.hit,
+      cache->statistic.miss,
+      cache->statistic.allocated,
+      cache->statistic.freed,
+      cache->statistic.pages
+    );
+  }
+}
@@ -69,19 +69,14 @@ void virt_init( void ) {
   #endif
 
   // map from start to end addresses as used
-  while ( start < end ) {
-    // map page
-    virt_map_address(
-      kernel_context,
-      PHYS_2_VIRT( start ),
-      start,
-      VIRT_MEMORY_TYPE_NORMAL,
-      VIRT_PAGE_TYPE_EXECUTABLE
-    );
-
-    // get next page
-    start += PAGE_SIZE;
-  }
+  virt_map_range(
+    kernel_context,
+    PHYS_2_VIRT( start ),
+    start,
+    end - start,
+    VIRT_MEMORY_TYPE_NORMAL,
+    VIRT_PAGE_TYPE_EXECUTABLE
+  );
 
   // consider possible initrd
   if ( initrd_exist() ) {
@@ -101,19 +96,14 @@ void virt_init( void ) {
     #endif
 
     // map from start to end addresses as used
-    while ( start < end ) {
-      // map page
-      virt_map_address(
-        kernel_context,
-        PHYS_2_VIRT( start ),
-        start,
-        VIRT_MEMORY_TYPE_NORMAL,
-        VIRT_PAGE_TYPE_AUTO
-      );
-
-      // get next page
-      start += PAGE_SIZE;
-    }
+    virt_map_range(
+      kernel_context,
+      PHYS_2_VIRT( start ),
+      start,
+      end - start,
+      VIRT_MEMORY_TYPE_NORMAL,
+      VIRT_PAGE_TYPE_AUTO
+    );
 
     // change initrd location
     initrd_set_start_address(
@@ -155,3 +145,32 @@ void virt_init( void ) {
 bool virt_init_get( void ) {
   return virt_initialized;
 }
+
+/**
+ * @brief Release bootstrap code and data after initialization
+ *
+ * Bootstrap sections are only used before the kernel context is active, so
+ * their linear mapping is removed and physical pages are returned.
+ */
+void virt_bootstrap_reclaim( void ) {
+  // assert initialized
+  assert( true == virt_initialized );
+
+  // get physical bootstrap range, page aligned by linker script
+  uintptr_t start = ( uintptr_t )&__bootstrap_start;
+  uintptr_t end = ( uintptr_t )&__bootstrap_end;
+
+  // debug output
+  #if defined( PRINT_MM_VIRT )
+    DEBUG_OUTPUT(
+      "Reclaim bootstrap space %p - %p mapped at %p - %p\r\n",
+      ( void* )start,
+      ( void* )end,
+      ( void* )PHYS_2_VIRT( start ),
+      ( void* )PHYS_2_VIRT( end )
+    );
+  #endif
+
+  // unmap and free
+  virt_unmap_range( kernel_context, PHYS_2_VIRT( start ), end - start, true );
+}
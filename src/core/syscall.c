@@ -18,13 +18,118 @@
  * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <core/interrupt.h>
+#include <core/debug/debug.h>
+#include <core/mm/phys.h>
+#include <core/mm/virt.h>
+#include <core/task/process.h>
+#include <core/task/thread.h>
+#include <core/task/region.h>
 #include <core/syscall.h>
 
 /**
- * @brief Initialize syscalls
+ * @brief Syscall table indexed by syscall number
  */
-void syscall_init( void ) {
-  interrupt_register_handler(
-    SYSCALL_PUTC, syscall_putc, INTERRUPT_SOFTWARE, false );
+static const syscall_callback_t syscall_table[ SYSCALL_COUNT ] = {
+  [ SYSCALL_PUTC ] = syscall_putc,
+  [ SYSCALL_YIELD ] = syscall_yield,
+  [ SYSCALL_SLEEP ] = syscall_sleep,
+  [ SYSCALL_WRITE ] = syscall_write,
+  [ SYSCALL_IPC_SEND ] = syscall_ipc_send,
+  [ SYSCALL_IPC_RECEIVE ] = syscall_ipc_receive,
+  [ SYSCALL_IPC_CALL ] = syscall_ipc_call,
+  [ SYSCALL_IPC_REPLY ] = syscall_ipc_reply,
+  [ SYSCALL_SHM_CREATE ] = syscall_shm_create,
+  [ SYSCALL_SHM_MAP ] = syscall_shm_map,
+  [ SYSCALL_SHM_UNMAP ] = syscall_shm_unmap,
+  [ SYSCALL_CHANNEL_CREATE ] = syscall_channel_create,
+  [ SYSCALL_CHANNEL_SEND ] = syscall_channel_send,
+  [ SYSCALL_CHANNEL_RECEIVE ] = syscall_channel_receive,
+  [ SYSCALL_FORK ] = syscall_fork,
+};
+
+/**
+ * @brief Dispatch syscall by number
+ *
+ * @param num syscall number
+ * @param context cpu context
+ * @return true if syscall has been handled
+ * @return false if syscall number is invalid
+ */
+bool syscall_handle( size_t num, void* context ) {
+  // debug output
+  #if defined( PRINT_SYSCALL )
+    DEBUG_OUTPUT( "Handle syscall %zu\r\n", num );
+  #endif
+
+  // handle invalid syscall
+  if ( SYSCALL_COUNT <= num || NULL == syscall_table[ num ] ) {
+    return false;
+  }
+
+  // execute syscall
+  syscall_table[ num ]( context );
+  // return success
+  return true;
+}
+
+/**
+ * @brief Validate user buffer of running thread once for a whole span
+ *
+ * @param address buffer start
+ * @param length buffer length
+ * @param write buffer is written by the kernel
+ * @return true if buffer is completely mapped user memory
+ * @return false if buffer overflows, exceeds user space, isn't mapped or
+ *   isn't writable when written
+ *
+ * Pages of process regions not yet touched are populated on the way and
+ * pages shared copy on write are duplicated for written buffers, so the
+ * kernel never faults on user buffers.
+ */
+bool syscall_validate_buffer( uintptr_t address, size_t length, bool write ) {
+  // empty buffer is always valid
+  if ( 0 == length ) {
+    return true;
+  }
+  // handle overflow and addresses outside of user space
+  if (
+    address + length < address
+    || address + length > VIRT_USER_SPACE_END
+  ) {
+    return false;
+  }
+
+  // get running process and its context
+  task_process_ptr_t process = task_thread_current_thread->process;
+  virt_context_ptr_t ctx = process->virtual_context;
+  // check each touched page once
+  uintptr_t end = address + length;
+  for (
+    uintptr_t page = address - address % PAGE_SIZE;
+    page < end;
+    page += PAGE_SIZE
+  ) {
+    // read only regions are never written
+    if ( write && task_region_read_only( process, page ) ) {
+      return false;
+    }
+    // populate not yet touched region pages
+    if (
+      ! virt_is_mapped_in_context( ctx, page )
+      && ! task_region_fault( process, page )
+    ) {
+      return false;
+    }
+    // resolve copy on write or reject read only mapping
+    if (
+      write
+      && ! virt_is_writable_in_context( ctx, page )
+      && ! task_region_write_fault( process, page )
+    ) {
+      return false;
+    }
+  }
+
+  // return success
+  return true;
 }
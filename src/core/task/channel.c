@@ -0,0 +1,217 @@
+
+/**
+ * Copyright (C) 2018 - 2020 bolthur project.
+ *
+ * This file is part of bolthur/kernel.
+ *
+ * bolthur/kernel is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * bolthur/kernel is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <core/debug/debug.h>
+#include <core/task/process.h>
+#include <core/task/channel.h>
+#include <core/task/wait.h>
+
+/**
+ * @brief Compare id callback necessary for avl tree
+ *
+ * @param a node a
+ * @param b node b
+ * @return int32_t
+ */
+static int32_t channel_compare_id_callback(
+  const avl_node_ptr_t a,
+  const avl_node_ptr_t b
+) {
+  // -1 if id of a is greater than id of b
+  if ( ( size_t )a->data > ( size_t )b->data ) {
+    return -1;
+  // 1 if id of b is greater than id of a
+  } else if ( ( size_t )b->data > ( size_t )a->data ) {
+    return 1;
+  }
+
+  // equal => return 0
+  return 0;
+}
+
+/**
+ * @brief Create channel manager
+ *
+ * @return avl_tree_ptr_t
+ */
+avl_tree_ptr_t task_channel_init( void ) {
+  return avl_create_tree( channel_compare_id_callback );
+}
+
+/**
+ * @brief Method to generate new channel id
+ *
+ * @return size_t generated channel id
+ */
+size_t task_channel_generate_id( void ) {
+  // current id
+  static size_t current = 0;
+  // return new id by simple increment
+  return ++current;
+}
+
+/**
+ * @brief Create channel received by given process
+ *
+ * @param owner receiving process
+ * @return task_channel_ptr_t created channel
+ */
+task_channel_ptr_t task_channel_create( task_process_ptr_t owner ) {
+  // allocate channel
+  task_channel_ptr_t channel = ( task_channel_ptr_t )malloc(
+    sizeof( task_channel_t ) );
+  // assert malloc result
+  assert( NULL != channel );
+  // prepare structure
+  memset( ( void* )channel, 0, sizeof( task_channel_t ) );
+
+  // populate channel
+  channel->id = task_channel_generate_id();
+  channel->owner = owner->id;
+  task_wait_queue_init( &channel->receiver );
+  task_wait_queue_init( &channel->sender );
+
+  // prepare and insert node
+  avl_prepare_node( &channel->node_id, ( void* )channel->id );
+  avl_insert_by_node( process_manager->tree_channel_id, &channel->node_id );
+
+  // debug output
+  #if defined( PRINT_PROCESS )
+    DEBUG_OUTPUT( "Created channel %zu for process %zu\r\n",
+      channel->id, channel->owner );
+  #endif
+
+  // return channel
+  return channel;
+}
+
+/**
+ * @brief Get channel by id
+ *
+ * @param id channel id
+ * @return task_channel_ptr_t found channel or NULL
+ */
+task_channel_ptr_t task_channel_get_by_id( size_t id ) {
+  // find node in tree
+  avl_node_ptr_t node = avl_find_by_data(
+    process_manager->tree_channel_id, ( void* )id );
+  // handle not existing
+  if ( NULL == node ) {
+    return NULL;
+  }
+  // return channel
+  return TASK_CHANNEL_GET_BLOCK( node );
+}
+
+/**
+ * @brief Enqueue batch of messages as far as space is left
+ *
+ * @param channel channel to push to
+ * @param sender sending process id stamped into each message
+ * @param message messages to push
+ * @param count amount of messages
+ * @return size_t amount of pushed messages
+ */
+size_t task_channel_push(
+  task_channel_ptr_t channel,
+  size_t sender,
+  const task_channel_message_t* message,
+  size_t count
+) {
+  // cap by free space
+  size_t free_slots = TASK_CHANNEL_SIZE - channel->count;
+  if ( count > free_slots ) {
+    count = free_slots;
+  }
+  // nothing to do
+  if ( 0 == count ) {
+    return 0;
+  }
+
+  // remember empty state for wakeup
+  bool was_empty = 0 == channel->count;
+  // copy messages into ring
+  for ( size_t index = 0; index < count; index++ ) {
+    size_t slot = ( channel->head + channel->count ) % TASK_CHANNEL_SIZE;
+    channel->queue[ slot ] = message[ index ];
+    channel->queue[ slot ].sender = sender;
+    channel->count++;
+  }
+
+  // debug output
+  #if defined( PRINT_PROCESS )
+    DEBUG_OUTPUT( "Pushed %zu messages to channel %zu, count: %zu\r\n",
+      count, channel->id, channel->count );
+  #endif
+
+  // wake receivers only on transition from empty to non empty
+  if ( was_empty ) {
+    task_wait_wake_all( &channel->receiver );
+  }
+  // return pushed amount
+  return count;
+}
+
+/**
+ * @brief Dequeue batch of messages
+ *
+ * @param channel channel to pop from
+ * @param message target buffer
+ * @param max maximum amount of messages
+ * @return size_t amount of popped messages
+ */
+size_t task_channel_pop(
+  task_channel_ptr_t channel,
+  task_channel_message_t* message,
+  size_t max
+) {
+  // cap by available messages
+  size_t count = max < channel->count ? max : channel->count;
+  // nothing to do
+  if ( 0 == count ) {
+    return 0;
+  }
+
+  // remember full state for wakeup
+  bool was_full = TASK_CHANNEL_SIZE == channel->count;
+  // copy messages out of ring
+  for ( size_t index = 0; index < count; index++ ) {
+    message[ index ] = channel->queue[ channel->head ];
+    channel->head = ( channel->head + 1 ) % TASK_CHANNEL_SIZE;
+    channel->count--;
+  }
+
+  // debug output
+  #if defined( PRINT_PROCESS )
+    DEBUG_OUTPUT( "Popped %zu messages from channel %zu, count: %zu\r\n",
+      count, channel->id, channel->count );
+  #endif
+
+  // wake senders only on transition from full to non full
+  if ( was_full ) {
+    task_wait_wake_all( &channel->sender );
+  }
+  // return popped amount
+  return count;
+}
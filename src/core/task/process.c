@@ -22,12 +22,16 @@
 #include <string.h>
 #include <assert.h>
 #include <core/event.h>
+#include <core/timer.h>
 #include <core/elf/common.h>
 #include <core/debug/debug.h>
 #include <core/task/queue.h>
 #include <core/task/process.h>
 #include <core/task/thread.h>
 #include <core/task/stack.h>
+#include <core/task/wait.h>
+#include <core/task/channel.h>
+#include <core/task/region.h>
 
 /**
  * @brief Process management structure
@@ -82,8 +86,12 @@ void task_process_init( void ) {
   // create tree for managing processes by id
   process_manager->tree_process_id = avl_create_tree(
     process_compare_id_callback );
-  // create thread queue tree
-  process_manager->thread_priority_tree = task_queue_init();
+  // create tree for finding threads of all processes by id
+  process_manager->tree_thread_id = task_thread_init();
+  // create tree for finding channels by id
+  process_manager->tree_channel_id = task_channel_init();
+  // create thread run queue
+  process_manager->thread_run_queue = task_queue_init();
 
   // register timer event
   event_bind( EVENT_TIMER, task_process_schedule, true );
@@ -102,28 +110,12 @@ size_t task_process_generate_id( void ) {
 }
 
 /**
- * @brief Method to create new process
+ * @brief Helper to allocate and prepare process structure
  *
- * @param entry process entry address
  * @param priority process priority
+ * @return task_process_ptr_t prepared process
  */
-void task_process_create( uintptr_t entry, size_t priority ) {
-  // debug output
-  #if defined( PRINT_PROCESS )
-    DEBUG_OUTPUT(
-      "task_process_create( %p, %zu ) called\r\n", ( void* )entry, priority );
-  #endif
-
-  // check for valid header
-  if ( ! elf_check( entry ) ) {
-    // debug output
-    #if defined( PRINT_PROCESS )
-      DEBUG_OUTPUT( "No valid elf header found\r\n" );
-    #endif
-    // return
-    return;
-  }
-
+static task_process_ptr_t process_allocate( size_t priority ) {
   // allocate process structure
   task_process_ptr_t process = ( task_process_ptr_t )malloc(
     sizeof( task_process_t ) );
@@ -142,8 +134,56 @@ void task_process_create( uintptr_t entry, size_t priority ) {
   process->state = TASK_PROCESS_STATE_READY;
   process->priority = priority;
   process->thread_stack_manager = task_stack_manager_create();
+  process->region_manager = task_region_init();
   // create context only for user processes
   process->virtual_context = virt_create_context( VIRT_CONTEXT_TYPE_USER );
+  // return prepared process
+  return process;
+}
+
+/**
+ * @brief Helper to copy stack addresses of a stack manager tree
+ *
+ * @param node current node
+ * @param manager target stack manager
+ */
+static void process_copy_stack( avl_node_ptr_t node, task_stack_manager_ptr_t manager ) {
+  // handle end reached
+  if ( NULL == node ) {
+    return;
+  }
+  // add stack address and continue with children
+  task_stack_manager_add( ( uintptr_t )node->data, manager );
+  process_copy_stack( node->left, manager );
+  process_copy_stack( node->right, manager );
+}
+
+/**
+ * @brief Method to create new process
+ *
+ * @param entry process entry address
+ * @param priority process priority
+ * @return task_process_ptr_t created process or NULL on error
+ */
+task_process_ptr_t task_process_create( uintptr_t entry, size_t priority ) {
+  // debug output
+  #if defined( PRINT_PROCESS )
+    DEBUG_OUTPUT(
+      "task_process_create( %p, %zu ) called\r\n", ( void* )entry, priority );
+  #endif
+
+  // check for valid header
+  if ( ! elf_check( entry ) ) {
+    // debug output
+    #if defined( PRINT_PROCESS )
+      DEBUG_OUTPUT( "No valid elf header found\r\n" );
+    #endif
+    // return
+    return NULL;
+  }
+
+  // allocate process structure
+  task_process_ptr_t process = process_allocate( priority );
 
   // load elf executable
   uintptr_t program_entry = elf_load( entry, process );
@@ -163,81 +203,94 @@ void task_process_create( uintptr_t entry, size_t priority ) {
     task_stack_manager_destroy( process->thread_stack_manager );
     // destroy thread manager
     task_thread_destroy( process->thread_manager );
+    // destroy region manager
+    task_region_destroy( process->region_manager );
+    // return error
+    return NULL;
   }
+
+  // return created process
+  return process;
 }
 
 /**
- * @brief Resets process priority queues
+ * @brief Fork process of thread with address space shared copy on write
+ *
+ * Populated pages of all regions are shared read only and duplicated on
+ * first write, so identical processes start without copying any page.
+ *
+ * @param thread thread to duplicate, other threads are not forked
+ * @return task_process_ptr_t created process
  */
-void task_process_queue_reset( void ) {
-  // min / max queue
-  task_priority_queue_ptr_t min_queue = NULL;
-  task_priority_queue_ptr_t max_queue = NULL;
-  avl_node_ptr_t min = NULL;
-  avl_node_ptr_t max = NULL;
+task_process_ptr_t task_process_fork( task_thread_ptr_t thread ) {
+  task_process_ptr_t parent = thread->process;
 
   // debug output
   #if defined( PRINT_PROCESS )
-    DEBUG_OUTPUT( "task_process_queue_reset()\r\n" );
+    DEBUG_OUTPUT( "task_process_fork( %p ) of process %zu called\r\n",
+      ( void* )thread, parent->id );
   #endif
 
-  // get min and max priority queue
-  min = avl_get_min( process_manager->thread_priority_tree->root );
-  max = avl_get_max( process_manager->thread_priority_tree->root );
+  // allocate process structure
+  task_process_ptr_t process = process_allocate( parent->priority );
+  // clone regions and share their pages
+  task_region_clone( parent, process );
+  // keep stack addresses of parent threads reserved
+  process_copy_stack(
+    parent->thread_stack_manager->tree->root, process->thread_stack_manager );
+
+  // prepare node
+  avl_prepare_node( &process->node_id, ( void* )process->id );
+  // add process to tree
+  avl_insert_by_node( process_manager->tree_process_id, &process->node_id );
+  // duplicate thread
+  task_thread_fork( thread, process );
+
+  // return created process
+  return process;
+}
+
+/**
+ * @brief Resets process priority queues by starting a new round
+ */
+void task_process_queue_reset( void ) {
   // debug output
   #if defined( PRINT_PROCESS )
-    DEBUG_OUTPUT( "min: %p, max: %p\r\n", ( void* )min, ( void* )max );
+    DEBUG_OUTPUT( "task_process_queue_reset()\r\n" );
   #endif
 
-  // get nodes from min/max
-  if ( NULL != min ) {
-    min_queue = TASK_QUEUE_GET_PRIORITY( min );
-  }
-  if ( NULL != max ) {
-    max_queue = TASK_QUEUE_GET_PRIORITY( max );
+  // threads handled within last round are executed again
+  task_queue_swap( process_manager->thread_run_queue );
+}
+
+/**
+ * @brief Program next timer expiry from time slice end and sleeping threads
+ *
+ * Time slice ends only matter when other threads are runnable, so the timer
+ * is stopped completely when there is neither competition nor a sleeper. The
+ * slice ends one interval after the running thread has been switched in.
+ */
+void task_process_timer_update( void ) {
+  uint64_t expiry = TIMER_EXPIRY_NONE;
+  // end of time slice of running thread when other threads wait for cpu
+  if ( ! task_queue_empty( process_manager->thread_run_queue ) ) {
+    expiry = process_manager->slice_start + timer_get_interval();
   }
-  // handle no min or no max queue
-  if ( NULL == min_queue || NULL == max_queue ) {
-    return;
+  // earliest sleeping thread
+  uint64_t wakeup = task_wait_next_wakeup();
+  if ( wakeup < expiry ) {
+    expiry = wakeup;
   }
 
-  // loop through priorities and try to get next task
-  for (
-    size_t priority = max_queue->priority;
-    priority >= min_queue->priority;
-    priority--
-  ) {
-    // try to find queue for priority
-    avl_node_ptr_t current_node = avl_find_by_data(
-      process_manager->thread_priority_tree,
-      ( void* )priority );
-    // skip if not existing
-    if ( NULL == current_node ) {
-      // prevent endless loop by checking against 0
-      if ( 0 == priority ) {
-        break;
-      }
-      // skip if no such queue exists
-      continue;
-    }
-
-    // get queue
-    task_priority_queue_ptr_t current = TASK_QUEUE_GET_PRIORITY( current_node );
-    // check for empty
-    if ( list_empty( current->thread_list ) ) {
-      // prevent endless loop by checking against 0
-      if ( 0 == priority ) {
-        break;
-      }
-      // skip if queue is handled
-      continue;
-    }
-
-    // reset last handled
-    current->last_handled = NULL;
-    // prevent endless loop by checking against 0
-    if ( 0 == priority ) {
-      break;
-    }
+  // debug output
+  #if defined( PRINT_PROCESS )
+    DEBUG_OUTPUT( "Next timer expiry at microsecond %llu\r\n", expiry );
+  #endif
+
+  // stop tick or program one shot expiry
+  if ( TIMER_EXPIRY_NONE == expiry ) {
+    timer_stop();
+  } else {
+    timer_set_expiry( expiry );
   }
 }
@@ -25,98 +25,138 @@
 #include <core/task/queue.h>
 
 /**
- * @brief Compare id callback necessary for avl tree
+ * @brief Helper to append thread to priority queue of a set
  *
- * @param a node a
- * @param b node b
- * @return int32_t
+ * @param set run queue set
+ * @param thread thread to append
  */
-static int32_t queue_compare_priority_callback(
-  const avl_node_ptr_t a,
-  const avl_node_ptr_t b
-) {
-  // debug output
-  #if defined( PRINT_PROCESS )
-    DEBUG_OUTPUT( "a = %p, b = %p\r\n", ( void* )a, ( void* )b );
-    DEBUG_OUTPUT( "a->data = %zu, b->data = %zu\r\n",
-      ( size_t )a->data,
-      ( size_t )b->data );
-  #endif
+static void set_push( task_run_queue_set_ptr_t set, task_thread_ptr_t thread ) {
+  // assert valid priority
+  assert( TASK_QUEUE_PRIORITY_COUNT > thread->priority );
+  // get queue
+  task_priority_queue_ptr_t queue = &set->queue[ thread->priority ];
 
-  // -1 if address of a is greater than address of b
-  if ( ( size_t )a->data > ( size_t )b->data ) {
-    return -1;
-  // 1 if address of b is greater than address of a
-  } else if ( ( size_t )b->data > ( size_t )a->data ) {
-    return 1;
+  // append thread
+  thread->queue_next = NULL;
+  if ( NULL == queue->last ) {
+    queue->first = thread;
+  } else {
+    queue->last->queue_next = thread;
   }
+  queue->last = thread;
 
-  // equal => return 0
-  return 0;
+  // mark priority as not empty
+  set->bitmap |= 1U << thread->priority;
 }
 
 /**
- * @brief Initialize task process manager
+ * @brief Initialize run queue
+ *
+ * @return task_run_queue_ptr_t
  */
-avl_tree_ptr_t task_queue_init( void ) {
-  return avl_create_tree( queue_compare_priority_callback );
+task_run_queue_ptr_t task_queue_init( void ) {
+  // allocate run queue
+  task_run_queue_ptr_t run = ( task_run_queue_ptr_t )malloc(
+    sizeof( task_run_queue_t ) );
+  // assert initialization
+  assert( NULL != run );
+  // prepare memory
+  memset( ( void* )run, 0, sizeof( task_run_queue_t ) );
+  // set active and expired set
+  run->active = &run->set[ 0 ];
+  run->expired = &run->set[ 1 ];
+  // return run queue
+  return run;
 }
 
 /**
- * @brief Get the thread queue object
+ * @brief Push thread to active set, so it's executed within current round
  *
- * @param manager
- * @param priority
- * @return task_priority_queue_ptr_t
+ * @param run run queue
+ * @param thread thread to push
  */
-task_priority_queue_ptr_t task_queue_get_queue(
-  task_manager_ptr_t manager,
-  size_t priority
-) {
-  // assert manager existence
-  assert( NULL != manager );
+void task_queue_push( task_run_queue_ptr_t run, task_thread_ptr_t thread ) {
   // debug output
   #if defined( PRINT_PROCESS )
-    DEBUG_OUTPUT( "Called task_queue_get_queue( %zu )\r\n", priority );
+    DEBUG_OUTPUT( "Push thread %zu with priority %zu\r\n",
+      thread->id, thread->priority );
   #endif
-  // get correct tree to use
-  avl_tree_ptr_t tree = manager->thread_priority_tree;
+  set_push( run->active, thread );
+}
 
-  // try to find node
-  avl_node_ptr_t node = avl_find_by_data( tree, ( void* )priority );
-  task_priority_queue_ptr_t queue;
+/**
+ * @brief Push thread to expired set, so it's executed within next round
+ *
+ * @param run run queue
+ * @param thread thread to push
+ */
+void task_queue_expire( task_run_queue_ptr_t run, task_thread_ptr_t thread ) {
   // debug output
   #if defined( PRINT_PROCESS )
-    DEBUG_OUTPUT( "Found node %p\r\n", ( void* )node );
+    DEBUG_OUTPUT( "Expire thread %zu with priority %zu\r\n",
+      thread->id, thread->priority );
   #endif
-  // handle not yet added
-  if ( NULL == node ) {
-    // allocate block
-    queue = ( task_priority_queue_ptr_t )malloc(
-      sizeof( task_priority_queue_t ) );
-    // assert initialization
-    assert( NULL != queue );
-    // prepare memory
-    memset( ( void* )queue, 0, sizeof( task_priority_queue_t ) );
-    // debug output
-    #if defined( PRINT_PROCESS )
-      DEBUG_OUTPUT( "Initialized new node at %p\r\n", ( void* )queue );
-    #endif
-    // populate queue
-    queue->priority = priority;
-    queue->thread_list = list_construct();
-    queue->current = NULL;
-    queue->last_handled = NULL;
-    // prepare and insert node
-    avl_prepare_node( &queue->node, ( void* )priority );
-    avl_insert_by_node( tree, &queue->node );
-  // existing? => gather block
-  } else {
-    queue = TASK_QUEUE_GET_PRIORITY( node );
+  set_push( run->expired, thread );
+}
+
+/**
+ * @brief Pop first thread of highest non empty priority from active set
+ *
+ * @param run run queue
+ * @return task_thread_ptr_t thread or NULL if active set is empty
+ */
+task_thread_ptr_t task_queue_pop( task_run_queue_ptr_t run ) {
+  task_run_queue_set_ptr_t set = run->active;
+
+  // handle empty set
+  if ( 0 == set->bitmap ) {
+    return NULL;
   }
 
+  // highest priority with threads by counting leading zeros
+  size_t priority = 31 - ( size_t )__builtin_clz( set->bitmap );
+  task_priority_queue_ptr_t queue = &set->queue[ priority ];
+  // get first thread
+  task_thread_ptr_t thread = queue->first;
   // assert existence
-  assert( NULL != queue );
-  // return queue
-  return queue;
+  assert( NULL != thread );
+
+  // remove thread from queue
+  queue->first = thread->queue_next;
+  thread->queue_next = NULL;
+  // handle emptied queue
+  if ( NULL == queue->first ) {
+    queue->last = NULL;
+    set->bitmap &= ~( 1U << priority );
+  }
+
+  // debug output
+  #if defined( PRINT_PROCESS )
+    DEBUG_OUTPUT( "Pop thread %zu with priority %zu\r\n",
+      thread->id, priority );
+  #endif
+
+  // return thread
+  return thread;
+}
+
+/**
+ * @brief Swap active and expired set to start a new round
+ *
+ * @param run run queue
+ */
+void task_queue_swap( task_run_queue_ptr_t run ) {
+  task_run_queue_set_ptr_t tmp = run->active;
+  run->active = run->expired;
+  run->expired = tmp;
+}
+
+/**
+ * @brief Check whether active and expired set contain no thread
+ *
+ * @param run run queue
+ * @return bool
+ */
+bool task_queue_empty( task_run_queue_ptr_t run ) {
+  return 0 == run->active->bitmap && 0 == run->expired->bitmap;
 }
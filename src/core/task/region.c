@@ -0,0 +1,408 @@
+
+/**
+ * Copyright (C) 2018 - 2020 bolthur project.
+ *
+ * This file is part of bolthur/kernel.
+ *
+ * bolthur/kernel is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * bolthur/kernel is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <core/entry.h>
+#include <core/debug/debug.h>
+#include <core/mm/phys.h>
+#include <core/mm/virt.h>
+#include <core/mm/cow.h>
+#include <core/task/process.h>
+#include <core/task/region.h>
+#include <arch/arm/cache.h>
+
+/**
+ * @brief Helper to get page aligned start of region
+ *
+ * @param region region to use
+ * @return uintptr_t
+ */
+static uintptr_t region_page_start( task_region_ptr_t region ) {
+  return region->start - region->start % PAGE_SIZE;
+}
+
+/**
+ * @brief Helper to get page aligned end of region
+ *
+ * @param region region to use
+ * @return uintptr_t
+ */
+static uintptr_t region_page_end( task_region_ptr_t region ) {
+  uintptr_t end = region->end;
+  // round up to full page
+  if ( 0 < end % PAGE_SIZE ) {
+    end += PAGE_SIZE - end % PAGE_SIZE;
+  }
+  return end;
+}
+
+/**
+ * @brief Create region manager for process
+ *
+ * @return list_manager_ptr_t
+ */
+list_manager_ptr_t task_region_init( void ) {
+  return list_construct();
+}
+
+/**
+ * @brief Destroy region manager of process
+ *
+ * @param list region manager
+ */
+void task_region_destroy( list_manager_ptr_t list ) {
+  // free regions
+  for ( list_item_ptr_t item = list->first; NULL != item; item = item->next ) {
+    free( item->data );
+  }
+  // destroy list
+  list_destruct( list );
+}
+
+/**
+ * @brief Record region a process may touch, populated on first access
+ *
+ * @param process process to add region to
+ * @param start virtual start address
+ * @param size region size
+ * @param source kernel address of initial content or 0
+ * @param source_size size of initial content, remaining part is zeroed
+ * @param direct content is linear mapped kernel memory, which may be mapped
+ *   into the process directly when the region is read only
+ * @param page page attributes used for mapping
+ */
+void task_region_add(
+  task_process_ptr_t process,
+  uintptr_t start,
+  size_t size,
+  uintptr_t source,
+  size_t source_size,
+  bool direct,
+  uint32_t page
+) {
+  // allocate region
+  task_region_ptr_t region = ( task_region_ptr_t )malloc(
+    sizeof( task_region_t ) );
+  // assert malloc result
+  assert( NULL != region );
+
+  // populate region
+  region->start = start;
+  region->end = start + size;
+  region->source = source;
+  region->source_size = source_size;
+  region->direct = direct;
+  region->page = page;
+  // push to process regions
+  list_push_back( process->region_manager, ( void* )region );
+
+  // debug output
+  #if defined( PRINT_PROCESS )
+    DEBUG_OUTPUT( "Added region %p - %p to process %zu\r\n",
+      ( void* )region->start, ( void* )region->end, process->id );
+  #endif
+}
+
+/**
+ * @brief Helper to find region containing page
+ *
+ * @param process process to search
+ * @param page page aligned address
+ * @return task_region_ptr_t found region or NULL
+ */
+static task_region_ptr_t region_find( task_process_ptr_t process, uintptr_t page ) {
+  for (
+    list_item_ptr_t item = process->region_manager->first;
+    NULL != item;
+    item = item->next
+  ) {
+    task_region_ptr_t region = ( task_region_ptr_t )item->data;
+    if (
+      page >= region_page_start( region )
+      && page < region_page_end( region )
+    ) {
+      return region;
+    }
+  }
+  // nothing found
+  return NULL;
+}
+
+/**
+ * @brief Helper to check whether page can be mapped directly from source
+ *
+ * @param region region containing page
+ * @param page page aligned address
+ * @return true if page is read only and completely backed by aligned source
+ * @return false if page has to be allocated
+ */
+static bool region_direct_page( task_region_ptr_t region, uintptr_t page ) {
+  return region->direct
+    && region->page & VIRT_PAGE_TYPE_READ_ONLY
+    && page >= region->start
+    && page + PAGE_SIZE <= region->start + region->source_size
+    && 0 == ( region->source + ( page - region->start ) ) % PAGE_SIZE;
+}
+
+/**
+ * @brief Populate page containing faulting address if it belongs to a region
+ *
+ * Initial content of all regions sharing the page is copied, so segments
+ * starting or ending in the middle of a page are handled correctly.
+ *
+ * @param process faulting process
+ * @param address faulting address
+ * @return true if page has been mapped
+ * @return false if address is not part of any region or already mapped
+ */
+bool task_region_fault( task_process_ptr_t process, uintptr_t address ) {
+  uintptr_t page = address - address % PAGE_SIZE;
+  // find region containing address
+  task_region_ptr_t found = region_find( process, page );
+  // handle invalid access or concurrent population
+  if (
+    NULL == found
+    || virt_is_mapped_in_context( process->virtual_context, page )
+  ) {
+    return false;
+  }
+
+  // debug output
+  #if defined( PRINT_PROCESS )
+    DEBUG_OUTPUT( "Populate page %p of process %zu\r\n",
+      ( void* )page, process->id );
+  #endif
+
+  // map read only content without copy
+  if ( region_direct_page( found, page ) ) {
+    virt_map_address(
+      process->virtual_context,
+      page,
+      VIRT_2_PHYS( found->source + ( page - found->start ) ),
+      VIRT_MEMORY_TYPE_NORMAL,
+      found->page );
+    return true;
+  }
+
+  // map new page
+  if ( ! virt_map_address_random(
+    process->virtual_context, page, VIRT_MEMORY_TYPE_NORMAL, found->page
+  ) ) {
+    return false;
+  }
+  // map it temporary for clearing and copying
+  uint64_t physical = virt_get_mapped_address_in_context(
+    process->virtual_context, page );
+  uintptr_t tmp = virt_map_temporary( physical, PAGE_SIZE );
+  // clear page
+  memset( ( void* )tmp, 0, PAGE_SIZE );
+
+  // copy initial content of every region overlapping the page
+  for (
+    list_item_ptr_t item = process->region_manager->first;
+    NULL != item;
+    item = item->next
+  ) {
+    task_region_ptr_t region = ( task_region_ptr_t )item->data;
+    // skip regions without content
+    if ( 0 == region->source ) {
+      continue;
+    }
+    // determine overlap of content and page
+    uintptr_t from = region->start > page ? region->start : page;
+    uintptr_t to = region->start + region->source_size;
+    if ( to > page + PAGE_SIZE ) {
+      to = page + PAGE_SIZE;
+    }
+    // copy overlapping part
+    if ( from < to ) {
+      memcpy(
+        ( void* )( tmp + ( from - page ) ),
+        ( void* )( region->source + ( from - region->start ) ),
+        to - from );
+    }
+  }
+
+  // push copied code to point of unification and drop stale instructions
+  if ( found->page & VIRT_PAGE_TYPE_EXECUTABLE ) {
+    cache_clean_range( tmp, PAGE_SIZE );
+    cache_invalidate_instruction_cache();
+    cache_invalidate_branch_predictor();
+  }
+  // unmap temporary
+  virt_unmap_temporary( tmp, PAGE_SIZE );
+  // return success
+  return true;
+}
+
+/**
+ * @brief Resolve write fault on a copy on write page of a region
+ *
+ * @param process faulting process
+ * @param address faulting address
+ * @return true if page is writable now
+ * @return false if address is not part of a region or not copy on write
+ */
+bool task_region_write_fault( task_process_ptr_t process, uintptr_t address ) {
+  // find region containing address
+  task_region_ptr_t region = region_find(
+    process, address - address % PAGE_SIZE );
+  // handle invalid access and writes to read only regions
+  if ( NULL == region || region->page & VIRT_PAGE_TYPE_READ_ONLY ) {
+    return false;
+  }
+  // duplicate or take over page
+  return cow_fault( process->virtual_context, address, region->page );
+}
+
+/**
+ * @brief Check whether address belongs to a read only region
+ *
+ * @param process process to check
+ * @param address address to check
+ * @return true if address is part of a read only region
+ * @return false if address is writable or not part of any region
+ */
+bool task_region_read_only( task_process_ptr_t process, uintptr_t address ) {
+  // find region containing address
+  task_region_ptr_t region = region_find(
+    process, address - address % PAGE_SIZE );
+  // check flag
+  return NULL != region && region->page & VIRT_PAGE_TYPE_READ_ONLY;
+}
+
+/**
+ * @brief Check whether range overlaps any region of a process
+ *
+ * @param process process to check
+ * @param address start address
+ * @param size range size
+ * @return true if at least one region overlaps the range
+ * @return false otherwise
+ */
+bool task_region_overlap(
+  task_process_ptr_t process,
+  uintptr_t address,
+  size_t size
+) {
+  for (
+    list_item_ptr_t item = process->region_manager->first;
+    NULL != item;
+    item = item->next
+  ) {
+    task_region_ptr_t region = ( task_region_ptr_t )item->data;
+    if (
+      address < region_page_end( region )
+      && address + size > region_page_start( region )
+    ) {
+      return true;
+    }
+  }
+  // nothing found
+  return false;
+}
+
+/**
+ * @brief Clone regions and share their populated pages copy on write
+ *
+ * @param parent process to clone from
+ * @param child process to clone into
+ */
+void task_region_clone( task_process_ptr_t parent, task_process_ptr_t child ) {
+  for (
+    list_item_ptr_t item = parent->region_manager->first;
+    NULL != item;
+    item = item->next
+  ) {
+    task_region_ptr_t region = ( task_region_ptr_t )item->data;
+    // add same region to child
+    task_region_add(
+      child,
+      region->start,
+      region->end - region->start,
+      region->source,
+      region->source_size,
+      region->direct,
+      region->page );
+    // share already populated pages
+    cow_clone_range(
+      parent->virtual_context,
+      child->virtual_context,
+      region_page_start( region ),
+      region_page_end( region ) - region_page_start( region ),
+      region->page );
+  }
+}
+
+/**
+ * @brief Helper to check whether regions of a process subtree use a source
+ *
+ * @param node process tree node
+ * @param start start of source range
+ * @param end end of source range
+ * @return true if at least one region references the range
+ * @return false otherwise
+ */
+static bool region_source_used_node(
+  avl_node_ptr_t node,
+  uintptr_t start,
+  uintptr_t end
+) {
+  // handle end of tree
+  if ( NULL == node ) {
+    return false;
+  }
+  // get process
+  task_process_ptr_t process = TASK_PROCESS_GET_BLOCK_ID( node );
+  // loop through regions
+  for (
+    list_item_ptr_t item = process->region_manager->first;
+    NULL != item;
+    item = item->next
+  ) {
+    task_region_ptr_t region = ( task_region_ptr_t )item->data;
+    // check for overlapping source
+    if (
+      0 != region->source
+      && region->source < end
+      && region->source + region->source_size > start
+    ) {
+      return true;
+    }
+  }
+  // check children
+  return region_source_used_node( node->left, start, end )
+    || region_source_used_node( node->right, start, end );
+}
+
+/**
+ * @brief Check whether any region of any process uses given source range
+ *
+ * @param start start of source range
+ * @param end end of source range
+ * @return true if range is still needed to populate pages
+ * @return false if range is unused
+ */
+bool task_region_source_used( uintptr_t start, uintptr_t end ) {
+  return region_source_used_node(
+    process_manager->tree_process_id->root, start, end );
+}
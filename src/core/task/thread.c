@@ -25,6 +25,7 @@
 #include <core/debug/debug.h>
 #include <core/event.h>
 #include <core/task/queue.h>
+#include <core/task/process.h>
 #include <core/task/thread.h>
 
 /**
@@ -79,20 +80,12 @@ size_t task_thread_generate_id( void ) {
  * @brief Sets current running thread
  *
  * @param thread thread to set
- * @param queue thread queue
  */
-void task_thread_set_current(
-  task_thread_ptr_t thread,
-  task_priority_queue_ptr_t queue
-) {
+void task_thread_set_current( task_thread_ptr_t thread ) {
   // assert thread parameter
   assert( NULL != thread );
   // set current thread
   task_thread_current_thread = thread;
-  // assert thread parameter
-  assert( NULL != queue );
-  // update queue current
-  queue->current = thread;
   // set state
   task_thread_current_thread->state = TASK_THREAD_STATE_ACTIVE;
 }
@@ -121,118 +114,37 @@ void task_thread_destroy( avl_tree_ptr_t tree ) {
  * @return task_thread_ptr_t
  */
 task_thread_ptr_t task_thread_next( void ) {
-  // min / max queue
-  task_priority_queue_ptr_t min_queue = NULL;
-  task_priority_queue_ptr_t max_queue = NULL;
-  avl_node_ptr_t min = NULL;
-  avl_node_ptr_t max = NULL;
+  // get thread of highest priority not yet handled within this round
+  task_thread_ptr_t next = task_queue_pop( process_manager->thread_run_queue );
+  // start next round if everything has been handled
+  if ( NULL == next ) {
+    task_process_queue_reset();
+    next = task_queue_pop( process_manager->thread_run_queue );
+  }
 
-  // get min and max priority queue
-  min = avl_get_min( process_manager->thread_priority_tree->root );
-  max = avl_get_max( process_manager->thread_priority_tree->root );
   // debug output
   #if defined( PRINT_PROCESS )
-    DEBUG_OUTPUT( "min: %p, max: %p\r\n", ( void* )min, ( void* )max );
+    DEBUG_OUTPUT( "next = %p\r\n", ( void* )next );
   #endif
 
-  // get nodes from min/max
-  if ( NULL != min ) {
-    min_queue = TASK_QUEUE_GET_PRIORITY( min );
-  }
-  if ( NULL != max ) {
-    max_queue = TASK_QUEUE_GET_PRIORITY( max );
-  }
-  // handle no min or no max queue
-  if ( NULL == min_queue || NULL == max_queue ) {
-    return NULL;
-  }
-
-  // loop through priorities and try to get next task
-  for (
-    size_t priority = max_queue->priority;
-    priority >= min_queue->priority;
-    priority--
-  ) {
-    // try to find queue for priority
-    avl_node_ptr_t current_node = avl_find_by_data(
-      process_manager->thread_priority_tree,
-      ( void* )priority );
-    // skip if not existing
-    if ( NULL == current_node ) {
-      // prevent endless loop by checking against 0
-      if ( 0 == priority ) {
-        break;
-      }
-      // skip if no such queue exists
-      continue;
-    }
-
-    // get queue
-    task_priority_queue_ptr_t current = TASK_QUEUE_GET_PRIORITY( current_node );
-    // check for no items left or empty list
-    if (
-      list_empty( current->thread_list )
-      || current->last_handled == ( task_thread_ptr_t )current->thread_list->last->data
-    ) {
-      // prevent endless loop by checking against 0
-      if ( 0 == priority ) {
-        break;
-      }
-      // skip if queue is handled
-      continue;
-    }
-
-    // find next thread in queue ( default case: start with first one )
-    list_item_ptr_t item = current->thread_list->first;
-    // debug output
-    #if defined( PRINT_PROCESS )
-      DEBUG_OUTPUT(
-        "current->last_handled = %p\r\n",
-        ( void* )current->last_handled );
-    #endif
-    // handle already executed entry
-    if ( current->last_handled != NULL ) {
-      // try to find element in list
-      item = list_lookup_data(
-        current->thread_list, ( void* )current->last_handled );
-      // assert result
-      assert( NULL != item );
-      // debug output
-      #if defined( PRINT_PROCESS )
-        DEBUG_OUTPUT( "item->data = %p\r\n", item->data );
-      #endif
-      // head to next
-      item = item->next;
-    }
-
-    // get next ready task
-    while ( NULL != item ) {
-      // get task object
-      task_thread_ptr_t task = ( task_thread_ptr_t )item->data;
-      // check for ready
-      if (
-        TASK_THREAD_STATE_READY == task->state
-        || TASK_THREAD_STATE_HALT_SWITCH == task->state
-      ) {
-        break;
-      }
-      // try next if not ready
-      item = item->next;
-    }
+  // return next thread
+  return next;
+}
 
-    // skip if nothing is existing after last handled
-    if ( NULL == item ) {
-      // prevent endless loop by checking against 0
-      if ( 0 == priority ) {
-        break;
-      }
-      // skip if nothing is left
-      continue;
-    }
-    // return next thread
-    return ( task_thread_ptr_t )item->data;
+/**
+ * @brief Get thread of any process by id
+ *
+ * @param id thread id
+ * @return task_thread_ptr_t thread or NULL if not existing
+ */
+task_thread_ptr_t task_thread_get_by_id( size_t id ) {
+  // find node in global tree
+  avl_node_ptr_t node = avl_find_by_data(
+    process_manager->tree_thread_id, ( void* )id );
+  // handle not existing
+  if ( NULL == node ) {
+    return NULL;
   }
-
-  // return NULL
-  return NULL;
+  // return thread
+  return TASK_THREAD_GET_GLOBAL_BLOCK( node );
 }
@@ -0,0 +1,261 @@
+
+/**
+ * Copyright (C) 2018 - 2020 bolthur project.
+ *
+ * This file is part of bolthur/kernel.
+ *
+ * bolthur/kernel is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * bolthur/kernel is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stddef.h>
+#include <assert.h>
+#include <core/debug/debug.h>
+#include <core/event.h>
+#include <core/task/process.h>
+#include <core/task/queue.h>
+#include <core/task/thread.h>
+#include <core/task/wait.h>
+#include <core/timer.h>
+
+/**
+ * @brief Sleeping threads ordered by wakeup deadline in microseconds
+ */
+static task_wait_queue_t sleep_queue = { NULL, NULL };
+
+/**
+ * @brief Helper to remove thread from run queue consideration
+ *
+ * @param thread thread to block
+ */
+static void block( task_thread_ptr_t thread ) {
+  // assert running thread
+  assert( NULL != thread );
+  assert( TASK_THREAD_STATE_ACTIVE == thread->state );
+  // set state, blocked threads are not requeued by the scheduler
+  thread->state = TASK_THREAD_STATE_BLOCKED;
+  thread->queue_next = NULL;
+  // trigger scheduling
+  event_enqueue( EVENT_TIMER, EVENT_ORIGIN_USER );
+}
+
+/**
+ * @brief Helper to make a blocked thread runnable again
+ *
+ * @param thread thread to unblock
+ */
+static void unblock( task_thread_ptr_t thread ) {
+  // assert blocked thread
+  assert( TASK_THREAD_STATE_BLOCKED == thread->state );
+  // reset state and wakeup
+  thread->state = TASK_THREAD_STATE_READY;
+  thread->wakeup = 0;
+  // push to active run queue set
+  task_queue_push( process_manager->thread_run_queue, thread );
+}
+
+/**
+ * @brief Helper to wake up first thread of wait queue
+ *
+ * @param queue wait queue
+ * @return task_thread_ptr_t woken thread or NULL if queue is empty
+ */
+static task_thread_ptr_t wake_one( task_wait_queue_ptr_t queue ) {
+  // get first thread
+  task_thread_ptr_t thread = queue->first;
+  // handle empty queue
+  if ( NULL == thread ) {
+    return NULL;
+  }
+
+  // remove from queue
+  queue->first = thread->queue_next;
+  if ( NULL == queue->first ) {
+    queue->last = NULL;
+  }
+  thread->queue_next = NULL;
+
+  // debug output
+  #if defined( PRINT_PROCESS )
+    DEBUG_OUTPUT( "Wake thread %zu from queue %p\r\n",
+      thread->id, ( void* )queue );
+  #endif
+
+  // make thread runnable again
+  unblock( thread );
+  // return woken thread
+  return thread;
+}
+
+/**
+ * @brief Initialize wait queue
+ *
+ * @param queue wait queue to initialize
+ */
+void task_wait_queue_init( task_wait_queue_ptr_t queue ) {
+  queue->first = NULL;
+  queue->last = NULL;
+}
+
+/**
+ * @brief Block running thread without wait queue until resumed
+ *
+ * @param thread running thread to block
+ */
+void task_wait_suspend( task_thread_ptr_t thread ) {
+  // debug output
+  #if defined( PRINT_PROCESS )
+    DEBUG_OUTPUT( "Suspend thread %zu\r\n", thread->id );
+  #endif
+  // block thread
+  block( thread );
+}
+
+/**
+ * @brief Make blocked thread runnable, which isn't part of a wait queue
+ *
+ * @param thread thread to resume
+ */
+void task_wait_resume( task_thread_ptr_t thread ) {
+  // debug output
+  #if defined( PRINT_PROCESS )
+    DEBUG_OUTPUT( "Resume thread %zu\r\n", thread->id );
+  #endif
+  // make thread runnable again
+  unblock( thread );
+  // running thread has competition now, so a time slice end is necessary
+  task_process_timer_update();
+}
+
+/**
+ * @brief Block thread on wait queue until woken up
+ *
+ * @param queue wait queue
+ * @param thread running thread to block
+ */
+void task_wait_block( task_wait_queue_ptr_t queue, task_thread_ptr_t thread ) {
+  // debug output
+  #if defined( PRINT_PROCESS )
+    DEBUG_OUTPUT( "Block thread %zu on queue %p\r\n",
+      thread->id, ( void* )queue );
+  #endif
+
+  // block thread
+  block( thread );
+  // append to wait queue
+  if ( NULL == queue->last ) {
+    queue->first = thread;
+  } else {
+    queue->last->queue_next = thread;
+  }
+  queue->last = thread;
+}
+
+/**
+ * @brief Wake up first thread of wait queue
+ *
+ * @param queue wait queue
+ * @return task_thread_ptr_t woken thread or NULL if queue is empty
+ */
+task_thread_ptr_t task_wait_wake_one( task_wait_queue_ptr_t queue ) {
+  // wake thread
+  task_thread_ptr_t thread = wake_one( queue );
+  // running thread has competition now, so a time slice end is necessary
+  if ( NULL != thread ) {
+    task_process_timer_update();
+  }
+  // return woken thread
+  return thread;
+}
+
+/**
+ * @brief Wake up all threads of wait queue
+ *
+ * @param queue wait queue
+ * @return size_t amount of woken threads
+ */
+size_t task_wait_wake_all( task_wait_queue_ptr_t queue ) {
+  size_t count = 0;
+  // wake one after another
+  while ( NULL != wake_one( queue ) ) {
+    count++;
+  }
+  // program time slice end once
+  if ( 0 < count ) {
+    task_process_timer_update();
+  }
+  // return amount
+  return count;
+}
+
+/**
+ * @brief Put thread to sleep until deadline is reached
+ *
+ * @param thread running thread to put to sleep
+ * @param wakeup absolute microsecond deadline to wake up
+ */
+void task_wait_sleep( task_thread_ptr_t thread, uint64_t wakeup ) {
+  // debug output
+  #if defined( PRINT_PROCESS )
+    DEBUG_OUTPUT( "Sleep thread %zu until microsecond %llu\r\n",
+      thread->id, wakeup );
+  #endif
+
+  // block thread
+  block( thread );
+  thread->wakeup = wakeup;
+
+  // insert ordered by deadline, equal deadlines keep their order
+  task_thread_ptr_t previous = NULL;
+  task_thread_ptr_t current = sleep_queue.first;
+  while ( NULL != current && current->wakeup <= wakeup ) {
+    previous = current;
+    current = current->queue_next;
+  }
+  // link thread
+  thread->queue_next = current;
+  if ( NULL == previous ) {
+    sleep_queue.first = thread;
+  } else {
+    previous->queue_next = thread;
+  }
+  if ( NULL == current ) {
+    sleep_queue.last = thread;
+  }
+}
+
+/**
+ * @brief Wake up all sleeping threads with reached deadline
+ *
+ * @param microsecond current microsecond of timer
+ */
+void task_wait_wake_sleeping( uint64_t microsecond ) {
+  // wake sleeping threads in order until one is still in future
+  while (
+    NULL != sleep_queue.first
+    && sleep_queue.first->wakeup <= microsecond
+  ) {
+    wake_one( &sleep_queue );
+  }
+}
+
+/**
+ * @brief Get deadline of earliest sleeping thread
+ *
+ * @return uint64_t wakeup microsecond or TIMER_EXPIRY_NONE without sleeping thread
+ */
+uint64_t task_wait_next_wakeup( void ) {
+  return NULL != sleep_queue.first
+    ? sleep_queue.first->wakeup
+    : TIMER_EXPIRY_NONE;
+}
@@ -25,6 +25,7 @@
 #include <core/panic.h>
 #include <core/mm/virt.h>
 #include <core/mm/heap.h>
+#include <core/mm/slab.h>
 
 /**
  * @brief aligned memory allocation
@@ -34,6 +35,15 @@
  * @return void* reserved memory
  */
 void* aligned_alloc( size_t alignment, size_t size ) {
+  // try slab allocation for small objects
+  if ( slab_suitable( alignment, size ) ) {
+    uintptr_t addr = slab_allocate( alignment, size );
+    // return on success, else fall back to heap
+    if ( ( uintptr_t )NULL != addr ) {
+      return ( void* )addr;
+    }
+  }
+
   // use heap allocation
   return ( void* )heap_allocate_block( alignment, size );
 }
@@ -24,6 +24,7 @@
 #include <assert.h>
 #include <core/panic.h>
 #include <core/mm/heap.h>
+#include <core/mm/slab.h>
 
 /**
  * @brief Free allocated area
@@ -31,6 +32,12 @@
  * @param ptr ptr to address to free
  */
 void free( void *ptr ) {
+  // handle slab objects
+  if ( slab_responsible( ( uintptr_t )ptr ) ) {
+    slab_free( ( uintptr_t )ptr );
+    return;
+  }
+
   // free heap block
   heap_free_block( ( uintptr_t )ptr );
 }
@@ -22,6 +22,7 @@
 
 #include <string.h>
 #include <stdlib.h>
+#include <core/mm/slab.h>
 
 /**
  * @brief Realloc routine
@@ -44,8 +45,17 @@ void *realloc( void *ptr, size_t size ) {
     return NULL;
   }
 
+  // limit copy to object size for slab objects
+  size_t to_copy = size;
+  if (
+    slab_responsible( ( uintptr_t )ptr )
+    && slab_object_size( ( uintptr_t )ptr ) < to_copy
+  ) {
+    to_copy = slab_object_size( ( uintptr_t )ptr );
+  }
+
   // copy data
-  new_ptr = memcpy( new_ptr, ptr, size );
+  new_ptr = memcpy( new_ptr, ptr, to_copy );
 
   // mark current as free
   free( ptr );
@@ -22,6 +22,8 @@
 #include <stdint.h>
 #include <string.h>
 
+typedef uint32_t __may_alias word_t;
+
 /**
  * @brief Copy memory
  *
@@ -30,12 +32,51 @@
  * @param size
  * @return void*
  */
-void* memcpy( void* restrict dstptr, const void* restrict srcptr, size_t size ) {
+void* __no_tree_loop_distribute memcpy(
+  void* restrict dstptr,
+  const void* restrict srcptr,
+  size_t size
+) {
   uint8_t* dst = ( uint8_t * ) dstptr;
   const uint8_t* src = ( const uint8_t * ) srcptr;
 
-  for ( size_t i = 0; i < size; i++ ) {
-    dst[ i ] = src[ i ];
+  // word copy only possible with same alignment of source and destination
+  if ( ( uintptr_t )dst % sizeof( word_t ) == ( uintptr_t )src % sizeof( word_t ) ) {
+    // copy head until aligned
+    while ( 0 < size && 0 != ( uintptr_t )dst % sizeof( word_t ) ) {
+      *dst++ = *src++;
+      size--;
+    }
+
+    word_t* wdst = ( word_t* )dst;
+    const word_t* wsrc = ( const word_t* )src;
+    // copy blocks of eight words, ending up as ldm / stm
+    while ( 8 * sizeof( word_t ) <= size ) {
+      wdst[ 0 ] = wsrc[ 0 ];
+      wdst[ 1 ] = wsrc[ 1 ];
+      wdst[ 2 ] = wsrc[ 2 ];
+      wdst[ 3 ] = wsrc[ 3 ];
+      wdst[ 4 ] = wsrc[ 4 ];
+      wdst[ 5 ] = wsrc[ 5 ];
+      wdst[ 6 ] = wsrc[ 6 ];
+      wdst[ 7 ] = wsrc[ 7 ];
+      wdst += 8;
+      wsrc += 8;
+      size -= 8 * sizeof( word_t );
+    }
+    // copy remaining words
+    while ( sizeof( word_t ) <= size ) {
+      *wdst++ = *wsrc++;
+      size -= sizeof( word_t );
+    }
+
+    dst = ( uint8_t* )wdst;
+    src = ( const uint8_t* )wsrc;
+  }
+
+  // copy tail
+  while ( 0 < size-- ) {
+    *dst++ = *src++;
   }
 
   return dstptr;
@@ -20,21 +20,99 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include <string.h>
 
-void* memmove( void* dst, const void* src, size_t n ) {
+typedef uint32_t __may_alias word_t;
+
+void* __no_tree_loop_distribute memmove( void* dst, const void* src, size_t n ) {
   uint8_t *cdst = ( uint8_t* )dst;
   const uint8_t *csrc = ( const uint8_t* )src;
+  // word copy only possible with same alignment of source and destination
+  bool word = ( uintptr_t )cdst % sizeof( word_t )
+    == ( uintptr_t )csrc % sizeof( word_t );
 
+  // copy forward, reads are always ahead of writes
   if ( cdst < csrc ) {
-    for ( size_t i = 0; i < n; i++ ) {
-      cdst[ i ] = csrc[ i ];
+    if ( word ) {
+      // copy head until aligned
+      while ( 0 < n && 0 != ( uintptr_t )cdst % sizeof( word_t ) ) {
+        *cdst++ = *csrc++;
+        n--;
+      }
+
+      word_t* wdst = ( word_t* )cdst;
+      const word_t* wsrc = ( const word_t* )csrc;
+      // copy blocks of eight words in ascending order
+      while ( 8 * sizeof( word_t ) <= n ) {
+        wdst[ 0 ] = wsrc[ 0 ];
+        wdst[ 1 ] = wsrc[ 1 ];
+        wdst[ 2 ] = wsrc[ 2 ];
+        wdst[ 3 ] = wsrc[ 3 ];
+        wdst[ 4 ] = wsrc[ 4 ];
+        wdst[ 5 ] = wsrc[ 5 ];
+        wdst[ 6 ] = wsrc[ 6 ];
+        wdst[ 7 ] = wsrc[ 7 ];
+        wdst += 8;
+        wsrc += 8;
+        n -= 8 * sizeof( word_t );
+      }
+      // copy remaining words
+      while ( sizeof( word_t ) <= n ) {
+        *wdst++ = *wsrc++;
+        n -= sizeof( word_t );
+      }
+
+      cdst = ( uint8_t* )wdst;
+      csrc = ( const uint8_t* )wsrc;
+    }
+
+    // copy tail
+    while ( 0 < n-- ) {
+      *cdst++ = *csrc++;
     }
     return dst;
   }
 
-  for ( size_t i = n; i != 0; i-- ) {
-    cdst[ i - 1 ] = csrc[ i - 1 ];
+  // copy backward from the end, reads are always behind writes
+  cdst += n;
+  csrc += n;
+  if ( word ) {
+    // copy tail until aligned
+    while ( 0 < n && 0 != ( uintptr_t )cdst % sizeof( word_t ) ) {
+      *--cdst = *--csrc;
+      n--;
+    }
+
+    word_t* wdst = ( word_t* )cdst;
+    const word_t* wsrc = ( const word_t* )csrc;
+    // copy blocks of eight words in descending order
+    while ( 8 * sizeof( word_t ) <= n ) {
+      wdst -= 8;
+      wsrc -= 8;
+      wdst[ 7 ] = wsrc[ 7 ];
+      wdst[ 6 ] = wsrc[ 6 ];
+      wdst[ 5 ] = wsrc[ 5 ];
+      wdst[ 4 ] = wsrc[ 4 ];
+      wdst[ 3 ] = wsrc[ 3 ];
+      wdst[ 2 ] = wsrc[ 2 ];
+      wdst[ 1 ] = wsrc[ 1 ];
+      wdst[ 0 ] = wsrc[ 0 ];
+      n -= 8 * sizeof( word_t );
+    }
+    // copy remaining words
+    while ( sizeof( word_t ) <= n ) {
+      *--wdst = *--wsrc;
+      n -= sizeof( word_t );
+    }
+
+    cdst = ( uint8_t* )wdst;
+    csrc = ( const uint8_t* )wsrc;
+  }
+
+  // copy head
+  while ( 0 < n-- ) {
+    *--cdst = *--csrc;
   }
   return dst;
 }
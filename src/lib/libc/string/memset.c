@@ -22,6 +22,8 @@
 #include <stdint.h>
 #include <string.h>
 
+typedef uint32_t __may_alias word_t;
+
 /**
  * @brief Fill address with value
  *
@@ -30,11 +32,41 @@
  * @param size
  * @return void*
  */
-void* memset( void* bufptr, int value, size_t size ) {
+void* __no_tree_loop_distribute memset( void* bufptr, int value, size_t size ) {
   uint8_t* buf = ( uint8_t* ) bufptr;
 
-  for ( size_t i = 0; i < size; i++ ) {
-    buf[ i ] = ( uint8_t ) value;
+  // set head until aligned
+  while ( 0 < size && 0 != ( uintptr_t )buf % sizeof( word_t ) ) {
+    *buf++ = ( uint8_t ) value;
+    size--;
+  }
+
+  // replicate byte into word
+  word_t pattern = ( word_t )( uint8_t )value * 0x01010101;
+  word_t* wbuf = ( word_t* )buf;
+  // set blocks of eight words, ending up as stm
+  while ( 8 * sizeof( word_t ) <= size ) {
+    wbuf[ 0 ] = pattern;
+    wbuf[ 1 ] = pattern;
+    wbuf[ 2 ] = pattern;
+    wbuf[ 3 ] = pattern;
+    wbuf[ 4 ] = pattern;
+    wbuf[ 5 ] = pattern;
+    wbuf[ 6 ] = pattern;
+    wbuf[ 7 ] = pattern;
+    wbuf += 8;
+    size -= 8 * sizeof( word_t );
+  }
+  // set remaining words
+  while ( sizeof( word_t ) <= size ) {
+    *wbuf++ = pattern;
+    size -= sizeof( word_t );
+  }
+
+  // set tail
+  buf = ( uint8_t* )wbuf;
+  while ( 0 < size-- ) {
+    *buf++ = ( uint8_t ) value;
   }
 
   return bufptr;
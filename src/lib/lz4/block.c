@@ -0,0 +1,147 @@
+
+/**
+ * Copyright (C) 2018 - 2020 bolthur project.
+ *
+ * This file is part of bolthur/kernel.
+ *
+ * bolthur/kernel is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * bolthur/kernel is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+#include <lz4.h>
+
+/**
+ * @brief Helper to read extended length bytes of a sequence
+ *
+ * @param src current source position
+ * @param end end of source block
+ * @param length length to extend
+ * @return true on success
+ * @return false on truncated input
+ */
+static bool block_length( const uint8_t** src, const uint8_t* end, size_t* length ) {
+  uint8_t value;
+  // add bytes until one is not 255
+  do {
+    // handle truncated input
+    if ( *src >= end ) {
+      return false;
+    }
+    // get byte and add it
+    value = *( *src )++;
+    *length += value;
+  } while ( 255 == value );
+  // return success
+  return true;
+}
+
+/**
+ * @brief Decompress one lz4 block
+ *
+ * Decodes the sequences of one block behind the already decompressed output
+ * at dst + position. Matches may reference any earlier output, so linked
+ * blocks of a frame work as long as the output is kept contiguous. Passing
+ * NULL as destination only validates the block and advances the position,
+ * which is used to determine the decompressed size.
+ *
+ * @param src compressed block
+ * @param size compressed block size
+ * @param dst destination or NULL to count only
+ * @param position current output position, updated on success
+ * @param capacity destination capacity
+ * @return true on success
+ * @return false on malformed input or insufficient capacity
+ */
+bool lz4_block_decompress(
+  const uint8_t* src,
+  size_t size,
+  uint8_t* dst,
+  size_t* position,
+  size_t capacity
+) {
+  const uint8_t* end = src + size;
+  size_t pos = *position;
+
+  // loop through sequences
+  while ( src < end ) {
+    // get token
+    uint8_t token = *src++;
+
+    // get literal length
+    size_t literal = ( size_t )( token >> 4 );
+    if ( 15 == literal && ! block_length( &src, end, &literal ) ) {
+      return false;
+    }
+    // validate literal length against input and output
+    if ( ( size_t )( end - src ) < literal || capacity - pos < literal ) {
+      return false;
+    }
+    // copy literals
+    if ( dst ) {
+      memcpy( dst + pos, src, literal );
+    }
+    src += literal;
+    pos += literal;
+
+    // last sequence consists only of literals
+    if ( src == end ) {
+      break;
+    }
+
+    // get match offset
+    if ( 2 > ( size_t )( end - src ) ) {
+      return false;
+    }
+    size_t offset = ( size_t )src[ 0 ] | ( ( size_t )src[ 1 ] << 8 );
+    src += 2;
+    // offset has to point into already decompressed data
+    if ( 0 == offset || offset > pos ) {
+      return false;
+    }
+
+    // get match length
+    size_t match = ( size_t )( token & 0xF );
+    if ( 15 == match && ! block_length( &src, end, &match ) ) {
+      return false;
+    }
+    match += LZ4_BLOCK_MIN_MATCH;
+    // validate match length against output
+    if ( capacity - pos < match ) {
+      return false;
+    }
+
+    // copy match
+    if ( dst ) {
+      uint8_t* out = dst + pos;
+      const uint8_t* in = out - offset;
+      // overlapping matches repeat the pattern and need to be copied bytewise
+      if ( offset < match ) {
+        for ( size_t idx = 0; idx < match; idx++ ) {
+          out[ idx ] = in[ idx ];
+        }
+      } else {
+        memcpy( out, in, match );
+      }
+    }
+    pos += match;
+  }
+
+  // update position
+  *position = pos;
+  // return success
+  return true;
+}
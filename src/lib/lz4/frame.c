@@ -0,0 +1,315 @@
+
+/**
+ * Copyright (C) 2018 - 2020 bolthur project.
+ *
+ * This file is part of bolthur/kernel.
+ *
+ * bolthur/kernel is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * bolthur/kernel is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+#include <lz4.h>
+
+/**
+ * @brief Helper to read unaligned little endian 32 bit value
+ *
+ * @param src
+ * @return uint32_t
+ */
+static uint32_t read32( const uint8_t* src ) {
+  return ( uint32_t )src[ 0 ]
+    | ( ( uint32_t )src[ 1 ] << 8 )
+    | ( ( uint32_t )src[ 2 ] << 16 )
+    | ( ( uint32_t )src[ 3 ] << 24 );
+}
+
+/**
+ * @brief Helper to read unaligned little endian 64 bit value
+ *
+ * @param src
+ * @return uint64_t
+ */
+static uint64_t read64( const uint8_t* src ) {
+  return ( uint64_t )read32( src ) | ( ( uint64_t )read32( src + 4 ) << 32 );
+}
+
+/**
+ * @brief Walk through one lz4 frame
+ *
+ * @param src frame start after magic
+ * @param end end of compressed data
+ * @param dst destination or NULL to determine size only
+ * @param position current output position, updated on success
+ * @param capacity destination capacity
+ * @return const uint8_t* end of frame or NULL on error
+ */
+static const uint8_t* walk_frame(
+  const uint8_t* src,
+  const uint8_t* end,
+  uint8_t* dst,
+  size_t* position,
+  size_t capacity
+) {
+  // frame descriptor has at least flag, block descriptor and checksum
+  if ( 3 > end - src ) {
+    return NULL;
+  }
+  // get flags
+  uint8_t flag = src[ 0 ];
+  src += 2;
+  // check version and refuse dictionaries
+  if (
+    LZ4_FRAME_VERSION != ( flag & LZ4_FRAME_VERSION_MASK )
+    || ( flag & LZ4_FRAME_DICTIONARY_ID )
+  ) {
+    return NULL;
+  }
+
+  // handle optional content size
+  uint64_t content = 0;
+  bool has_content = flag & LZ4_FRAME_CONTENT_SIZE;
+  if ( has_content ) {
+    // validate remaining size
+    if ( 9 > end - src ) {
+      return NULL;
+    }
+    content = read64( src );
+    src += 8;
+    // content has to fit
+    if ( content > capacity - *position ) {
+      return NULL;
+    }
+  }
+  // skip header checksum
+  src++;
+
+  // size only with known content size allows to skip block decoding
+  size_t start = *position;
+  bool skip = ! dst && has_content;
+
+  // loop through blocks
+  while ( true ) {
+    // get block size
+    if ( 4 > end - src ) {
+      return NULL;
+    }
+    uint32_t block = read32( src );
+    src += 4;
+    // end mark reached
+    if ( 0 == block ) {
+      break;
+    }
+
+    // extract size and validate
+    size_t size = block & ~LZ4_BLOCK_UNCOMPRESSED;
+    if ( ( size_t )( end - src ) < size ) {
+      return NULL;
+    }
+
+    // uncompressed blocks are copied
+    if ( ! skip && ( block & LZ4_BLOCK_UNCOMPRESSED ) ) {
+      // validate capacity
+      if ( capacity - *position < size ) {
+        return NULL;
+      }
+      // copy data
+      if ( dst ) {
+        memcpy( dst + *position, src, size );
+      }
+      *position += size;
+    // decompress block
+    } else if (
+      ! skip
+      && ! lz4_block_decompress( src, size, dst, position, capacity )
+    ) {
+      return NULL;
+    }
+    src += size;
+
+    // skip block checksum
+    if ( flag & LZ4_FRAME_BLOCK_CHECKSUM ) {
+      src += 4;
+    }
+  }
+
+  // skip content checksum
+  if ( flag & LZ4_FRAME_CONTENT_CHECKSUM ) {
+    src += 4;
+  }
+  // validate end
+  if ( src > end ) {
+    return NULL;
+  }
+
+  // apply or check content size
+  if ( skip ) {
+    *position += ( size_t )content;
+  } else if ( has_content && *position - start != content ) {
+    return NULL;
+  }
+  // return end of frame
+  return src;
+}
+
+/**
+ * @brief Walk through legacy lz4 stream
+ *
+ * @param src stream start after magic
+ * @param end end of compressed data
+ * @param dst destination or NULL to determine size only
+ * @param position current output position, updated on success
+ * @param capacity destination capacity
+ * @return const uint8_t* end of stream or NULL on error
+ */
+static const uint8_t* walk_legacy(
+  const uint8_t* src,
+  const uint8_t* end,
+  uint8_t* dst,
+  size_t* position,
+  size_t capacity
+) {
+  // legacy streams have no end mark, so loop until end of data
+  while ( 4 <= end - src ) {
+    // get block size
+    uint32_t size = read32( src );
+    // stop at next stream or frame
+    if (
+      LZ4_LEGACY_MAGIC == size
+      || LZ4_FRAME_MAGIC == size
+      || LZ4_SKIPPABLE_MAGIC == ( size & LZ4_SKIPPABLE_MASK )
+    ) {
+      break;
+    }
+    // stop at padding
+    if ( 0 == size ) {
+      return end;
+    }
+    src += 4;
+    // validate size
+    if ( ( size_t )( end - src ) < size ) {
+      return NULL;
+    }
+    // decompress block, legacy blocks are always independent
+    if ( ! lz4_block_decompress( src, size, dst, position, capacity ) ) {
+      return NULL;
+    }
+    src += size;
+  }
+  // return end of stream
+  return src;
+}
+
+/**
+ * @brief Walk through compressed data consisting of frames and streams
+ *
+ * @param address compressed data
+ * @param size compressed size
+ * @param dst destination or NULL to determine size only
+ * @param capacity destination capacity
+ * @return size_t decompressed size or 0 on error
+ */
+static size_t walk( uintptr_t address, size_t size, uint8_t* dst, size_t capacity ) {
+  const uint8_t* src = ( const uint8_t* )address;
+  const uint8_t* end = src + size;
+  size_t position = 0;
+  bool found = false;
+
+  // loop through frames
+  while ( 4 <= end - src ) {
+    // get magic
+    uint32_t magic = read32( src );
+    src += 4;
+
+    // handle frame types
+    if ( LZ4_FRAME_MAGIC == magic ) {
+      src = walk_frame( src, end, dst, &position, capacity );
+    } else if ( LZ4_LEGACY_MAGIC == magic ) {
+      src = walk_legacy( src, end, dst, &position, capacity );
+    } else if (
+      LZ4_SKIPPABLE_MAGIC == ( magic & LZ4_SKIPPABLE_MASK )
+      && 4 <= end - src
+      && read32( src ) <= ( size_t )( end - src ) - 4
+    ) {
+      src += 4 + read32( src );
+      continue;
+    // trailing padding after at least one frame is ignored
+    } else if ( found ) {
+      break;
+    } else {
+      return 0;
+    }
+
+    // handle error
+    if ( ! src ) {
+      return 0;
+    }
+    found = true;
+  }
+
+  // return decompressed size
+  return position;
+}
+
+/**
+ * @brief Check whether data is lz4 compressed
+ *
+ * @param address
+ * @param size
+ * @return true data starts with lz4 frame or legacy magic
+ * @return false otherwise
+ */
+bool lz4_check( uintptr_t address, size_t size ) {
+  // check size
+  if ( 4 > size ) {
+    return false;
+  }
+  // check magic
+  uint32_t magic = read32( ( const uint8_t* )address );
+  return LZ4_FRAME_MAGIC == magic || LZ4_LEGACY_MAGIC == magic;
+}
+
+/**
+ * @brief Determine decompressed size of lz4 data
+ *
+ * Frames with content size are skipped without decoding, other frames and
+ * legacy streams are validated completely.
+ *
+ * @param address compressed data
+ * @param size compressed size
+ * @return size_t decompressed size or 0 on error
+ */
+size_t lz4_size( uintptr_t address, size_t size ) {
+  return walk( address, size, NULL, SIZE_MAX );
+}
+
+/**
+ * @brief Decompress lz4 data
+ *
+ * @param address compressed data
+ * @param size compressed size
+ * @param destination destination
+ * @param capacity destination capacity
+ * @return size_t decompressed size or 0 on error
+ */
+size_t lz4_decompress(
+  uintptr_t address,
+  size_t size,
+  uintptr_t destination,
+  size_t capacity
+) {
+  return walk( address, size, ( uint8_t* )destination, capacity );
+}
@@ -0,0 +1,209 @@
+
+/**
+ * Copyright (C) 2018 - 2020 bolthur project.
+ *
+ * This file is part of bolthur/kernel.
+ *
+ * bolthur/kernel is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * bolthur/kernel is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <tar.h>
+
+/**
+ * @brief Initial amount of entries, doubled when exceeded
+ */
+#define TAR_INDEX_INITIAL_CAPACITY 16
+
+/**
+ * @brief Helper to hash file name with fnv-1a
+ *
+ * @param name file name
+ * @param length name length
+ * @return uint32_t
+ */
+static uint32_t hash_name( const char* name, size_t length ) {
+  uint32_t hash = 2166136261U;
+  // process byte by byte
+  for ( size_t index = 0; index < length; index++ ) {
+    hash ^= ( uint8_t )name[ index ];
+    hash *= 16777619U;
+  }
+  // return hash
+  return hash;
+}
+
+/**
+ * @brief Build index of tar once for constant time lookup
+ *
+ * @param address tar start address
+ * @return tar_index_ptr_t created index or NULL on error
+ */
+tar_index_ptr_t tar_index_create( uintptr_t address ) {
+  size_t capacity = TAR_INDEX_INITIAL_CAPACITY;
+
+  // allocate index
+  tar_index_ptr_t index = ( tar_index_ptr_t )malloc( sizeof( tar_index_t ) );
+  if ( NULL == index ) {
+    return NULL;
+  }
+  memset( ( void* )index, 0, sizeof( tar_index_t ) );
+  // allocate initial entries
+  index->entry = ( tar_index_entry_ptr_t )malloc(
+    capacity * sizeof( tar_index_entry_t ) );
+  if ( NULL == index->entry ) {
+    tar_index_destroy( index );
+    return NULL;
+  }
+
+  // fill entries in archive order within a single pass, so that each header
+  // is parsed only once
+  tar_header_ptr_t iter = ( tar_header_ptr_t )address;
+  while ( '\0' != iter->file_name[ 0 ] ) {
+    // grow entries if necessary
+    if ( capacity == index->count ) {
+      tar_index_entry_ptr_t grown = ( tar_index_entry_ptr_t )realloc(
+        ( void* )index->entry, capacity * 2 * sizeof( tar_index_entry_t ) );
+      if ( NULL == grown ) {
+        tar_index_destroy( index );
+        return NULL;
+      }
+      index->entry = grown;
+      capacity *= 2;
+    }
+    // populate entry
+    tar_index_entry_ptr_t entry = &index->entry[ index->count++ ];
+    entry->name = iter->file_name;
+    entry->name_length = strnlen( iter->file_name, TAR_FILE_NAME_SIZE );
+    entry->hash = hash_name( entry->name, entry->name_length );
+    entry->header = iter;
+    entry->data = tar_file( iter );
+    entry->size = tar_size( iter );
+    // step behind file content padded to full blocks
+    iter = ( tar_header_ptr_t )( entry->data
+      + ( entry->size + TAR_HEADER_SIZE - 1 ) / TAR_HEADER_SIZE * TAR_HEADER_SIZE );
+  }
+
+  // at least twice as many buckets as entries as power of two
+  index->bucket_count = 1;
+  while ( index->bucket_count < index->count * 2 ) {
+    index->bucket_count <<= 1;
+  }
+  // allocate buckets
+  index->bucket = ( tar_index_entry_ptr_t* )malloc(
+    index->bucket_count * sizeof( tar_index_entry_ptr_t ) );
+  if ( NULL == index->bucket ) {
+    tar_index_destroy( index );
+    return NULL;
+  }
+  memset(
+    ( void* )index->bucket, 0,
+    index->bucket_count * sizeof( tar_index_entry_ptr_t ) );
+  // push entries to buckets, entries don't move any longer
+  for ( size_t position = 0; position < index->count; position++ ) {
+    tar_index_entry_ptr_t entry = &index->entry[ position ];
+    size_t slot = entry->hash & ( index->bucket_count - 1 );
+    entry->next = index->bucket[ slot ];
+    index->bucket[ slot ] = entry;
+  }
+
+  // return index
+  return index;
+}
+
+/**
+ * @brief Destroy tar index
+ *
+ * @param index index to destroy
+ */
+void tar_index_destroy( tar_index_ptr_t index ) {
+  // handle invalid
+  if ( NULL == index ) {
+    return;
+  }
+  // free everything
+  free( index->bucket );
+  free( index->entry );
+  free( index );
+}
+
+/**
+ * @brief Lookup file by name
+ *
+ * @param index index to use
+ * @param file_name file name to look up
+ * @return tar_index_entry_ptr_t found entry or NULL
+ */
+tar_index_entry_ptr_t tar_index_lookup(
+  tar_index_ptr_t index,
+  const char* file_name
+) {
+  size_t length = strlen( file_name );
+  uint32_t hash = hash_name( file_name, length );
+
+  // walk bucket chain
+  for (
+    tar_index_entry_ptr_t entry = index->bucket[ hash & ( index->bucket_count - 1 ) ];
+    NULL != entry;
+    entry = entry->next
+  ) {
+    if (
+      hash == entry->hash
+      && length == entry->name_length
+      && 0 == memcmp( entry->name, file_name, length )
+    ) {
+      return entry;
+    }
+  }
+
+  // nothing found
+  return NULL;
+}
+
+/**
+ * @brief Iterate entries starting with prefix in archive order
+ *
+ * @param index index to use
+ * @param prefix directory prefix like "boot/", empty string for all entries
+ * @param previous previous entry or NULL to start iteration
+ * @return tar_index_entry_ptr_t next matching entry or NULL at the end
+ */
+tar_index_entry_ptr_t tar_index_next(
+  tar_index_ptr_t index,
+  const char* prefix,
+  tar_index_entry_ptr_t previous
+) {
+  size_t length = strlen( prefix );
+  tar_index_entry_ptr_t end = index->entry + index->count;
+
+  // continue after previous or start at first entry
+  for (
+    tar_index_entry_ptr_t entry = NULL != previous ? previous + 1 : index->entry;
+    entry < end;
+    entry++
+  ) {
+    if (
+      length <= entry->name_length
+      && 0 == memcmp( entry->name, prefix, length )
+    ) {
+      return entry;
+    }
+  }
+
+  // nothing left
+  return NULL;
+}
@@ -32,6 +32,7 @@
 
 #include <core/mm/phys.h>
 #include <arch/arm/barrier.h>
+#include <arch/arm/cache.h>
 #include <core/mm/virt.h>
 
 /**
@@ -49,6 +50,11 @@ static volatile uint8_t* framebuffer_address = NULL;
  */
 static uint32_t framebuffer_size = 0;
 
+/**
+ * @brief Framebuffer physical address
+ */
+static uint64_t framebuffer_physical = 0;
+
 /**
  * @brief Resolution width
  */
@@ -79,6 +85,16 @@ static int32_t coordinate_y = 0;
  */
 static int32_t pitch = 0;
 
+/**
+ * @brief First row drawn but not yet pushed to memory, -1 if clean
+ */
+static int32_t dirty_start = -1;
+
+/**
+ * @brief Row after last row drawn but not yet pushed to memory
+ */
+static int32_t dirty_end = 0;
+
 /**
  * @brief Initialize framebuffer
  */
@@ -129,6 +145,8 @@ void framebuffer_init( void ) {
     // push back
     framebuffer_base_set( base );
   }
+  // save physical address, base is replaced by virtual one later
+  framebuffer_physical = ( uint64_t )framebuffer_base_get();
 
   // map initially
   uintptr_t start = framebuffer_base_get();
@@ -169,6 +187,24 @@ uintptr_t framebuffer_end_get( void ) {
   return ( uintptr_t )( framebuffer_address + framebuffer_size );
 }
 
+/**
+ * @brief Get physical address of frame buffer
+ *
+ * @return uint64_t
+ */
+uint64_t framebuffer_physical_get( void ) {
+  return framebuffer_physical;
+}
+
+/**
+ * @brief Get size of frame buffer
+ *
+ * @return size_t
+ */
+size_t framebuffer_size_get( void ) {
+  return ( size_t )framebuffer_size;
+}
+
 /**
  * @brief Internal method to put pixel
  *
@@ -216,21 +252,39 @@ static void scroll( void ) {
   memmove( ( void* )framebuffer_address, ( void* )src, max_y * row_size );
   // erase last line
   memset( ( void*  )( framebuffer_address + ( max_y * row_size ) ), 0, row_size );
+  // push whole screen to memory, which includes pending rows
+  cache_clean_range(
+    ( uintptr_t )framebuffer_address, ( max_y + 1 ) * row_size );
+  dirty_start = -1;
+  dirty_end = 0;
   // reset x
   coordinate_x = 0;
 }
 
 /**
- * @brief Print character to framebuffer
- *
- * @param c character to print
+ * @brief Push drawn but not yet cleaned rows to memory
  */
-void framebuffer_putc( uint8_t c ) {
-  // ensure initialized environment
-  if ( ! framebuffer_initialized ) {
+static void flush( void ) {
+  // skip if nothing is pending
+  if ( -1 == dirty_start ) {
     return;
   }
+  // clean rows at once
+  cache_clean_range(
+    ( uintptr_t )&framebuffer_address[ dirty_start * pitch ],
+    ( size_t )( ( dirty_end - dirty_start ) * pitch )
+  );
+  // reset dirty range
+  dirty_start = -1;
+  dirty_end = 0;
+}
 
+/**
+ * @brief Draw character without pushing it to memory
+ *
+ * @param c character to draw
+ */
+static void draw( uint8_t c ) {
   // used variables
   int32_t offset;
 
@@ -284,7 +338,48 @@ void framebuffer_putc( uint8_t c ) {
           set_color
         );
       }
+      // extend dirty range by glyph rows
+      if ( -1 == dirty_start || coordinate_y < dirty_start ) {
+        dirty_start = coordinate_y;
+      }
+      if ( coordinate_y + FONT_HEIGHT > dirty_end ) {
+        dirty_end = coordinate_y + FONT_HEIGHT;
+      }
       // increase x coordinate
       coordinate_x += FONT_WIDTH;
   }
 }
+
+/**
+ * @brief Print character to framebuffer
+ *
+ * @param c character to print
+ */
+void framebuffer_putc( uint8_t c ) {
+  // ensure initialized environment
+  if ( ! framebuffer_initialized ) {
+    return;
+  }
+  // draw and push to memory
+  draw( c );
+  flush();
+}
+
+/**
+ * @brief Print characters to framebuffer with one cache clean
+ *
+ * @param buffer characters to print
+ * @param length amount of characters
+ */
+void framebuffer_write( const uint8_t* buffer, size_t length ) {
+  // ensure initialized environment
+  if ( ! framebuffer_initialized ) {
+    return;
+  }
+  // draw all characters
+  for ( size_t idx = 0; idx < length; idx++ ) {
+    draw( buffer[ idx ] );
+  }
+  // push drawn rows to memory
+  flush();
+}
@@ -27,6 +27,29 @@
 #include <platform/rpi/gpio.h>
 #include <platform/rpi/peripheral.h>
 
+/**
+ * @brief Basic pending bit signaling set bits in pending register 1
+ */
+#define INTERRUPT_BASIC_PENDING_1 ( 1U << 8 )
+
+/**
+ * @brief Basic pending bit signaling set bits in pending register 2
+ */
+#define INTERRUPT_BASIC_PENDING_2 ( 1U << 9 )
+
+/**
+ * @brief Offset and mask of shortcut bits within basic pending register
+ */
+#define INTERRUPT_BASIC_SHORTCUT_SHIFT 10
+#define INTERRUPT_BASIC_SHORTCUT_MASK 0x7FF
+
+/**
+ * @brief Interrupt numbers of basic pending shortcut bits
+ */
+static const int8_t shortcut_interrupt[] = {
+  7, 9, 10, 18, 19, 53, 54, 55, 56, 57, 62
+};
+
 /**
  * @brief Helper to validate interrupt number
  *
@@ -60,28 +83,36 @@ int8_t interrupt_get_pending( bool fast ) {
 
   // normal interrupt
   if ( ! fast ) {
-    uint32_t pending1 = io_in32( base + INTERRUPT_IRQ_PENDING_1 );
-    uint32_t pending2 = io_in32( base + INTERRUPT_IRQ_PENDING_2 );
-
     #if defined( BCM2836 ) || defined( BCM2837 )
-      base = peripheral_base_get( PERIPHERAL_LOCAL );
-      uint32_t core0_interrupt_source = io_in32( ( uint32_t )base + CORE0_IRQ_SOURCE );
+      uintptr_t local = peripheral_base_get( PERIPHERAL_LOCAL );
+      uint32_t core0_interrupt_source = io_in32( ( uint32_t )local + CORE0_IRQ_SOURCE );
       if ( core0_interrupt_source & 0x08 ) {
         return 8;
       }
     #endif
 
-    for ( int8_t i = 0; i < 32; ++i ) {
-      uint32_t check_bit = ( 1U << i );
+    // basic pending summarizes both pending registers
+    uint32_t basic = io_in32( base + INTERRUPT_IRQ_BASIC_PENDING );
+    // shortcut bits don't need another register read
+    uint32_t shortcut = ( basic >> INTERRUPT_BASIC_SHORTCUT_SHIFT )
+      & INTERRUPT_BASIC_SHORTCUT_MASK;
+    if ( 0 != shortcut ) {
+      return shortcut_interrupt[ __builtin_ctz( shortcut ) ];
+    }
 
-      // check first pending register
-      if ( pending1 & check_bit ) {
-        return i;
+    // check first pending register
+    if ( basic & INTERRUPT_BASIC_PENDING_1 ) {
+      uint32_t pending1 = io_in32( base + INTERRUPT_IRQ_PENDING_1 );
+      if ( 0 != pending1 ) {
+        return ( int8_t )__builtin_ctz( pending1 );
       }
+    }
 
-      // check second pending register
-      if ( pending2 & check_bit ) {
-        return ( int8_t )( i + 32 );
+    // check second pending register
+    if ( basic & INTERRUPT_BASIC_PENDING_2 ) {
+      uint32_t pending2 = io_in32( base + INTERRUPT_IRQ_PENDING_2 );
+      if ( 0 != pending2 ) {
+        return ( int8_t )( __builtin_ctz( pending2 ) + 32 );
       }
     }
   // fast interrupt handling
@@ -25,6 +25,7 @@
 #include <core/debug/debug.h>
 #include <core/entry.h>
 #include <core/mm/phys.h>
+#include <arch/arm/cache.h>
 #include <platform/rpi/mailbox/mailbox.h>
 #include <platform/rpi/mailbox/property.h>
 
@@ -258,6 +259,9 @@ uint32_t mailbox_property_process( void ) {
     }
   #endif
 
+  // push request to memory for the video core
+  cache_clean_range( ( uintptr_t )ptb_buffer, PAGE_SIZE );
+
   // write to mailbox
   mailbox_write(
     MAILBOX0_TAGS_ARM_TO_VC,
@@ -267,6 +271,9 @@ uint32_t mailbox_property_process( void ) {
   // read result
   result = mailbox_read( MAILBOX0_TAGS_ARM_TO_VC, GPU_MAILBOX );
 
+  // drop cached lines to see the response of the video core
+  cache_invalidate_range( ( uintptr_t )ptb_buffer, PAGE_SIZE );
+
   // debug output
   #if defined( PRINT_MAILBOX )
     for ( int32_t i = 0; i < ( ptb_buffer[ PT_OSIZE ] >> 2 ); i++ ) {
@@ -0,0 +1,57 @@
+
+/**
+ * Copyright (C) 2018 - 2020 bolthur project.
+ *
+ * This file is part of bolthur/kernel.
+ *
+ * bolthur/kernel is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * bolthur/kernel is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stddef.h>
+#include <core/entry.h>
+#include <core/debug/debug.h>
+#include <core/mm/phys.h>
+#include <core/mm/virt.h>
+#include <core/mm/shared.h>
+#include <platform/rpi/framebuffer.h>
+
+/**
+ * @brief Register platform shared memory objects
+ *
+ * @todo pass offset of framebuffer within first page to display server
+ */
+void shared_platform_init( void ) {
+  // get framebuffer, not existing when output is disabled
+  uint64_t start = framebuffer_physical_get();
+  size_t size = framebuffer_size_get();
+  if ( 0 == size ) {
+    return;
+  }
+
+  // extend to full pages
+  size += ( size_t )( start % PAGE_SIZE );
+  start -= start % PAGE_SIZE;
+  // register framebuffer as display object, uncached for user writes
+  if ( ! shared_create_fixed(
+    SHARED_ID_DISPLAY, start, size, VIRT_MEMORY_TYPE_NORMAL_NC
+  ) ) {
+    return;
+  }
+
+  // debug output
+  #if defined( PRINT_MM_SHARED )
+    DEBUG_OUTPUT( "Registered framebuffer %#llx as shared object %d\r\n",
+      start, SHARED_ID_DISPLAY );
+  #endif
+}
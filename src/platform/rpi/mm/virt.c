@@ -36,7 +36,18 @@
   #define CPU_PERIPHERAL_BASE 0xF3000000
 #endif
 #define MAILBOX_PROPERTY_AREA 0xF3040000
-#define FRAMEBUFFER_AREA 0xF3041000
+#define FRAMEBUFFER_AREA 0xF4000000
+
+/**
+ * @brief Framebuffer keeps physical offset within this size, so that the
+ * range mapping is able to use sections and blocks
+ */
+#define FRAMEBUFFER_ALIGNMENT 0x200000
+
+/**
+ * @brief Startup mappings are done with sections or blocks
+ */
+#define STARTUP_MAPPING_STEP 0x100000
 
 /**
  * @brief Method to setup short descriptor paging
@@ -51,8 +62,8 @@ void __bootstrap virt_startup_platform_setup( void ) {
     while ( cpu_peripheral_base < cpu_peripheral_end ) {
       // identity map gpio
       virt_startup_map( ( uint64_t )cpu_peripheral_base, cpu_peripheral_base );
-      // next page
-      cpu_peripheral_base += PAGE_SIZE;
+      // next section
+      cpu_peripheral_base += STARTUP_MAPPING_STEP;
     }
   #endif
 
@@ -70,8 +81,8 @@ void __bootstrap virt_startup_platform_setup( void ) {
   while ( gpio_peripheral_base < gpio_peripheral_end ) {
     // identity map gpio
     virt_startup_map( ( uint64_t )gpio_peripheral_base, gpio_peripheral_base );
-    // next page
-    gpio_peripheral_base += PAGE_SIZE;
+    // next section
+    gpio_peripheral_base += STARTUP_MAPPING_STEP;
   }
 }
 
@@ -80,24 +91,21 @@ void __bootstrap virt_startup_platform_setup( void ) {
  */
 void virt_platform_init( void ) {
   uintptr_t start;
-  uintptr_t virtual;
+  uintptr_t end;
 
-  // set start and virtual
+  // set start and end
   start = framebuffer_base_get();
-  virtual = FRAMEBUFFER_AREA;
-  // map framebuffer
-  while ( start < framebuffer_end_get() ) {
-    // map framebuffer
-    virt_map_address(
+  end = framebuffer_end_get();
+  // map framebuffer cacheable, written areas are cleaned explicitly
+  if ( start < end ) {
+    virt_map_range(
       kernel_context,
-      virtual,
+      FRAMEBUFFER_AREA + start % FRAMEBUFFER_ALIGNMENT,
       start,
-      VIRT_MEMORY_TYPE_DEVICE,
-      VIRT_PAGE_TYPE_AUTO
+      end - start,
+      VIRT_MEMORY_TYPE_NORMAL,
+      VIRT_PAGE_TYPE_NON_EXECUTABLE
     );
-    // increase start and virtual
-    start += PAGE_SIZE;
-    virtual += PAGE_SIZE;
   }
 
   // debug output
@@ -109,23 +117,18 @@ void virt_platform_init( void ) {
     );
   #endif
 
-  // set start and virtual
+  // set start and end
   start = peripheral_base_get( PERIPHERAL_GPIO );
-  virtual = GPIO_PERIPHERAL_BASE;
-
+  end = peripheral_end_get( PERIPHERAL_GPIO );
   // map peripherals
-  while ( start < peripheral_end_get( PERIPHERAL_GPIO ) ) {
-    // map
-    virt_map_address(
+  if ( start < end ) {
+    virt_map_range(
       kernel_context,
-      virtual,
+      GPIO_PERIPHERAL_BASE,
       start,
+      end - start,
       VIRT_MEMORY_TYPE_DEVICE,
       VIRT_PAGE_TYPE_AUTO );
-
-    // increase start and virtual
-    start += PAGE_SIZE;
-    virtual += PAGE_SIZE;
   }
   // handle local peripherals
   #if defined( BCM2836 ) || defined( BCM2837 )
@@ -138,31 +141,28 @@ void virt_platform_init( void ) {
       );
     #endif
 
-    // set start and virtual
+    // set start and end
     start = peripheral_base_get( PERIPHERAL_LOCAL );
-    virtual = CPU_PERIPHERAL_BASE;
+    end = peripheral_end_get( PERIPHERAL_LOCAL );
     // map peripherals
-    while ( start < peripheral_end_get( PERIPHERAL_LOCAL ) ) {
-      // map
-      virt_map_address(
+    if ( start < end ) {
+      virt_map_range(
         kernel_context,
-        virtual,
+        CPU_PERIPHERAL_BASE,
         start,
+        end - start,
         VIRT_MEMORY_TYPE_DEVICE,
         VIRT_PAGE_TYPE_AUTO );
-      // increase start and virtual
-      start += PAGE_SIZE;
-      virtual += PAGE_SIZE;
     }
   #endif
 
-  // map mailbox buffer
+  // map mailbox buffer cacheable like its heap alias, maintained explicitly
   virt_map_address(
     kernel_context,
     MAILBOX_PROPERTY_AREA,
     ( uintptr_t )ptb_buffer_phys,
-    VIRT_MEMORY_TYPE_DEVICE,
-    VIRT_PAGE_TYPE_AUTO
+    VIRT_MEMORY_TYPE_NORMAL,
+    VIRT_PAGE_TYPE_NON_EXECUTABLE
   );
 }
 
@@ -170,8 +170,9 @@ void virt_platform_init( void ) {
  * @brief Platform post initialization routine
  */
 void virt_platform_post_init( void ) {
-  // set framebuffer
-  framebuffer_base_set( FRAMEBUFFER_AREA );
+  // set framebuffer with offset kept during mapping
+  framebuffer_base_set(
+    FRAMEBUFFER_AREA + framebuffer_base_get() % FRAMEBUFFER_ALIGNMENT );
   // set new peripheral base
   peripheral_base_set( GPIO_PERIPHERAL_BASE, PERIPHERAL_GPIO );
   // Adjust base address of cpu peripheral
@@ -182,7 +183,7 @@ void virt_platform_post_init( void ) {
   // debug output
   #if defined( PRINT_MM_VIRT )
     DEBUG_OUTPUT( "Set new framebuffer base to %p\r\n",
-      ( void* )FRAMEBUFFER_AREA );
+      ( void* )framebuffer_base_get() );
     DEBUG_OUTPUT( "Set new gpio peripheral base to %p\r\n",
       ( void* )GPIO_PERIPHERAL_BASE );
     DEBUG_OUTPUT( "Set new cpu peripheral base to %p\r\n",
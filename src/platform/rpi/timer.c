@@ -79,6 +79,46 @@
   #define SYSTEM_TIMER_3_INTERRUPT ( 1 << 3 )
 #endif
 
+#if defined( BCM2836 ) || defined( BCM2837 )
+  // counter increments per tick
+  #define TIMER_TICK_COUNT ARM_GENERIC_TIMER_COUNT
+#else
+  // counter increments per tick
+  #define TIMER_TICK_COUNT ( TIMER_FREQUENZY_HZ / TIMER_INTERRUPT_PER_SECOND )
+  // minimum distance of compare value to counter, as only equality matches
+  #define TIMER_MIN_DELTA 10
+#endif
+
+/**
+ * @brief Currently programmed expiry in microseconds
+ */
+static uint64_t timer_expiry = TIMER_EXPIRY_NONE;
+
+/**
+ * @brief Read free running counter
+ *
+ * @return uint64_t
+ */
+static uint64_t timer_counter( void ) {
+  #if defined( BCM2836 ) || defined( BCM2837 )
+    uint32_t low;
+    uint32_t high;
+    // read cntvct
+    __asm__ __volatile__( "mrrc p15, 1, %0, %1, c14" : "=r"( low ), "=r"( high ) );
+    return ( ( uint64_t )high << 32 ) | low;
+  #else
+    uint32_t base = ( uint32_t )peripheral_base_get( PERIPHERAL_GPIO );
+    uint32_t high;
+    uint32_t low;
+    // read until higher part didn't change while reading lower part
+    do {
+      high = io_in32( base + SYSTEM_TIMER_COUNTER_HIGHER );
+      low = io_in32( base + SYSTEM_TIMER_COUNTER_LOWER );
+    } while ( high != io_in32( base + SYSTEM_TIMER_COUNTER_HIGHER ) );
+    return ( ( uint64_t )high << 32 ) | low;
+  #endif
+}
+
 /**
  * @brief Check for pending timer interrupt
  *
@@ -91,7 +131,8 @@ static bool timer_pending( void ) {
     uintptr_t base = peripheral_base_get( PERIPHERAL_LOCAL );
     return io_in32( ( uint32_t )base + CORE0_IRQ_SOURCE ) & ARM_GENERIC_TIMER_MATCH_VIRT;
   #else
-    return io_in32( SYSTEM_TIMER_CONTROL ) & SYSTEM_TIMER_MATCH_3;
+    uint32_t base = ( uint32_t )peripheral_base_get( PERIPHERAL_GPIO );
+    return io_in32( base + SYSTEM_TIMER_CONTROL ) & SYSTEM_TIMER_MATCH_3;
   #endif
 }
 
@@ -113,19 +154,141 @@ static void timer_clear( void* context ) {
     printf( "timer_clear()\r\n" );
   #endif
 
-  // clear timer
+  // one shot timer, stop until next expiry is set
+  timer_stop();
+  // arm fallback expiry in case scheduling is skipped
+  timer_set_expiry( timer_get_microsecond() + timer_get_interval() );
+
+  // trigger timer event
+  event_enqueue( EVENT_TIMER, EVENT_DETERMINE_ORIGIN( context ) );
+}
+
+/**
+ * @brief Get monotonic amount of timer ticks, also correct while stopped
+ *
+ * @return uint64_t
+ */
+uint64_t timer_get_tick( void ) {
+  return timer_counter() / TIMER_TICK_COUNT;
+}
+
+/**
+ * @brief Get monotonic microseconds of free running counter
+ *
+ * @return uint64_t
+ */
+uint64_t timer_get_microsecond( void ) {
   #if defined( BCM2836 ) || defined( BCM2837 )
-    // reset cntcval
-    __asm__ __volatile__ ( "mcr p15, 0, %0, c14, c3, 0" :: "r"( ARM_GENERIC_TIMER_COUNT ) );
+    return timer_counter() * 10 / ( ARM_GENERIC_TIMER_FREQUENCY / 100000 );
   #else
-    // clear timer match bit
-    io_out32( SYSTEM_TIMER_CONTROL, SYSTEM_TIMER_MATCH_3 );
-    // set compare again
-    io_out32( SYSTEM_TIMER_COMPARE_3, io_in32( SYSTEM_TIMER_COUNTER_LOWER ) + TIMER_FREQUENZY_HZ / TIMER_INTERRUPT_PER_SECOND );
+    return timer_counter() / ( TIMER_FREQUENZY_HZ / 1000000 );
   #endif
+}
 
-  // trigger timer event
-  event_enqueue( EVENT_TIMER, EVENT_DETERMINE_ORIGIN( context ) );
+/**
+ * @brief Convert microseconds into free running counter value
+ *
+ * @param microsecond microseconds to convert
+ * @return uint64_t
+ */
+static uint64_t timer_microsecond_to_counter( uint64_t microsecond ) {
+  #if defined( BCM2836 ) || defined( BCM2837 )
+    return microsecond * ( ARM_GENERIC_TIMER_FREQUENCY / 100000 ) / 10;
+  #else
+    return microsecond * ( TIMER_FREQUENZY_HZ / 1000000 );
+  #endif
+}
+
+/**
+ * @brief Get timer tick interval in microseconds
+ *
+ * @return uint32_t
+ */
+uint32_t timer_get_interval( void ) {
+  #if defined( BCM2836 ) || defined( BCM2837 )
+    return ( uint32_t )(
+      ( uint64_t )ARM_GENERIC_TIMER_COUNT * 1000000 / ARM_GENERIC_TIMER_FREQUENCY );
+  #else
+    return 1000000 / TIMER_INTERRUPT_PER_SECOND;
+  #endif
+}
+
+/**
+ * @brief Program one shot timer expiry
+ *
+ * @param microsecond absolute microsecond to expire, passed values expire immediately
+ */
+void timer_set_expiry( uint64_t microsecond ) {
+  // skip reprogramming of same expiry
+  if ( microsecond == timer_expiry ) {
+    return;
+  }
+
+  // debug output
+  #if defined( PRINT_TIMER )
+    printf( "timer_set_expiry( %llu )\r\n", microsecond );
+  #endif
+
+  // save expiry and calculate counter value
+  timer_expiry = microsecond;
+  uint64_t compare = timer_microsecond_to_counter( microsecond );
+
+  #if defined( BCM2836 ) || defined( BCM2837 )
+    // set cntv_cval, fires immediately when already passed
+    __asm__ __volatile__( "mcrr p15, 3, %0, %1, c14" ::
+      "r"( ( uint32_t )compare ), "r"( ( uint32_t )( compare >> 32 ) ) );
+    // enable timer
+    __asm__ __volatile__( "mcr p15, 0, %0, c14, c3, 1" :: "r"( ARM_GENERIC_TIMER_ENABLE ) );
+  #else
+    uint32_t base = ( uint32_t )peripheral_base_get( PERIPHERAL_GPIO );
+    // compare matches only on equality, so move passed values into future
+    uint64_t now = timer_counter();
+    if ( compare < now + TIMER_MIN_DELTA ) {
+      compare = now + TIMER_MIN_DELTA;
+    }
+    // set compare
+    io_out32( base + SYSTEM_TIMER_COMPARE_3, ( uint32_t )compare );
+    // enable interrupt for timer 3
+    io_out32( base + INTERRUPT_ENABLE_IRQ_1, SYSTEM_TIMER_3_INTERRUPT );
+  #endif
+}
+
+/**
+ * @brief Get programmed expiry in microseconds
+ *
+ * @return uint64_t expiry microsecond or TIMER_EXPIRY_NONE when stopped
+ */
+uint64_t timer_get_expiry( void ) {
+  return timer_expiry;
+}
+
+/**
+ * @brief Stop timer until next expiry is set
+ */
+void timer_stop( void ) {
+  // skip already stopped timer
+  if ( TIMER_EXPIRY_NONE == timer_expiry ) {
+    return;
+  }
+
+  // debug output
+  #if defined( PRINT_TIMER )
+    printf( "timer_stop()\r\n" );
+  #endif
+
+  // reset expiry
+  timer_expiry = TIMER_EXPIRY_NONE;
+
+  #if defined( BCM2836 ) || defined( BCM2837 )
+    // disable timer, which clears interrupt status
+    __asm__ __volatile__( "mcr p15, 0, %0, c14, c3, 1" :: "r"( 0 ) );
+  #else
+    uint32_t base = ( uint32_t )peripheral_base_get( PERIPHERAL_GPIO );
+    // clear timer match bit
+    io_out32( base + SYSTEM_TIMER_CONTROL, SYSTEM_TIMER_MATCH_3 );
+    // disable interrupt for timer 3
+    io_out32( base + INTERRUPT_DISABLE_IRQ_1, SYSTEM_TIMER_3_INTERRUPT );
+  #endif
 }
 
 /**
@@ -145,9 +308,6 @@ void timer_init( void ) {
     // route virtual timer within core
     io_out32( ( uint32_t )base + CORE0_TIMER_IRQCNTL, ARM_GENERIC_TIMER_INTERRUPT_VIRT );
 
-    // set frequency and enable
-    __asm__ __volatile__( "mcr p15, 0, %0, c14, c3, 0" :: "r"( ARM_GENERIC_TIMER_FREQUENCY ) );
-    __asm__ __volatile__( "mcr p15, 0, %0, c14, c3, 1" :: "r"( ARM_GENERIC_TIMER_ENABLE ) );
   #else
     // get peripheral base
     uint32_t base = ( uint32_t )peripheral_base_get( PERIPHERAL_GPIO );
@@ -159,15 +319,9 @@ void timer_init( void ) {
     // reset timer control
     io_out32( base + SYSTEM_TIMER_CONTROL, 0x00000000 );
 
-    // set compare for timer 3
-    io_out32( base + SYSTEM_TIMER_COMPARE_3, io_in32( base + SYSTEM_TIMER_COUNTER_LOWER ) + TIMER_FREQUENZY_HZ / TIMER_INTERRUPT_PER_SECOND );
-
-    // enable timer 3
+    // clear timer 3 match
     io_out32( base + SYSTEM_TIMER_CONTROL, SYSTEM_TIMER_MATCH_3 );
 
-    // enable interrupt for timer 3
-    io_out32( base + INTERRUPT_ENABLE_IRQ_1, SYSTEM_TIMER_3_INTERRUPT );
-
     // get pending interrupt from memory
     uint32_t interrupt_line = io_in32( base + INTERRUPT_IRQ_PENDING_1 );
 
@@ -177,4 +331,7 @@ void timer_init( void ) {
     // overwrite
     io_out32( base + INTERRUPT_IRQ_PENDING_1, interrupt_line );
   #endif
+
+  // program first expiry, scheduler takes over afterwards
+  timer_set_expiry( timer_get_microsecond() + timer_get_interval() );
 }
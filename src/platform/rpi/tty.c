@@ -42,3 +42,19 @@ void tty_putc( __maybe_unused uint8_t c ) {
     framebuffer_putc( c );
   #endif
 }
+
+/**
+ * @brief Print characters to TTY
+ *
+ * @param buffer characters to print
+ * @param length amount of characters
+ */
+void tty_write(
+  __maybe_unused const uint8_t* buffer,
+  __maybe_unused size_t length
+) {
+  // return if disabled
+  #if defined( OUTPUT_ENABLE )
+    framebuffer_write( buffer, length );
+  #endif
+}
@@ -0,0 +1,453 @@
+/**
+ * Copyright (C) 2018 - 2020 bolthur project.
+ *
+ * This file is part of bolthur/kernel.
+ *
+ * bolthur/kernel is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * bolthur/kernel is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with bolthur/kernel.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * Check and benchmark of kernel memcpy, memmove and memset
+ *
+ * The kernel implementations are compiled into this program under different
+ * names, so that they can be compared with byte wise reference loops and the
+ * c library of the host or target. Only standard c is used, so the program
+ * runs on the build host and within user space of the target.
+ *
+ * Usage: benchmark [check|bench], both are executed without argument
+ *
+ * Build for host with "make -C tools/string" and for the target by passing
+ * the cross compiler, e.g. "make -C tools/string CC=arm-unknown-bolthur-eabi-gcc".
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// keywords usually defined by configure
+#if ! defined( __may_alias )
+  #define __may_alias __attribute__((__may_alias__))
+#endif
+#if ! defined( __no_tree_loop_distribute )
+  #define __no_tree_loop_distribute \
+    __attribute__((__optimize__("no-tree-loop-distribute-patterns")))
+#endif
+
+// include kernel implementations with own names, string.h is already included
+#define memcpy kernel_memcpy
+#define memmove kernel_memmove
+#define memset kernel_memset
+#include "../../src/lib/libc/string/memcpy.c"
+#include "../../src/lib/libc/string/memmove.c"
+#include "../../src/lib/libc/string/memset.c"
+#undef memcpy
+#undef memmove
+#undef memset
+
+/**
+ * @brief Guard bytes around each buffer to detect out of range writes
+ */
+#define GUARD_SIZE 16
+
+/**
+ * @brief Guard value
+ */
+#define GUARD_VALUE 0xA5
+
+/**
+ * @brief Largest size used within check
+ */
+#define CHECK_MAX_SIZE 4200
+
+/**
+ * @brief Amount of random check rounds per function
+ */
+#define CHECK_ROUNDS 20000
+
+/**
+ * @brief Amount of bytes processed per benchmark entry
+ */
+#define BENCH_TOTAL ( 64 * 1024 * 1024 )
+
+/**
+ * @brief Sink for results, so that measured work isn't optimized away
+ */
+static volatile uint8_t sink;
+
+typedef void* ( *copy_callback_t )( void*, const void*, size_t );
+typedef void* ( *fill_callback_t )( void*, int, size_t );
+
+/**
+ * @brief Byte wise reference copy
+ *
+ * @param dst destination
+ * @param src source
+ * @param size size to copy
+ * @return void*
+ */
+static void* __no_tree_loop_distribute reference_memcpy(
+  void* dst,
+  const void* src,
+  size_t size
+) {
+  volatile uint8_t* d = ( volatile uint8_t* )dst;
+  const uint8_t* s = ( const uint8_t* )src;
+  // copy byte by byte
+  while ( 0 < size-- ) {
+    *d++ = *s++;
+  }
+  return dst;
+}
+
+/**
+ * @brief Byte wise reference move
+ *
+ * @param dst destination
+ * @param src source
+ * @param size size to move
+ * @return void*
+ */
+static void* __no_tree_loop_distribute reference_memmove(
+  void* dst,
+  const void* src,
+  size_t size
+) {
+  volatile uint8_t* d = ( volatile uint8_t* )dst;
+  const uint8_t* s = ( const uint8_t* )src;
+  // copy backward when destination lies above source
+  if ( d > s ) {
+    while ( 0 < size ) {
+      size--;
+      d[ size ] = s[ size ];
+    }
+  } else {
+    while ( 0 < size-- ) {
+      *d++ = *s++;
+    }
+  }
+  return dst;
+}
+
+/**
+ * @brief Byte wise reference fill
+ *
+ * @param dst destination
+ * @param value value to fill
+ * @param size size to fill
+ * @return void*
+ */
+static void* __no_tree_loop_distribute reference_memset(
+  void* dst,
+  int value,
+  size_t size
+) {
+  volatile uint8_t* d = ( volatile uint8_t* )dst;
+  // fill byte by byte
+  while ( 0 < size-- ) {
+    *d++ = ( uint8_t )value;
+  }
+  return dst;
+}
+
+/**
+ * @brief Helper to fill buffer with pseudo random bytes
+ *
+ * @param buffer buffer to fill
+ * @param size buffer size
+ */
+static void fill_random( uint8_t* buffer, size_t size ) {
+  for ( size_t index = 0; index < size; index++ ) {
+    buffer[ index ] = ( uint8_t )rand();
+  }
+}
+
+/**
+ * @brief Check copy of kernel memcpy and memmove without overlap
+ *
+ * @param name function name for output
+ * @param callback function to check
+ * @return size_t amount of failures
+ */
+static size_t check_copy( const char* name, copy_callback_t callback ) {
+  static uint8_t src[ CHECK_MAX_SIZE + 2 * GUARD_SIZE ];
+  static uint8_t dst[ CHECK_MAX_SIZE + 2 * GUARD_SIZE ];
+  static uint8_t expected[ CHECK_MAX_SIZE + 2 * GUARD_SIZE ];
+  size_t failure = 0;
+
+  for ( size_t round = 0; round < CHECK_ROUNDS; round++ ) {
+    size_t src_offset = ( size_t )rand() % 8;
+    size_t dst_offset = ( size_t )rand() % 8;
+    size_t size = ( size_t )rand() % ( CHECK_MAX_SIZE - 8 );
+    // prepare buffers
+    fill_random( src, sizeof( src ) );
+    fill_random( dst, sizeof( dst ) );
+    reference_memcpy( expected, dst, sizeof( dst ) );
+    // execute reference and kernel implementation
+    reference_memcpy(
+      expected + GUARD_SIZE + dst_offset, src + GUARD_SIZE + src_offset, size );
+    void* result = callback(
+      dst + GUARD_SIZE + dst_offset, src + GUARD_SIZE + src_offset, size );
+    // compare including untouched surrounding
+    if (
+      result != dst + GUARD_SIZE + dst_offset
+      || 0 != memcmp( expected, dst, sizeof( dst ) )
+    ) {
+      printf( "%s failed: size = %zu, src offset = %zu, dst offset = %zu\n",
+        name, size, src_offset, dst_offset );
+      failure++;
+    }
+  }
+
+  // return failures
+  return failure;
+}
+
+/**
+ * @brief Check kernel memmove with overlapping ranges
+ *
+ * @return size_t amount of failures
+ */
+static size_t check_overlap( void ) {
+  static uint8_t buffer[ 2 * CHECK_MAX_SIZE + 2 * GUARD_SIZE ];
+  static uint8_t expected[ 2 * CHECK_MAX_SIZE + 2 * GUARD_SIZE ];
+  size_t failure = 0;
+
+  for ( size_t round = 0; round < CHECK_ROUNDS; round++ ) {
+    size_t size = ( size_t )rand() % CHECK_MAX_SIZE;
+    size_t src_offset = ( size_t )rand() % ( CHECK_MAX_SIZE + 1 );
+    size_t dst_offset = ( size_t )rand() % ( CHECK_MAX_SIZE + 1 );
+    // prepare buffers
+    fill_random( buffer, sizeof( buffer ) );
+    reference_memcpy( expected, buffer, sizeof( buffer ) );
+    // execute reference and kernel implementation
+    reference_memmove( expected + GUARD_SIZE + dst_offset,
+      expected + GUARD_SIZE + src_offset, size );
+    void* result = kernel_memmove( buffer + GUARD_SIZE + dst_offset,
+      buffer + GUARD_SIZE + src_offset, size );
+    // compare whole buffer
+    if (
+      result != buffer + GUARD_SIZE + dst_offset
+      || 0 != memcmp( expected, buffer, sizeof( buffer ) )
+    ) {
+      printf( "memmove overlap failed: size = %zu, src = %zu, dst = %zu\n",
+        size, src_offset, dst_offset );
+      failure++;
+    }
+  }
+
+  // return failures
+  return failure;
+}
+
+/**
+ * @brief Check kernel memset
+ *
+ * @return size_t amount of failures
+ */
+static size_t check_fill( void ) {
+  static uint8_t dst[ CHECK_MAX_SIZE + 2 * GUARD_SIZE ];
+  static uint8_t expected[ CHECK_MAX_SIZE + 2 * GUARD_SIZE ];
+  size_t failure = 0;
+
+  for ( size_t round = 0; round < CHECK_ROUNDS; round++ ) {
+    size_t offset = ( size_t )rand() % 8;
+    size_t size = ( size_t )rand() % ( CHECK_MAX_SIZE - 8 );
+    // values outside of byte range are truncated
+    int value = rand() % 1024 - 512;
+    // prepare buffers
+    reference_memset( dst, GUARD_VALUE, sizeof( dst ) );
+    reference_memset( expected, GUARD_VALUE, sizeof( expected ) );
+    // execute reference and kernel implementation
+    reference_memset( expected + GUARD_SIZE + offset, value, size );
+    void* result = kernel_memset( dst + GUARD_SIZE + offset, value, size );
+    // compare including untouched surrounding
+    if (
+      result != dst + GUARD_SIZE + offset
+      || 0 != memcmp( expected, dst, sizeof( dst ) )
+    ) {
+      printf( "memset failed: size = %zu, offset = %zu, value = %d\n",
+        size, offset, value );
+      failure++;
+    }
+  }
+
+  // return failures
+  return failure;
+}
+
+/**
+ * @brief Helper to get elapsed seconds since start
+ *
+ * @param start start clock
+ * @return double
+ */
+static double elapsed( clock_t start ) {
+  return ( double )( clock() - start ) / CLOCKS_PER_SEC;
+}
+
+/**
+ * @brief Helper to print throughput
+ *
+ * @param seconds measured seconds
+ */
+static void print_throughput( double seconds ) {
+  if ( 0 < seconds ) {
+    printf( " %10.1f", ( double )BENCH_TOTAL / seconds / ( 1024 * 1024 ) );
+  } else {
+    printf( " %10s", "-" );
+  }
+}
+
+/**
+ * @brief Benchmark copy functions
+ *
+ * @param title title for output
+ * @param callback functions to measure
+ * @param count amount of functions
+ * @param src source buffer
+ * @param dst destination buffer
+ */
+static void bench_copy(
+  const char* title,
+  const copy_callback_t* callback,
+  size_t count,
+  uint8_t* src,
+  uint8_t* dst
+) {
+  static const size_t size[] = { 16, 64, 256, 1024, 4096, 65536 };
+  static const size_t offset[][ 2 ] = { { 0, 0 }, { 1, 1 }, { 0, 3 } };
+
+  printf( "\n%s MiB/s\n%8s %7s %10s %10s %10s\n",
+    title, "size", "offset", "kernel", "byte", "libc" );
+  for ( size_t s = 0; s < sizeof( size ) / sizeof( size[ 0 ] ); s++ ) {
+    for ( size_t o = 0; o < sizeof( offset ) / sizeof( offset[ 0 ] ); o++ ) {
+      size_t rounds = BENCH_TOTAL / size[ s ];
+      printf( "%8zu %3zu/%-3zu", size[ s ], offset[ o ][ 0 ], offset[ o ][ 1 ] );
+      for ( size_t c = 0; c < count; c++ ) {
+        clock_t start = clock();
+        for ( size_t round = 0; round < rounds; round++ ) {
+          callback[ c ]( dst + offset[ o ][ 1 ], src + offset[ o ][ 0 ], size[ s ] );
+          sink = dst[ offset[ o ][ 1 ] ];
+        }
+        print_throughput( elapsed( start ) );
+      }
+      printf( "\n" );
+    }
+  }
+}
+
+/**
+ * @brief Benchmark fill functions
+ *
+ * @param callback functions to measure
+ * @param count amount of functions
+ * @param dst destination buffer
+ */
+static void bench_fill(
+  const fill_callback_t* callback,
+  size_t count,
+  uint8_t* dst
+) {
+  static const size_t size[] = { 16, 64, 256, 1024, 4096, 65536 };
+  static const size_t offset[] = { 0, 1 };
+
+  printf( "\nmemset MiB/s\n%8s %7s %10s %10s %10s\n",
+    "size", "offset", "kernel", "byte", "libc" );
+  for ( size_t s = 0; s < sizeof( size ) / sizeof( size[ 0 ] ); s++ ) {
+    for ( size_t o = 0; o < sizeof( offset ) / sizeof( offset[ 0 ] ); o++ ) {
+      size_t rounds = BENCH_TOTAL / size[ s ];
+      printf( "%8zu %7zu", size[ s ], offset[ o ] );
+      for ( size_t c = 0; c < count; c++ ) {
+        clock_t start = clock();
+        for ( size_t round = 0; round < rounds; round++ ) {
+          callback[ c ]( dst + offset[ o ], ( int )round, size[ s ] );
+          sink = dst[ offset[ o ] ];
+        }
+        print_throughput( elapsed( start ) );
+      }
+      printf( "\n" );
+    }
+  }
+}
+
+/**
+ * @brief Run checks
+ *
+ * @return size_t amount of failures
+ */
+static size_t run_check( void ) {
+  size_t failure = 0;
+
+  failure += check_copy( "memcpy", kernel_memcpy );
+  failure += check_copy( "memmove", kernel_memmove );
+  failure += check_overlap();
+  failure += check_fill();
+
+  printf( "check: %zu failures within %d rounds per case\n",
+    failure, CHECK_ROUNDS );
+  return failure;
+}
+
+/**
+ * @brief Run benchmark
+ *
+ * @return int
+ */
+static int run_bench( void ) {
+  static const copy_callback_t copy[] = {
+    kernel_memcpy, reference_memcpy, memcpy };
+  static const copy_callback_t move[] = {
+    kernel_memmove, reference_memmove, memmove };
+  static const fill_callback_t fill[] = {
+    kernel_memset, reference_memset, memset };
+  // buffers with room for offsets, allocated to be word aligned
+  uint8_t* src = ( uint8_t* )malloc( 65536 + 64 );
+  uint8_t* dst = ( uint8_t* )malloc( 65536 + 64 );
+  if ( NULL == src || NULL == dst ) {
+    printf( "allocation failed\n" );
+    free( src );
+    free( dst );
+    return EXIT_FAILURE;
+  }
+  fill_random( src, 65536 + 64 );
+  fill_random( dst, 65536 + 64 );
+
+  bench_copy( "memcpy", copy, 3, src, dst );
+  bench_copy( "memmove", move, 3, src, dst );
+  bench_fill( fill, 3, dst );
+
+  free( src );
+  free( dst );
+  return EXIT_SUCCESS;
+}
+
+int main( int argc, char* argv[] ) {
+  bool check = 1 >= argc || 0 == strcmp( argv[ 1 ], "check" );
+  bool bench = 1 >= argc || 0 == strcmp( argv[ 1 ], "bench" );
+
+  // fixed seed for reproducible results
+  srand( 1 );
+  // run checks first, benchmark results of broken functions are worthless
+  if ( check && 0 != run_check() ) {
+    return EXIT_FAILURE;
+  }
+  if ( bench ) {
+    return run_bench();
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,191 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "syscall.h"
+#include "buffer.h"
+
+/**
+ * @brief Line buffered standard output
+ */
+buffer_t buffer_stdout = { SYSCALL_FD_STDOUT, true, 0, { 0 } };
+
+/**
+ * @brief Standard error, flushed at the end of every call
+ */
+buffer_t buffer_stderr = { SYSCALL_FD_STDERR, false, 0, { 0 } };
+
+/**
+ * @brief Helper to register flush at exit once
+ */
+static void buffer_register_exit( void ) {
+  static bool registered = false;
+  // skip if already done
+  if ( registered ) {
+    return;
+  }
+  // flush everything pending at exit
+  atexit( buffer_flush_all );
+  registered = true;
+}
+
+/**
+ * @brief Write pending data with one syscall
+ *
+ * @param buffer buffer to flush
+ * @return int 0 on success, -1 on error
+ */
+int buffer_flush( buffer_ptr_t buffer ) {
+  size_t offset = 0;
+  // write until everything has been taken
+  while ( offset < buffer->length ) {
+    ssize_t written = syscall_write(
+      buffer->fd, buffer->data + offset, buffer->length - offset );
+    // handle error, pending data is dropped
+    if ( 0 >= written ) {
+      buffer->length = 0;
+      return -1;
+    }
+    offset += ( size_t )written;
+  }
+  // reset buffer
+  buffer->length = 0;
+  return 0;
+}
+
+/**
+ * @brief Flush standard output and error
+ */
+void buffer_flush_all( void ) {
+  buffer_flush( &buffer_stdout );
+  buffer_flush( &buffer_stderr );
+}
+
+/**
+ * @brief Append data to buffer
+ *
+ * Full buffers are flushed, line buffered ones additionally after a newline
+ * and unbuffered ones after the call. Data exceeding the buffer is passed
+ * through directly.
+ *
+ * @param buffer buffer to write to
+ * @param data data to append
+ * @param length data length
+ * @return int written length or -1 on error
+ */
+int buffer_write( buffer_ptr_t buffer, const void* data, size_t length ) {
+  const char* src = ( const char* )data;
+  buffer_register_exit();
+
+  // large writes go out directly after pending data
+  if ( BUFFER_SIZE <= length ) {
+    if ( 0 != buffer_flush( buffer ) ) {
+      return -1;
+    }
+    for ( size_t offset = 0; offset < length; ) {
+      ssize_t written = syscall_write(
+        buffer->fd, src + offset, length - offset );
+      if ( 0 >= written ) {
+        return -1;
+      }
+      offset += ( size_t )written;
+    }
+    return ( int )length;
+  }
+
+  // flush when not fitting
+  if (
+    BUFFER_SIZE - buffer->length < length
+    && 0 != buffer_flush( buffer )
+  ) {
+    return -1;
+  }
+  // append
+  memcpy( buffer->data + buffer->length, src, length );
+  buffer->length += length;
+
+  // flush unbuffered or line buffered with newline
+  if (
+    ( ! buffer->line || NULL != memchr( src, '\n', length ) )
+    && 0 != buffer_flush( buffer )
+  ) {
+    return -1;
+  }
+  // return written length
+  return ( int )length;
+}
+
+/**
+ * @brief Append single character to buffer
+ *
+ * @param buffer buffer to write to
+ * @param c character
+ * @return int written character or -1 on error
+ */
+int buffer_putc( buffer_ptr_t buffer, char c ) {
+  return 1 == buffer_write( buffer, &c, 1 ) ? ( unsigned char )c : -1;
+}
+
+/**
+ * @brief Append string to buffer
+ *
+ * @param buffer buffer to write to
+ * @param s string
+ * @return int written length or -1 on error
+ */
+int buffer_puts( buffer_ptr_t buffer, const char* s ) {
+  return buffer_write( buffer, s, strlen( s ) );
+}
+
+/**
+ * @brief Format into buffer
+ *
+ * @param buffer buffer to write to
+ * @param format format string
+ * @param parameter format arguments
+ * @return int written length or -1 on error
+ */
+int buffer_vprintf(
+  buffer_ptr_t buffer,
+  const char* format,
+  va_list parameter
+) {
+  char tmp[ BUFFER_SIZE ];
+  va_list copy;
+  // format into temporary buffer
+  va_copy( copy, parameter );
+  int length = vsnprintf( tmp, sizeof( tmp ), format, copy );
+  va_end( copy );
+  if ( 0 > length ) {
+    return -1;
+  }
+  // short output is appended directly
+  if ( ( size_t )length < sizeof( tmp ) ) {
+    return buffer_write( buffer, tmp, ( size_t )length );
+  }
+
+  // format overlong output into allocated memory
+  char* large = ( char* )malloc( ( size_t )length + 1 );
+  if ( NULL == large ) {
+    return -1;
+  }
+  vsnprintf( large, ( size_t )length + 1, format, parameter );
+  int result = buffer_write( buffer, large, ( size_t )length );
+  free( large );
+  return result;
+}
+
+/**
+ * @brief Format into buffer
+ *
+ * @param buffer buffer to write to
+ * @param format format string
+ * @return int written length or -1 on error
+ */
+int buffer_printf( buffer_ptr_t buffer, const char* format, ... ) {
+  va_list parameter;
+  va_start( parameter, format );
+  int length = buffer_vprintf( buffer, format, parameter );
+  va_end( parameter );
+  return length;
+}
@@ -0,0 +1,29 @@
+
+#if ! defined( __USER_LIB_BUFFER__ )
+#define __USER_LIB_BUFFER__
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define BUFFER_SIZE 512
+
+typedef struct {
+  int fd;
+  bool line;
+  size_t length;
+  char data[ BUFFER_SIZE ];
+} buffer_t, *buffer_ptr_t;
+
+extern buffer_t buffer_stdout;
+extern buffer_t buffer_stderr;
+
+int buffer_flush( buffer_ptr_t );
+void buffer_flush_all( void );
+int buffer_write( buffer_ptr_t, const void*, size_t );
+int buffer_putc( buffer_ptr_t, char );
+int buffer_puts( buffer_ptr_t, const char* );
+int buffer_vprintf( buffer_ptr_t, const char*, va_list );
+int buffer_printf( buffer_ptr_t, const char*, ... );
+
+#endif
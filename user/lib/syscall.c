@@ -0,0 +1,32 @@
+
+#include <stdint.h>
+#include "syscall.h"
+
+/**
+ * @brief Write buffer to descriptor with one syscall
+ *
+ * Syscall number is passed in r7, arguments in r0 - r2 and the result is
+ * returned in r0.
+ *
+ * @param fd descriptor
+ * @param buffer data to write
+ * @param length data length
+ * @return ssize_t written length or -1 on error
+ */
+ssize_t syscall_write( int fd, const void* buffer, size_t length ) {
+  register uint32_t r0 __asm__( "r0" ) = ( uint32_t )fd;
+  register uint32_t r1 __asm__( "r1" ) = ( uint32_t )buffer;
+  register uint32_t r2 __asm__( "r2" ) = ( uint32_t )length;
+  register uint32_t r7 __asm__( "r7" ) = SYSCALL_WRITE;
+
+  // trap into kernel
+  __asm__ __volatile__(
+    "svc #0"
+    : "+r"( r0 )
+    : "r"( r1 ), "r"( r2 ), "r"( r7 )
+    : "memory"
+  );
+
+  // return result
+  return ( ssize_t )( int32_t )r0;
+}
@@ -0,0 +1,15 @@
+
+#if ! defined( __USER_LIB_SYSCALL__ )
+#define __USER_LIB_SYSCALL__
+
+#include <stddef.h>
+#include <sys/types.h>
+
+// syscall numbers and descriptors, same as include/core/syscall.h of kernel
+#define SYSCALL_WRITE 13
+#define SYSCALL_FD_STDOUT 1
+#define SYSCALL_FD_STDERR 2
+
+ssize_t syscall_write( int, const void*, size_t );
+
+#endif
@@ -1,15 +1,16 @@
 
 #include <stdio.h>
 #include <unistd.h>
+#include "buffer.h"
 
 int i = 0;
 
 int main( int argc, char *argv[] ) {
-  printf( "Hello World!\r\n" );
+  buffer_puts( &buffer_stdout, "Hello World!\r\n" );
 
   for ( int j = i + 5; i < j; i++ ) {
     char c = ( char )( ( int )'0' + i );
-    printf( "%c", c );
+    buffer_putc( &buffer_stdout, c );
   }
 
   void *b = sbrk( 0 );